@@ -38,6 +38,7 @@ let syncExcludes: [String] = [
 ]
 
 let notSyncServerSources: [String] = [
+    "realm/aggregate_view.cpp",
     "realm/alloc.cpp",
     "realm/alloc_slab.cpp",
     "realm/array.cpp",
@@ -0,0 +1,262 @@
+/*************************************************************************
+ *
+ * Copyright 2022 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/aggregate_view.hpp>
+#include <realm/impl/destroy_guard.hpp>
+#include <realm/table.hpp>
+
+namespace realm {
+
+namespace {
+
+// Sums of float columns are accumulated as double, like Table::sum_float()
+Mixed to_sum_type(Mixed value)
+{
+    if (value.is_type(type_Float))
+        return Mixed(double(value.get_float()));
+    return value;
+}
+
+} // anonymous namespace
+
+AggregateView::AggregateView(const Table& table, Array& parent, size_t ndx_in_parent)
+    : m_table(table)
+    , m_top(parent.get_alloc())
+    , m_groups(parent.get_alloc())
+    , m_counts(parent.get_alloc())
+    , m_value_counts(parent.get_alloc())
+    , m_values(parent.get_alloc())
+{
+    m_top.set_parent(&parent, ndx_in_parent);
+    m_top.init_from_parent();
+    m_group_col = ColKey(m_top.get_as_ref_or_tagged(s_group_col_ndx).get_as_int());
+    auto rot_value_col = m_top.get_as_ref_or_tagged(s_value_col_ndx);
+    m_value_col = rot_value_col.is_tagged() ? ColKey(rot_value_col.get_as_int()) : ColKey();
+    m_action = Action(m_top.get_as_ref_or_tagged(s_action_ndx).get_as_int());
+}
+
+ref_type AggregateView::create(Allocator& alloc, ColKey group_col, Action action, ColKey value_col)
+{
+    Array top(alloc);
+    _impl::DeepArrayDestroyGuard dg(&top);
+    top.create(Array::type_HasRefs); // Throws
+    top.add(RefOrTagged::make_tagged(group_col.value));
+    top.add(value_col ? RefOrTagged::make_tagged(value_col.value) : RefOrTagged::make_ref(0));
+    top.add(RefOrTagged::make_tagged(action));
+    while (top.size() < s_num_slots)
+        top.add(0);
+
+    BPlusTree<Mixed> groups(alloc);
+    groups.set_parent(&top, s_groups_ndx);
+    groups.create(); // Throws
+    BPlusTree<Int> counts(alloc);
+    counts.set_parent(&top, s_counts_ndx);
+    counts.create(); // Throws
+    BPlusTree<Int> value_counts(alloc);
+    value_counts.set_parent(&top, s_value_counts_ndx);
+    value_counts.create(); // Throws
+    BPlusTree<Mixed> values(alloc);
+    values.set_parent(&top, s_values_ndx);
+    values.create(); // Throws
+
+    dg.release();
+    return top.get_ref();
+}
+
+void AggregateView::init_trees() const
+{
+    if (!m_trees_attached) {
+        auto top = const_cast<Array*>(&m_top);
+        m_groups.set_parent(top, s_groups_ndx);
+        m_groups.init_from_parent();
+        m_counts.set_parent(top, s_counts_ndx);
+        m_counts.init_from_parent();
+        m_value_counts.set_parent(top, s_value_counts_ndx);
+        m_value_counts.init_from_parent();
+        m_values.set_parent(top, s_values_ndx);
+        m_values.init_from_parent();
+        m_trees_attached = true;
+    }
+}
+
+size_t AggregateView::lower_bound(Mixed group) const
+{
+    size_t lo = 0;
+    size_t hi = m_groups.size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (m_groups.get(mid).compare(group) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+Mixed AggregateView::initial_value() const
+{
+    if (m_action != act_Sum && m_action != act_Average)
+        return {};
+    switch (m_value_col.get_type()) {
+        case col_type_Int:
+            return Mixed(int64_t(0));
+        case col_type_Decimal:
+            return Mixed(Decimal128(0));
+        default:
+            return Mixed(0.0);
+    }
+}
+
+Mixed AggregateView::compute_extreme(ObjKey excluded_key, Mixed group) const
+{
+    Mixed extreme;
+    auto visit = [&](const Obj& obj) {
+        Mixed value = obj.get_any(m_value_col);
+        if (obj.get_key() == excluded_key || value.is_null())
+            return;
+        if (extreme.is_null() || (m_action == act_Min ? value < extreme : value > extreme))
+            extreme = value;
+    };
+    if (StringIndex* index = m_table.get_search_index(m_group_col)) {
+        std::vector<ObjKey> keys;
+        index->find_all(keys, group);
+        for (auto key : keys)
+            visit(m_table.get_object(key));
+    }
+    else {
+        for (auto obj : m_table) {
+            if (obj.get_any(m_group_col) == group)
+                visit(obj);
+        }
+    }
+    return extreme;
+}
+
+void AggregateView::insert(Mixed group, Mixed value)
+{
+    init_trees();
+    size_t ndx = lower_bound(group);
+    if (ndx == m_groups.size() || m_groups.get(ndx) != group) {
+        m_groups.insert(ndx, group);
+        m_counts.insert(ndx, 0);
+        m_value_counts.insert(ndx, 0);
+        m_values.insert(ndx, initial_value());
+    }
+    m_counts.set(ndx, m_counts.get(ndx) + 1);
+    if (m_action == act_Count || value.is_null())
+        return;
+
+    m_value_counts.set(ndx, m_value_counts.get(ndx) + 1);
+    Mixed current = m_values.get(ndx);
+    switch (m_action) {
+        case act_Sum:
+        case act_Average:
+            m_values.set(ndx, current + to_sum_type(value));
+            break;
+        case act_Min:
+            if (current.is_null() || value < current)
+                m_values.set(ndx, value);
+            break;
+        case act_Max:
+            if (current.is_null() || value > current)
+                m_values.set(ndx, value);
+            break;
+        default:
+            REALM_UNREACHABLE();
+    }
+}
+
+void AggregateView::erase(ObjKey key, Mixed group, Mixed value)
+{
+    init_trees();
+    size_t ndx = lower_bound(group);
+    REALM_ASSERT(ndx < m_groups.size() && m_groups.get(ndx) == group);
+    int64_t count = m_counts.get(ndx) - 1;
+    if (count == 0) {
+        m_groups.erase(ndx);
+        m_counts.erase(ndx);
+        m_value_counts.erase(ndx);
+        m_values.erase(ndx);
+        return;
+    }
+    m_counts.set(ndx, count);
+    if (m_action == act_Count || value.is_null())
+        return;
+
+    int64_t value_count = m_value_counts.get(ndx) - 1;
+    m_value_counts.set(ndx, value_count);
+    if (value_count == 0) {
+        // Do not carry rounding errors over to the next values of the group
+        m_values.set(ndx, initial_value());
+        return;
+    }
+    switch (m_action) {
+        case act_Sum:
+        case act_Average:
+            m_values.set(ndx, m_values.get(ndx) - to_sum_type(value));
+            break;
+        case act_Min:
+        case act_Max:
+            if (m_values.get(ndx) == value)
+                m_values.set(ndx, compute_extreme(key, group));
+            break;
+        default:
+            REALM_UNREACHABLE();
+    }
+}
+
+void AggregateView::clear()
+{
+    init_trees();
+    m_groups.clear();
+    m_counts.clear();
+    m_value_counts.clear();
+    m_values.clear();
+}
+
+std::vector<std::pair<Mixed, Mixed>> AggregateView::get_result() const
+{
+    init_trees();
+    std::vector<std::pair<Mixed, Mixed>> result;
+    size_t sz = m_groups.size();
+    result.reserve(sz);
+    for (size_t ndx = 0; ndx < sz; ++ndx) {
+        Mixed aggregate;
+        switch (m_action) {
+            case act_Count:
+                aggregate = Mixed(m_counts.get(ndx));
+                break;
+            case act_Average:
+                if (int64_t value_count = m_value_counts.get(ndx)) {
+                    Mixed sum = m_values.get(ndx);
+                    if (sum.is_type(type_Decimal))
+                        aggregate = Mixed(sum.get<Decimal128>() / Decimal128(value_count));
+                    else
+                        aggregate = Mixed(sum.export_to_type<double>() / value_count);
+                }
+                break;
+            default:
+                aggregate = m_values.get(ndx);
+                break;
+        }
+        result.emplace_back(m_groups.get(ndx), aggregate);
+    }
+    return result;
+}
+
+} // namespace realm
@@ -0,0 +1,115 @@
+/*************************************************************************
+ *
+ * Copyright 2022 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_AGGREGATE_VIEW_HPP
+#define REALM_AGGREGATE_VIEW_HPP
+
+#include <realm/array.hpp>
+#include <realm/array_mixed.hpp>
+#include <realm/bplustree.hpp>
+#include <realm/keys.hpp>
+#include <realm/mixed.hpp>
+#include <realm/query_state.hpp>
+
+#include <utility>
+#include <vector>
+
+namespace realm {
+
+class Table;
+
+/// Accessor for a materialized aggregate stored with a table. The view groups
+/// the objects of the table by the value of one column and keeps, for each
+/// group, the number of objects and the aggregate of another column. The
+/// groups are kept sorted by value. Table calls insert() and erase() as
+/// objects are created, modified and removed, so reading the view only visits
+/// the groups.
+///
+/// The view is stored as an array with the definition followed by one
+/// B+tree per piece of group state:
+///
+///     [ group col | value col | action | groups | counts | value counts | values ]
+///
+/// where `values` holds the running sum for act_Sum and act_Average, and the
+/// current extreme for act_Min and act_Max.
+class AggregateView {
+public:
+    AggregateView(const Table& table, Array& parent, size_t ndx_in_parent);
+
+    static ref_type create(Allocator& alloc, ColKey group_col, Action action, ColKey value_col);
+
+    ColKey get_group_column() const noexcept
+    {
+        return m_group_col;
+    }
+    ColKey get_value_column() const noexcept
+    {
+        return m_value_col;
+    }
+    Action get_action() const noexcept
+    {
+        return m_action;
+    }
+    bool depends_on(ColKey col_key) const noexcept
+    {
+        return col_key == m_group_col || (m_value_col && col_key == m_value_col);
+    }
+
+    /// Add the contribution of an object to its group.
+    void insert(Mixed group, Mixed value);
+    /// Remove the contribution of the object `key` from its group. If the
+    /// object held the minimum or maximum of the group, the group is
+    /// recomputed without it.
+    void erase(ObjKey key, Mixed group, Mixed value);
+    void clear();
+
+    /// The groups in ascending order, each with its aggregate.
+    std::vector<std::pair<Mixed, Mixed>> get_result() const;
+
+private:
+    enum {
+        s_group_col_ndx,
+        s_value_col_ndx,
+        s_action_ndx,
+        s_groups_ndx,
+        s_counts_ndx,
+        s_value_counts_ndx,
+        s_values_ndx,
+        s_num_slots
+    };
+
+    const Table& m_table;
+    Array m_top;
+    ColKey m_group_col;
+    ColKey m_value_col;
+    Action m_action;
+    mutable BPlusTree<Mixed> m_groups;
+    mutable BPlusTree<Int> m_counts;
+    mutable BPlusTree<Int> m_value_counts;
+    mutable BPlusTree<Mixed> m_values;
+    mutable bool m_trees_attached = false;
+
+    void init_trees() const;
+    size_t lower_bound(Mixed group) const;
+    Mixed initial_value() const;
+    Mixed compute_extreme(ObjKey excluded_key, Mixed group) const;
+};
+
+} // namespace realm
+
+#endif // REALM_AGGREGATE_VIEW_HPP
@@ -279,6 +279,27 @@ inline void Cluster::do_insert_row(size_t ndx, ColKey col, Mixed init_val, bool
     }
 }
 
+template <class T>
+inline void Cluster::do_insert_rows(size_t ndx, ColKey col, const std::vector<Mixed>* init_vals, size_t begin,
+                                    size_t num_rows, bool nullable)
+{
+    using U = typename util::RemoveOptional<typename T::value_type>::type;
+
+    T arr(m_alloc);
+    auto col_ndx = col.get_index();
+    arr.set_parent(this, col_ndx.val + s_first_col_index);
+    set_spec<T>(arr, col_ndx);
+    arr.init_from_parent();
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (!init_vals || (*init_vals)[begin + i].is_null()) {
+            arr.insert(ndx + i, T::default_value(nullable));
+        }
+        else {
+            arr.insert(ndx + i, (*init_vals)[begin + i].get<U>());
+        }
+    }
+}
+
 inline void Cluster::do_insert_key(size_t ndx, ColKey col_key, Mixed init_val, ObjKey origin_key)
 {
     ObjKey target_key = init_val.is_null() ? ObjKey{} : init_val.get<ObjKey>();
@@ -439,6 +460,127 @@ void Cluster::insert_row(size_t ndx, ObjKey k, const FieldValues& init_values)
     m_tree_top.for_each_and_every_column(insert_in_column);
 }
 
+void Cluster::append_rows(const BulkValues& values, size_t begin, size_t num_rows, int64_t key_adj)
+{
+    // Ensure the cluster array is big enough to hold 64 bit values.
+    copy_on_write(m_size * 8);
+
+    size_t ndx = node_size();
+    REALM_ASSERT_DEBUG(ndx + num_rows <= cluster_node_size);
+    auto key_value = [&](size_t i) {
+        return values.keys[begin + i].value - key_adj;
+    };
+    if (!m_keys.is_attached()) {
+        // The compact form can only be kept if the keys continue the sequence
+        // of those already present
+        bool consecutive = true;
+        for (size_t i = 0; consecutive && i < num_rows; ++i)
+            consecutive = (key_value(i) == int64_t(ndx + i));
+        if (consecutive) {
+            // Increments size by num_rows
+            Array::set(s_key_ref_or_size_index, Array::get(s_key_ref_or_size_index) + 2 * int64_t(num_rows));
+        }
+        else {
+            ensure_general_form();
+        }
+    }
+    if (m_keys.is_attached()) {
+        for (size_t i = 0; i < num_rows; ++i)
+            m_keys.insert(ndx + i, key_value(i));
+    }
+
+    auto column = values.columns.begin();
+    auto insert_in_column = [&](ColKey col_key) {
+        auto col_ndx = col_key.get_index();
+        auto attr = col_key.get_attrs();
+        const std::vector<Mixed>* init_vals = nullptr;
+        // values.columns must be sorted in col_ndx order
+        if (column != values.columns.end() && column->first.get_index().val == col_ndx.val) {
+            init_vals = column->second;
+            ++column;
+        }
+        auto init_value = [&](size_t i) {
+            return init_vals ? (*init_vals)[begin + i] : Mixed{};
+        };
+
+        auto type = col_key.get_type();
+        if (attr.test(col_attr_Collection)) {
+            REALM_ASSERT(!init_vals);
+            ArrayRef arr(m_alloc);
+            arr.set_parent(this, col_ndx.val + s_first_col_index);
+            arr.init_from_parent();
+            for (size_t i = 0; i < num_rows; ++i)
+                arr.insert(ndx + i, 0);
+            return false;
+        }
+
+        bool nullable = attr.test(col_attr_Nullable);
+        switch (type) {
+            case col_type_Int:
+                if (nullable) {
+                    do_insert_rows<ArrayIntNull>(ndx, col_key, init_vals, begin, num_rows, nullable);
+                }
+                else {
+                    do_insert_rows<ArrayInteger>(ndx, col_key, init_vals, begin, num_rows, nullable);
+                }
+                break;
+            case col_type_Bool:
+                do_insert_rows<ArrayBoolNull>(ndx, col_key, init_vals, begin, num_rows, nullable);
+                break;
+            case col_type_Float:
+                do_insert_rows<ArrayFloatNull>(ndx, col_key, init_vals, begin, num_rows, nullable);
+                break;
+            case col_type_Double:
+                do_insert_rows<ArrayDoubleNull>(ndx, col_key, init_vals, begin, num_rows, nullable);
+                break;
+            case col_type_String:
+                do_insert_rows<ArrayString>(ndx, col_key, init_vals, begin, num_rows, nullable);
+                break;
+            case col_type_Binary:
+                do_insert_rows<ArrayBinary>(ndx, col_key, init_vals, begin, num_rows, nullable);
+                break;
+            case col_type_Timestamp:
+                do_insert_rows<ArrayTimestamp>(ndx, col_key, init_vals, begin, num_rows, nullable);
+                break;
+            case col_type_Decimal:
+                do_insert_rows<ArrayDecimal128>(ndx, col_key, init_vals, begin, num_rows, nullable);
+                break;
+            case col_type_ObjectId:
+                do_insert_rows<ArrayObjectIdNull>(ndx, col_key, init_vals, begin, num_rows, nullable);
+                break;
+            case col_type_UUID:
+                do_insert_rows<ArrayUUIDNull>(ndx, col_key, init_vals, begin, num_rows, nullable);
+                break;
+            // Links need a backlink in the target object for every row
+            case col_type_Mixed:
+                for (size_t i = 0; i < num_rows; ++i)
+                    do_insert_mixed(ndx + i, col_key, init_value(i), values.keys[begin + i]);
+                break;
+            case col_type_Link:
+                for (size_t i = 0; i < num_rows; ++i)
+                    do_insert_key(ndx + i, col_key, init_value(i), values.keys[begin + i]);
+                break;
+            case col_type_TypedLink:
+                for (size_t i = 0; i < num_rows; ++i)
+                    do_insert_link(ndx + i, col_key, init_value(i), values.keys[begin + i]);
+                break;
+            case col_type_BackLink: {
+                ArrayBacklink arr(m_alloc);
+                arr.set_parent(this, col_ndx.val + s_first_col_index);
+                arr.init_from_parent();
+                for (size_t i = 0; i < num_rows; ++i)
+                    arr.insert(ndx + i, 0);
+                break;
+            }
+            default:
+                REALM_ASSERT(false);
+                break;
+        }
+        return false;
+    };
+    m_tree_top.for_each_and_every_column(insert_in_column);
+}
+
 template <class T>
 inline void Cluster::do_move(size_t ndx, ColKey col_key, Cluster* to)
 {
@@ -730,6 +872,33 @@ ref_type Cluster::insert(ObjKey k, const FieldValues& init_values, ClusterNode::
     return ret;
 }
 
+ref_type Cluster::insert_rows(const BulkValues& values, size_t begin, int64_t key_adj, size_t& num_inserted,
+                              ClusterNode::State& state)
+{
+    size_t sz = node_size();
+    size_t num_rows = values.keys.size() - begin;
+
+    REALM_ASSERT_DEBUG(sz <= cluster_node_size);
+    if (REALM_LIKELY(sz < cluster_node_size)) {
+        num_inserted = std::min(num_rows, cluster_node_size - sz);
+        append_rows(values, begin, num_inserted, key_adj); // Throws
+        state.mem = get_mem();
+        state.index = sz;
+        return 0;
+    }
+
+    // Leaf is full - start a new one
+    int64_t first_key_value = values.keys[begin].value - key_adj;
+    Cluster new_leaf(0, m_alloc, m_tree_top);
+    new_leaf.create();
+    num_inserted = std::min(num_rows, size_t(cluster_node_size));
+    new_leaf.append_rows(values, begin, num_inserted, key_adj + first_key_value); // Throws
+    state.split_key = first_key_value;
+    state.mem = new_leaf.get_mem();
+    state.index = 0;
+    return new_leaf.get_ref();
+}
+
 bool Cluster::try_get(ObjKey k, ClusterNode::State& state) const noexcept
 {
     state.mem = get_mem();
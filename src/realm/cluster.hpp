@@ -67,6 +67,16 @@ private:
     std::vector<FieldValue> m_values;
 };
 
+// Initial values of a number of new objects, given column by column. Used when
+// objects are created in bulk (Table::bulk_insert()).
+struct BulkValues {
+    // Keys of the new objects
+    std::vector<ObjKey> keys;
+    // For each column for which values are given, one value per object. Must
+    // be sorted by column index. Columns not mentioned get default values.
+    std::vector<std::pair<ColKey, const std::vector<Mixed>*>> columns;
+};
+
 class ClusterNode : public Array {
 public:
     // This structure is used to bring information back to the upper nodes when
@@ -152,6 +162,14 @@ public:
     /// Create a new object identified by 'key' and update 'state' accordingly
     /// Return reference to new node created (if any)
     virtual ref_type insert(ObjKey k, const FieldValues& init_values, State& state) = 0;
+    /// Create the objects identified by `values.keys[begin]` and onwards,
+    /// whose keys are increasing and greater than any key in this subtree.
+    /// Key values are made relative to this node by subtracting `key_adj`.
+    /// Only as many objects as fit in the last leaf (or in a new one, if the
+    /// last is full) are created, and their number is returned in
+    /// `num_inserted`. Return reference to new node created (if any)
+    virtual ref_type insert_rows(const BulkValues& values, size_t begin, int64_t key_adj, size_t& num_inserted,
+                                 State& state) = 0;
     /// Locate object identified by 'key' and update 'state' accordingly
     void get(ObjKey key, State& state) const;
     /// Locate object identified by 'key' and update 'state' accordingly
@@ -283,6 +301,8 @@ public:
         return size() - s_first_col_index;
     }
     ref_type insert(ObjKey k, const FieldValues& init_values, State& state) override;
+    ref_type insert_rows(const BulkValues& values, size_t begin, int64_t key_adj, size_t& num_inserted,
+                         State& state) override;
     bool try_get(ObjKey k, State& state) const noexcept override;
     ObjKey get(size_t, State& state) const override;
     size_t get_ndx(ObjKey key, size_t ndx) const noexcept override;
@@ -308,6 +328,7 @@ private:
         return size_t(Array::get(s_key_ref_or_size_index)) >> 1; // Size is stored as tagged value
     }
     void insert_row(size_t ndx, ObjKey k, const FieldValues& init_values);
+    void append_rows(const BulkValues& values, size_t begin, size_t num_rows, int64_t key_adj);
     void move(size_t ndx, ClusterNode* new_node, int64_t key_adj) override;
     template <class T>
     void do_create(ColKey col);
@@ -316,6 +337,9 @@ private:
     template <class T>
     void do_insert_row(size_t ndx, ColKey col, Mixed init_val, bool nullable);
     template <class T>
+    void do_insert_rows(size_t ndx, ColKey col, const std::vector<Mixed>* init_vals, size_t begin, size_t num_rows,
+                        bool nullable);
+    template <class T>
     void do_move(size_t ndx, ColKey col, Cluster* to);
     template <class T>
     void do_erase(size_t ndx, ColKey col);
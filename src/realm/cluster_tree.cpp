@@ -91,6 +91,8 @@ public:
     void remove_column(ColKey col) override;
     size_t nb_columns() const override;
     ref_type insert(ObjKey k, const FieldValues& init_values, State& state) override;
+    ref_type insert_rows(const BulkValues& values, size_t begin, int64_t key_adj, size_t& num_inserted,
+                         State& state) override;
     bool try_get(ObjKey k, State& state) const noexcept override;
     ObjKey get(size_t ndx, State& state) const override;
     size_t get_ndx(ObjKey key, size_t ndx) const noexcept override;
@@ -171,6 +173,9 @@ private:
         Array::erase(ndx + s_first_node_index);
     }
     void move(size_t ndx, ClusterNode* new_node, int64_t key_adj) override;
+    // Insert a new sibling of the child described by `child_info`. Return
+    // reference to new node created (if any)
+    ref_type insert_sibling(ChildInfo& child_info, ref_type new_sibling_ref, State& state);
 
     template <class T, class F>
     T recurse(ObjKey key, F func);
@@ -296,44 +301,69 @@ ref_type ClusterNodeInner::insert(ObjKey key, const FieldValues& init_values, Cl
             return ref_type(0);
         }
 
-        size_t new_ref_ndx = child_info.ndx + 1;
+        return insert_sibling(child_info, new_sibling_ref, state);
+    });
+}
 
-        int64_t split_key_value = state.split_key + child_info.offset;
-        uint64_t sz = node_size();
-        if (sz < cluster_node_size) {
-            if (m_keys.is_attached()) {
-                m_keys.insert(new_ref_ndx, split_key_value);
-            }
-            else {
-                if (uint64_t(split_key_value) != sz << m_shift_factor) {
-                    ensure_general_form();
-                    m_keys.insert(new_ref_ndx, split_key_value);
-                }
-            }
-            _insert_child_ref(new_ref_ndx, new_sibling_ref);
+ref_type ClusterNodeInner::insert_rows(const BulkValues& values, size_t begin, int64_t key_adj,
+                                       size_t& num_inserted, ClusterNode::State& state)
+{
+    // All the new keys are greater than any key in this subtree, so this
+    // descends to the last child
+    ObjKey first_key(values.keys[begin].value - key_adj);
+    return recurse<ref_type>(first_key, [&](ClusterNode* node, ChildInfo& child_info) {
+        ref_type new_sibling_ref =
+            node->insert_rows(values, begin, key_adj + int64_t(child_info.offset), num_inserted, state);
+
+        set_tree_size(get_tree_size() + num_inserted);
+
+        if (!new_sibling_ref) {
             return ref_type(0);
         }
 
-        ClusterNodeInner child(m_alloc, m_tree_top);
-        child.create(m_sub_tree_depth);
-        if (new_ref_ndx == sz) {
-            child.add(new_sibling_ref);
-            state.split_key = split_key_value;
+        return insert_sibling(child_info, new_sibling_ref, state);
+    });
+}
+
+ref_type ClusterNodeInner::insert_sibling(ChildInfo& child_info, ref_type new_sibling_ref, ClusterNode::State& state)
+{
+    size_t new_ref_ndx = child_info.ndx + 1;
+
+    int64_t split_key_value = state.split_key + child_info.offset;
+    uint64_t sz = node_size();
+    if (sz < cluster_node_size) {
+        if (m_keys.is_attached()) {
+            m_keys.insert(new_ref_ndx, split_key_value);
         }
         else {
-            int64_t first_key_value = m_keys.get(new_ref_ndx);
-            child.ensure_general_form();
-            move(new_ref_ndx, &child, first_key_value);
-            add(new_sibling_ref, split_key_value); // Throws
-            state.split_key = first_key_value;
+            if (uint64_t(split_key_value) != sz << m_shift_factor) {
+                ensure_general_form();
+                m_keys.insert(new_ref_ndx, split_key_value);
+            }
         }
+        _insert_child_ref(new_ref_ndx, new_sibling_ref);
+        return ref_type(0);
+    }
+
+    ClusterNodeInner child(m_alloc, m_tree_top);
+    child.create(m_sub_tree_depth);
+    if (new_ref_ndx == sz) {
+        child.add(new_sibling_ref);
+        state.split_key = split_key_value;
+    }
+    else {
+        int64_t first_key_value = m_keys.get(new_ref_ndx);
+        child.ensure_general_form();
+        move(new_ref_ndx, &child, first_key_value);
+        add(new_sibling_ref, split_key_value); // Throws
+        state.split_key = first_key_value;
+    }
 
-        // Some objects has been moved out of this tree - find out how many
-        size_t child_sub_tree_size = child.update_sub_tree_size();
-        set_tree_size(get_tree_size() - child_sub_tree_size);
+    // Some objects has been moved out of this tree - find out how many
+    size_t child_sub_tree_size = child.update_sub_tree_size();
+    set_tree_size(get_tree_size() - child_sub_tree_size);
 
-        return child.get_ref();
-    });
+    return child.get_ref();
 }
 
 bool ClusterNodeInner::try_get(ObjKey key, ClusterNode::State& state) const noexcept
@@ -880,16 +910,62 @@ void ClusterTree::insert_fast(ObjKey k, const FieldValues& init_values, ClusterN
 {
     ref_type new_sibling_ref = m_root->insert(k, init_values, state);
     if (REALM_UNLIKELY(new_sibling_ref)) {
-        auto new_root = std::make_unique<ClusterNodeInner>(m_root->get_alloc(), *this);
-        new_root->create(m_root->get_sub_tree_depth() + 1);
+        add_root_sibling(new_sibling_ref, state.split_key); // Throws
+    }
+    m_size++;
+}
 
-        new_root->add(m_root->get_ref());                // Throws
-        new_root->add(new_sibling_ref, state.split_key); // Throws
-        new_root->update_sub_tree_size();
+void ClusterTree::add_root_sibling(ref_type new_sibling_ref, int64_t split_key)
+{
+    auto new_root = std::make_unique<ClusterNodeInner>(m_root->get_alloc(), *this);
+    new_root->create(m_root->get_sub_tree_depth() + 1);
 
-        replace_root(std::move(new_root));
+    new_root->add(m_root->get_ref());          // Throws
+    new_root->add(new_sibling_ref, split_key); // Throws
+    new_root->update_sub_tree_size();
+
+    replace_root(std::move(new_root));
+}
+
+void ClusterTree::insert_rows(const BulkValues& values)
+{
+    size_t num_rows = values.keys.size();
+    if (num_rows == 0)
+        return;
+
+    // When the objects are appended in key order, the leaves are filled
+    // directly, one column at a time, instead of descending the tree and
+    // visiting every column once per object.
+    bool append = (m_size == 0 || values.keys[0].value > get_last_key_value());
+    for (size_t i = 1; append && i < num_rows; ++i)
+        append = (values.keys[i - 1] < values.keys[i]);
+
+    if (append) {
+        size_t begin = 0;
+        while (begin < num_rows) {
+            ClusterNode::State state;
+            size_t num_inserted = 0;
+            ref_type new_sibling_ref = m_root->insert_rows(values, begin, 0, num_inserted, state); // Throws
+            if (new_sibling_ref) {
+                add_root_sibling(new_sibling_ref, state.split_key); // Throws
+            }
+            REALM_ASSERT(num_inserted > 0);
+            m_size += num_inserted;
+            begin += num_inserted;
+        }
     }
-    m_size++;
+    else {
+        for (size_t i = 0; i < num_rows; ++i) {
+            FieldValues init_values;
+            for (auto& column : values.columns)
+                init_values.insert(column.first, (*column.second)[i]);
+            ClusterNode::State state;
+            insert_fast(values.keys[i], init_values, state); // Throws
+        }
+    }
+
+    bump_content_version();
+    bump_storage_version();
 }
 
 ClusterNode::State ClusterTree::insert(ObjKey k, const FieldValues& init_values)
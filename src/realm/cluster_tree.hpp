@@ -132,6 +132,9 @@ public:
     void insert_fast(ObjKey k, const FieldValues& init_values, ClusterNode::State& state);
     // Create and return object
     ClusterNode::State insert(ObjKey k, const FieldValues&);
+    // Create entries for a number of objects, filling the leaves column by
+    // column, but do not update search indexes
+    void insert_rows(const BulkValues& values);
     // Delete object with given key
     void erase(ObjKey k, CascadeState& state);
     // Check if an object with given key exists
@@ -178,6 +181,8 @@ protected:
 
     void clear();
     void replace_root(std::unique_ptr<ClusterNode> leaf);
+    // Make the root and its new sibling the children of a new root
+    void add_root_sibling(ref_type new_sibling_ref, int64_t split_key);
 
     std::unique_ptr<ClusterNode> create_root_from_parent(ArrayParent* parent, size_t ndx_in_parent);
     std::unique_ptr<ClusterNode> get_node(ArrayParent* parent, size_t ndx_in_parent) const;
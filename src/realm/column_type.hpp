@@ -146,8 +146,10 @@ enum ColumnAttr {
     /// `col_attr_Indexed`.
     col_attr_Unique = 2,
 
-    /// Reserved for future use.
-    col_attr_Reserved = 4,
+    /// Specifies that this string column has a full-text index. Mutually
+    /// exclusive with `col_attr_Indexed`. Introduced in file format 23, as
+    /// older versions would read the column as having a plain search index.
+    col_attr_FullText_Indexed = 4,
 
     /// Specifies that the links of this column are strong, not weak. Applies
     /// only to link columns (`type_Link` and `type_LinkList`).
@@ -165,6 +167,12 @@ enum ColumnAttr {
     /// Each element is a set of values
     col_attr_Set = 128,
 
+    /// Specifies that this string column has a trigram index. Mutually
+    /// exclusive with the other index attributes. Like those it is kept in
+    /// the spec only, as a column key has no room for it. Introduced in file
+    /// format 23.
+    col_attr_Trigram_Indexed = 256,
+
     /// Either list, dictionary, or set
     col_attr_Collection = 128 + 64 + 32
 };
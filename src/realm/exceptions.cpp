@@ -106,6 +106,8 @@ const char* LogicError::message() const noexcept
             return "Search index on a subtable of a subtable is not yet supported";
         case collection_type_mismatch:
             return "Instantiating a collection object not matching column type";
+        case file_format_too_old:
+            return "The file format of the Realm is too old for this feature";
     }
     return "Unknown error";
 }
@@ -301,7 +301,11 @@ public:
         subtable_of_subtable_index,
 
         /// You try to instantiate a collection object not matching column type
-        collection_type_mismatch
+        collection_type_mismatch,
+
+        /// The group has a file format that predates the feature being added
+        /// to it, and it cannot be upgraded (see Group::get_file_format_version()).
+        file_format_too_old
     };
 
     LogicError(ErrorKind message);
@@ -331,12 +331,11 @@ int Group::get_target_file_format_version_for_session(int current_file_format_ve
     // Please see Group::get_file_format_version() for information about the
     // individual file format versions.
 
-    if (requested_history_type == Replication::hist_None) {
-        if (current_file_format_version == 22) {
-            // We are able to open these file formats in RO mode
-            return current_file_format_version;
-        }
-    }
+    // Sessions without history are writable as well, so files of older
+    // formats are always upgraded. A Group opened directly from a file is not
+    // upgraded (see Group::open()).
+    static_cast<void>(current_file_format_version);
+    static_cast<void>(requested_history_type);
 
     return g_current_file_format_version;
 }
@@ -407,6 +406,7 @@ int Group::read_only_version_check(SlabAlloc& alloc, ref_type top_ref, const std
         case 11:
         case 20:
         case 21:
+        case 22:
         case g_current_file_format_version:
             file_format_ok = true;
             break;
@@ -429,8 +429,9 @@ void Group::open(ref_type top_ref, const std::string& file_path)
     else {
         // From a technical point of view, we could upgrade the Realm file
         // format in memory here, but since upgrading can be expensive, it is
-        // currently disallowed.
-        REALM_ASSERT(target_file_format_version == m_file_format_version);
+        // currently disallowed. Format 22 files can be opened as they are,
+        // but features introduced by format 23 cannot be added to them.
+        REALM_ASSERT(m_file_format_version == 22 || target_file_format_version == m_file_format_version);
     }
 
     // Make all dynamically allocated memory (space beyond the attached file) as
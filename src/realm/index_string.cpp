@@ -28,7 +28,9 @@
 #include <realm/table.hpp>
 #include <realm/timestamp.hpp>
 #include <realm/column_integer.hpp>
+#include <realm/sort_descriptor.hpp>
 #include <realm/unicode.hpp>
+#include <realm/util/parallel_for.hpp>
 
 using namespace realm;
 using namespace realm::util;
@@ -217,8 +219,7 @@ int64_t IndexArray::index_string(Mixed value, InternalFindResult& result_ref, co
         if (ref & 1) {
             int64_t key_value = int64_t(ref >> 1);
 
-            Mixed a = column.get_value(ObjKey(key_value));
-            if (a == value) {
+            if (column.is_tokenized() || column.get_value(ObjKey(key_value)) == value) {
                 result_ref.payload = key_value;
                 return first ? key_value : get_count ? 1 : FindRes_single;
             }
@@ -231,6 +232,13 @@ int64_t IndexArray::index_string(Mixed value, InternalFindResult& result_ref, co
         // List of row indices with common prefix up to this point, in sorted order.
         if (!sub_isindex) {
             const IntegerColumn sub(m_alloc, ref_type(ref));
+            if (column.is_tokenized()) {
+                // All objects in the list contain the token
+                result_ref.payload = from_ref(ref_type(ref));
+                result_ref.start_ndx = 0;
+                result_ref.end_ndx = sub.size();
+                return first ? sub.get(0) : get_count ? int64_t(sub.size()) : int64_t(FindRes_column);
+            }
             return from_list<method>(value, result_ref, sub, column);
         }
 
@@ -547,8 +555,7 @@ void IndexArray::index_string_all(Mixed value, std::vector<ObjKey>& result, cons
         if (ref & 1) {
             ObjKey k(int64_t(ref >> 1));
 
-            Mixed a = column.get_value(k);
-            if (a == value) {
+            if (column.is_tokenized() || column.get_value(k) == value) {
                 result.push_back(k);
                 return;
             }
@@ -561,6 +568,14 @@ void IndexArray::index_string_all(Mixed value, std::vector<ObjKey>& result, cons
         // List of row indices with common prefix up to this point, in sorted order.
         if (!sub_isindex) {
             const IntegerColumn sub(m_alloc, ref_type(ref));
+            if (column.is_tokenized()) {
+                // All objects in the list contain the token
+                result.reserve(result.size() + sub.size());
+                for (IntegerColumn::const_iterator it = sub.cbegin(); it != sub.cend(); ++it) {
+                    result.push_back(ObjKey(*it));
+                }
+                return;
+            }
             return from_list_all(value, result, sub, column);
         }
 
@@ -653,6 +668,277 @@ void StringIndex::insert_with_offset(ObjKey obj_key, StringData index_data, cons
     TreeInsert(obj_key, key, offset, index_data, value); // Throws
 }
 
+std::set<std::string> StringIndex::tokenize(const Mixed& value) const
+{
+    if (!value.is_type(type_String))
+        return {};
+    if (is_trigram_index())
+        return tokenize_trigrams(value.get_string());
+    return tokenize_text(value.get_string());
+}
+
+void StringIndex::insert_tokens(ObjKey key, const Mixed& value)
+{
+    for (auto& token : tokenize(value)) {
+        StringData index_data(token);
+        insert_with_offset(key, index_data, Mixed(index_data), 0); // Throws
+    }
+}
+
+// The slot of a new key in a leaf: a literal row index, or for a tokenized
+// index where the token goes on beyond this key, a subindex holding the row.
+int64_t StringIndex::create_slot(ObjKey key, StringData index_data, size_t offset)
+{
+    if (is_tokenized() && index_data.size() - offset >= s_index_key_length) {
+        StringIndex subindex(m_target_column, m_array->get_alloc());
+        subindex.insert_with_offset(key, index_data, Mixed(index_data), offset + s_index_key_length); // Throws
+        return int64_t(subindex.get_ref());
+    }
+    return int64_t((uint64_t(key.value) << 1) + 1); // shift to indicate literal
+}
+
+// Adds a row to an existing slot of a tokenized index. The key of the slot
+// identifies the token if the token ends here, and the slot then holds a row
+// index or a list. Otherwise it holds a subindex.
+void StringIndex::token_slot_insert(ObjKey key, StringData index_data, size_t offset, size_t ins_pos_refs)
+{
+    Allocator& alloc = m_array->get_alloc();
+    uint64_t slot_value = uint64_t(m_array->get(ins_pos_refs));
+
+    if ((slot_value & 1) != 0) {
+        ObjKey key2 = ObjKey(int64_t(slot_value >> 1));
+        REALM_ASSERT(key != key2);
+        Array row_list(alloc);
+        row_list.create(Array::type_Normal); // Throws
+        row_list.add(key < key2 ? key.value : key2.value);
+        row_list.add(key < key2 ? key2.value : key.value);
+        m_array->set(ins_pos_refs, row_list.get_ref());
+        return;
+    }
+
+    ref_type ref = ref_type(slot_value);
+    if (!Array::get_context_flag_from_header(alloc.translate(ref))) {
+        IntegerColumn sub(alloc, ref); // Throws
+        sub.set_parent(m_array.get(), ins_pos_refs);
+        // In most cases the keys will be added to the end
+        if (key.value > sub.back()) {
+            sub.add(key.value);
+        }
+        else {
+            IntegerColumn::const_iterator lower = std::lower_bound(sub.cbegin(), sub.cend(), key.value);
+            sub.insert(lower.get_position(), key.value);
+        }
+        return;
+    }
+
+    StringIndex subindex(ref, m_array.get(), ins_pos_refs, m_target_column, alloc);
+    subindex.insert_with_offset(key, index_data, Mixed(index_data), offset + s_index_key_length);
+}
+
+namespace {
+
+using BulkEntry = std::pair<Mixed, ObjKey>;
+
+StringIndex::key_type get_bulk_key(const BulkEntry& entry, size_t offset)
+{
+    StringConversionBuffer buffer;
+    return StringIndex::create_key(entry.first.get_index_data(buffer), offset);
+}
+
+// The order of values in a list of row indexes (see SortedListComparator)
+bool value_less(const Mixed& a, const Mixed& b)
+{
+    if (a.is_null() || b.is_null())
+        return !b.is_null() && a.is_null();
+    if (a == b)
+        return false;
+    return a.compare_signed(b) < 0;
+}
+
+// Orders the entries as they appear when traversing the index: by the 4 byte
+// keys on each level, then, within the lists at the bottom, by value and key.
+bool bulk_entry_less(const BulkEntry& a, const BulkEntry& b)
+{
+    StringConversionBuffer buffer_a;
+    StringConversionBuffer buffer_b;
+    StringData data_a = a.first.get_index_data(buffer_a);
+    StringData data_b = b.first.get_index_data(buffer_b);
+    for (size_t offset = 0; offset <= StringIndex::s_max_offset; offset += StringIndex::s_index_key_length) {
+        if (offset > data_a.size() && offset > data_b.size())
+            break;
+        auto key_a = StringIndex::create_key(data_a, offset);
+        auto key_b = StringIndex::create_key(data_b, offset);
+        if (key_a != key_b)
+            return key_a < key_b;
+    }
+    if (value_less(a.first, b.first))
+        return true;
+    if (value_less(b.first, a.first))
+        return false;
+    return a.second < b.second;
+}
+
+} // anonymous namespace
+
+void StringIndex::insert_bulk(std::vector<std::pair<Mixed, ObjKey>>& entries)
+{
+    if (is_tokenized()) {
+        for (auto& entry : entries) {
+            insert_tokens(entry.second, entry.first); // Throws
+        }
+        return;
+    }
+    if (!is_empty()) {
+        for (auto& entry : entries) {
+            StringConversionBuffer buffer;
+            insert_with_offset(entry.second, entry.first.get_index_data(buffer), entry.first, 0); // Throws
+        }
+        return;
+    }
+    if (entries.empty())
+        return;
+
+    // Sort on the keys of the first two levels first, which is cheap, and
+    // only compare the entries in full when those are equal. Flipping the
+    // sign bits makes the signed keys compare correctly as unsigned.
+    struct SortItem {
+        uint64_t prefix;
+        size_t ndx;
+    };
+    std::vector<SortItem> items;
+    items.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        StringConversionBuffer buffer;
+        StringData data = entries[i].first.get_index_data(buffer);
+        uint64_t key_0 = uint32_t(create_key(data, 0)) ^ 0x80000000;
+        uint64_t key_1 = uint32_t(create_key(data, s_index_key_length)) ^ 0x80000000;
+        items.push_back({(key_0 << 32) | key_1, i});
+    }
+    auto item_less = [&](const SortItem& a, const SortItem& b) {
+        if (a.prefix != b.prefix)
+            return a.prefix < b.prefix;
+        return bulk_entry_less(entries[a.ndx], entries[b.ndx]);
+    };
+
+    // The entries under each top level key can be sorted independently of
+    // each other, so they are distributed over the threads by that key.
+    std::sort(items.begin(), items.end(), [](const SortItem& a, const SortItem& b) {
+        return (a.prefix >> 32) < (b.prefix >> 32);
+    });
+    std::vector<size_t> bounds;
+    bounds.push_back(0);
+    for (size_t i = 1; i < items.size(); ++i) {
+        if ((items[i - 1].prefix >> 32) != (items[i].prefix >> 32))
+            bounds.push_back(i);
+    }
+    bounds.push_back(items.size());
+    size_t num_groups = bounds.size() - 1;
+    util::parallel_for(num_groups, get_parallel_sort_threads(entries.size()), [&](size_t i) {
+        std::sort(items.begin() + bounds[i], items.begin() + bounds[i + 1], item_less);
+    });
+
+    std::vector<std::pair<Mixed, ObjKey>> sorted;
+    sorted.reserve(entries.size());
+    for (auto& item : items)
+        sorted.push_back(entries[item.ndx]);
+    entries.swap(sorted);
+
+    // Nodes are created by this thread only, as the allocator is not thread safe
+    ref_type new_ref = build_bulk(entries, 0, entries.size(), 0); // Throws
+    ref_type old_ref = get_ref();
+    m_array->init_from_ref(new_ref);
+    m_array->update_parent();
+    Array::destroy_deep(old_ref, m_array->get_alloc());
+}
+
+// Build the (sub)index for the sorted entries in [begin, end), which all have
+// the same keys at the levels above `offset`, and return its ref.
+ref_type StringIndex::build_bulk(const std::vector<std::pair<Mixed, ObjKey>>& entries, size_t begin, size_t end,
+                                 size_t offset)
+{
+    Allocator& alloc = m_array->get_alloc();
+    size_t suboffset = offset + s_index_key_length;
+    std::vector<std::pair<key_type, int64_t>> slots;
+
+    size_t i = begin;
+    while (i < end) {
+        key_type key = get_bulk_key(entries[i], offset);
+        size_t j = i + 1;
+        while (j < end && get_bulk_key(entries[j], offset) == key)
+            ++j;
+
+        if (j - i == 1) {
+            int64_t shifted = int64_t((uint64_t(entries[i].second.value) << 1) + 1); // shift to indicate literal
+            slots.emplace_back(key, shifted);
+            i = j;
+            continue;
+        }
+
+        // Like leaf_insert(), values sharing all of their index data, or their
+        // prefix up to the maximum depth, go in a list. Others get a subindex.
+        bool use_list = (suboffset > s_max_offset);
+        if (!use_list) {
+            StringConversionBuffer buffer;
+            StringData first_data = entries[i].first.get_index_data(buffer);
+            use_list = true;
+            for (size_t k = i + 1; use_list && k < j; ++k) {
+                StringConversionBuffer buffer_k;
+                use_list = (entries[k].first.get_index_data(buffer_k) == first_data);
+            }
+        }
+        if (use_list) {
+            IntegerColumn row_list(alloc);
+            row_list.create(); // Throws
+            for (size_t k = i; k < j; ++k)
+                row_list.add(entries[k].second.value); // Throws
+            slots.emplace_back(key, int64_t(row_list.get_ref()));
+        }
+        else {
+            slots.emplace_back(key, int64_t(build_bulk(entries, i, j, suboffset))); // Throws
+        }
+        i = j;
+    }
+
+    return build_nodes(slots);
+}
+
+// Distribute the slots over as many full leaves as needed, and build the
+// inner nodes above them. Return the ref of the root.
+ref_type StringIndex::build_nodes(const std::vector<std::pair<key_type, int64_t>>& slots)
+{
+    Allocator& alloc = m_array->get_alloc();
+    std::vector<std::pair<key_type, ref_type>> children;
+    size_t ndx = 0;
+    do {
+        std::unique_ptr<IndexArray> leaf(create_node(alloc, true)); // Throws
+        Array keys(alloc);
+        get_child(*leaf, 0, keys);
+        size_t leaf_end = std::min(slots.size(), ndx + REALM_MAX_BPNODE_SIZE);
+        for (; ndx < leaf_end; ++ndx) {
+            keys.add(slots[ndx].first);   // Throws
+            leaf->add(slots[ndx].second); // Throws
+        }
+        children.emplace_back(key_type(keys.is_empty() ? 0 : keys.back()), leaf->get_ref());
+    } while (ndx < slots.size());
+
+    while (children.size() > 1) {
+        std::vector<std::pair<key_type, ref_type>> parents;
+        for (size_t begin = 0; begin < children.size(); begin += REALM_MAX_BPNODE_SIZE) {
+            std::unique_ptr<IndexArray> inner(create_node(alloc, false)); // Throws
+            Array keys(alloc);
+            get_child(*inner, 0, keys);
+            size_t inner_end = std::min(children.size(), begin + REALM_MAX_BPNODE_SIZE);
+            for (size_t k = begin; k < inner_end; ++k) {
+                keys.add(children[k].first);    // Throws
+                inner->add(children[k].second); // Throws
+            }
+            parents.emplace_back(children[inner_end - 1].first, inner->get_ref());
+        }
+        children = std::move(parents);
+    }
+    return children[0].second;
+}
+
 void StringIndex::insert_to_existing_list_at_lower(ObjKey key, Mixed value, IntegerColumn& list,
                                                    const IntegerColumnIterator& lower)
 {
@@ -968,9 +1254,9 @@ bool StringIndex::leaf_insert(ObjKey obj_key, key_type key, size_t offset, Strin
             return false;
 
         // When key is outside current range, we can just add it
+        int64_t slot = create_slot(obj_key, index_data, offset); // Throws
         keys.add(key);
-        int64_t shifted = int64_t((uint64_t(obj_key.value) << 1) + 1); // shift to indicate literal
-        m_array->add(shifted);
+        m_array->add(slot);
         return true;
     }
 
@@ -982,13 +1268,17 @@ bool StringIndex::leaf_insert(ObjKey obj_key, key_type key, size_t offset, Strin
         if (noextend)
             return false;
 
+        int64_t slot = create_slot(obj_key, index_data, offset); // Throws
         keys.insert(ins_pos, key);
-        int64_t shifted = int64_t((uint64_t(obj_key.value) << 1) + 1); // shift to indicate literal
-        m_array->insert(ins_pos_refs, shifted);
+        m_array->insert(ins_pos_refs, slot);
         return true;
     }
 
     // This leaf already has a slot for for the key
+    if (is_tokenized()) {
+        token_slot_insert(obj_key, index_data, offset, ins_pos_refs); // Throws
+        return true;
+    }
 
     uint64_t slot_value = uint64_t(m_array->get(ins_pos_refs));
     size_t suboffset = offset + s_index_key_length;
@@ -1197,11 +1487,23 @@ void StringIndex::do_delete(ObjKey obj_key, StringData index_data, size_t offset
 
 void StringIndex::erase(ObjKey key)
 {
+    if (is_tokenized()) {
+        for (auto& token : tokenize(get(key))) {
+            do_delete(key, token, 0);
+            collapse_root();
+        }
+        return;
+    }
+
     StringConversionBuffer buffer;
     StringData index_data = get(key).get_index_data(buffer);
 
     do_delete(key, index_data, 0);
+    collapse_root();
+}
 
+void StringIndex::collapse_root()
+{
     // Collapse top nodes with single item
     while (m_array->is_inner_bptree_node()) {
         REALM_ASSERT(m_array->size() > 1); // node cannot be empty
@@ -1390,6 +1692,13 @@ void StringIndex::verify() const
                     StringIndex ndx(to_ref(ref), m_array.get(), i, m_target_column, alloc);
                     ndx.verify();
                 }
+                else if (is_tokenized()) {
+                    // The objects containing one token, in ascending order
+                    IntegerColumn sub(alloc, to_ref(ref)); // Throws
+                    for (size_t j = 1; j < sub.size(); ++j) {
+                        REALM_ASSERT(sub.get(j - 1) < sub.get(j));
+                    }
+                }
                 else {
                     IntegerColumn sub(alloc, to_ref(ref)); // Throws
                     IntegerColumn::const_iterator it = sub.cbegin();
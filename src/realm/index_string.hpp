@@ -22,6 +22,9 @@
 #include <cstring>
 #include <memory>
 #include <array>
+#include <set>
+#include <string>
+#include <vector>
 
 #include <realm/array.hpp>
 #include <realm/table_cluster_tree.hpp>
@@ -60,6 +63,15 @@ the same Column, but Columns may contain more than just duplicates if the depth
 long strings that have a long common prefix but differ in the last couple bytes. If a Column stores more than just
 duplicates, then the list is kept sorted in ascending order by string value and within the groups of common
 strings, the rows are sorted in ascending order.
+
+A full-text index uses the same structure, but stores each object under every word of its string (see
+tokenize_text()) rather than under the whole value. Words never contain 'X' or NUL, so a 4-byte key that holds the
+terminating 'X' identifies the word exactly. Row indexes and Columns are only stored under such keys, which means
+that a Column holds exactly the objects containing one word, and lookups never need to read the indexed strings.
+
+A trigram index works the same way, but stores each object under every 3-byte substring of its string with ASCII
+letters folded to lower case (see tokenize_trigrams()). All keys have the same length, so the terminating 'X' again
+identifies the trigram exactly.
 */
 
 namespace realm {
@@ -110,14 +122,21 @@ using StringConversionBuffer = std::array<char, string_conversion_buffer_size>;
 static_assert(sizeof(UUID::UUIDBytes) <= string_conversion_buffer_size,
               "if you change the size of a UUID then also change the string index buffer space");
 
+// A general index maps each value to the objects holding it. A full-text
+// index maps each word (see tokenize_text()) to the objects whose string
+// contains it, and a trigram index does the same for each trigram (see
+// tokenize_trigrams()).
+enum class IndexType { General, Fulltext, Trigram };
+
 // The purpose of this class is to get easy access to fields in a specific column in the
 // cluster. When you have an object like this, you can get a string version of the relevant
 // field based on the key for the object.
 class ClusterColumn {
 public:
-    ClusterColumn(const TableClusterTree* cluster_tree, ColKey column_key)
+    ClusterColumn(const TableClusterTree* cluster_tree, ColKey column_key, IndexType type = IndexType::General)
         : m_cluster_tree(cluster_tree)
         , m_column_key(column_key)
+        , m_type(type)
     {
     }
     size_t size() const
@@ -141,11 +160,21 @@ public:
         return m_column_key;
     }
     bool is_nullable() const;
+    IndexType get_index_type() const
+    {
+        return m_type;
+    }
+    // True if objects are stored under the tokens of their value rather than under the value itself
+    bool is_tokenized() const
+    {
+        return m_type != IndexType::General;
+    }
     Mixed get_value(ObjKey key) const;
 
 private:
     const TableClusterTree* m_cluster_tree;
     ColKey m_column_key;
+    IndexType m_type;
 };
 
 class StringIndex {
@@ -161,6 +190,21 @@ public:
         return m_target_column.get_column_key();
     }
 
+    IndexType get_index_type() const
+    {
+        return m_target_column.get_index_type();
+    }
+
+    bool is_fulltext_index() const
+    {
+        return get_index_type() == IndexType::Fulltext;
+    }
+
+    bool is_trigram_index() const
+    {
+        return get_index_type() == IndexType::Trigram;
+    }
+
     static bool type_supported(realm::DataType type)
     {
         return (type == type_Int || type == type_String || type == type_Bool || type == type_Timestamp ||
@@ -197,6 +241,13 @@ public:
     template <class T>
     void set(ObjKey key, util::Optional<T> new_value);
 
+    /// Insert many objects at once, given as (value, key) pairs. If the index
+    /// is empty, the pairs are sorted (possibly in parallel, see
+    /// set_parallel_sort_threshold()), and the index is built bottom-up from
+    /// them. Otherwise they are inserted one by one. The order of `entries`
+    /// is unspecified on return.
+    void insert_bulk(std::vector<std::pair<Mixed, ObjKey>>& entries);
+
     void erase(ObjKey key);
 
     template <class T>
@@ -263,6 +314,17 @@ private:
     static IndexArray* create_node(Allocator&, bool is_leaf);
 
     void insert_with_offset(ObjKey key, StringData index_data, const Mixed& value, size_t offset);
+    bool is_tokenized() const
+    {
+        return m_target_column.is_tokenized();
+    }
+    std::set<std::string> tokenize(const Mixed& value) const;
+    void insert_tokens(ObjKey key, const Mixed& value);
+    int64_t create_slot(ObjKey key, StringData index_data, size_t offset);
+    void token_slot_insert(ObjKey key, StringData index_data, size_t offset, size_t ins_pos_refs);
+    ref_type build_bulk(const std::vector<std::pair<Mixed, ObjKey>>& entries, size_t begin, size_t end,
+                        size_t offset);
+    ref_type build_nodes(const std::vector<std::pair<key_type, int64_t>>& slots);
     void insert_row_list(size_t ref, size_t offset, StringData value);
     void insert_to_existing_list(ObjKey key, Mixed value, IntegerColumn& list);
     void insert_to_existing_list_at_lower(ObjKey key, Mixed value, IntegerColumn& list,
@@ -296,6 +358,7 @@ private:
     void node_insert_split(size_t ndx, size_t new_ref);
     void node_insert(size_t ndx, size_t ref);
     void do_delete(ObjKey key, StringData, size_t offset);
+    void collapse_root();
 
     Mixed get(ObjKey key) const;
 
@@ -411,6 +474,10 @@ void StringIndex::insert(ObjKey key, T value)
 {
     StringConversionBuffer buffer;
     Mixed m(value);
+    if (is_tokenized()) {
+        insert_tokens(key, m); // Throws
+        return;
+    }
     size_t offset = 0;                                      // First key from beginning of string
     insert_with_offset(key, m.get_index_data(buffer), m, offset); // Throws
 }
@@ -439,6 +506,11 @@ void StringIndex::set(ObjKey key, T new_value)
         // might find the duplicate if we insert before erasing.
         erase(key); // Throws
 
+        if (is_tokenized()) {
+            insert_tokens(key, new_value2); // Throws
+            return;
+        }
+
         StringConversionBuffer buffer;
         size_t offset = 0;                               // First key from beginning of string
         auto index_data = new_value2.get_index_data(buffer);
@@ -1326,6 +1326,8 @@ Obj& Obj::set<int64_t>(ColKey col_key, int64_t value, bool is_default)
     if (index && !m_key.is_unresolved()) {
         index->set<int64_t>(m_key, value);
     }
+    if (m_table->has_aggregate_views())
+        const_cast<Table*>(m_table.unchecked_ptr())->update_aggregate_views(*this, col_key, value);
 
     Allocator& alloc = get_alloc();
     alloc.bump_content_version();
@@ -1405,6 +1407,8 @@ Obj& Obj::add_int(ColKey col_key, int64_t value)
                 if (StringIndex* index = m_table->get_search_index(col_key)) {
                     index->set<int64_t>(m_key, new_val);
                 }
+                if (m_table->has_aggregate_views())
+                    const_cast<Table*>(m_table.unchecked_ptr())->update_aggregate_views(*this, col_key, new_val);
                 values.set(m_row_ndx, new_val);
             }
             else {
@@ -1420,6 +1424,8 @@ Obj& Obj::add_int(ColKey col_key, int64_t value)
             if (StringIndex* index = m_table->get_search_index(col_key)) {
                 index->set<int64_t>(m_key, new_val);
             }
+            if (m_table->has_aggregate_views())
+                const_cast<Table*>(m_table.unchecked_ptr())->update_aggregate_views(*this, col_key, new_val);
             values.set(m_row_ndx, new_val);
         }
     }
@@ -1643,10 +1649,12 @@ Obj& Obj::set(ColKey col_key, T value, bool is_default)
 
     check_range(value);
 
-    StringIndex* index = m_table->get_search_index(col_key);
+    StringIndex* index = m_table->get_index_accessor(col_key);
     if (index && !m_key.is_unresolved()) {
         index->set<T>(m_key, value);
     }
+    if (m_table->has_aggregate_views())
+        const_cast<Table*>(m_table.unchecked_ptr())->update_aggregate_views(*this, col_key, value);
 
     Allocator& alloc = get_alloc();
     alloc.bump_content_version();
@@ -2208,10 +2216,12 @@ Obj& Obj::set_null(ColKey col_key, bool is_default)
 
         update_if_needed();
 
-        StringIndex* index = m_table->get_search_index(col_key);
+        StringIndex* index = m_table->get_index_accessor(col_key);
         if (index && !m_key.is_unresolved()) {
             index->set(m_key, null{});
         }
+        if (m_table->has_aggregate_views())
+            const_cast<Table*>(m_table.unchecked_ptr())->update_aggregate_views(*this, col_key, Mixed());
 
         switch (col_type) {
             case col_type_Int:
@@ -720,6 +720,7 @@ void SyncSession::create_sync_session()
     session_config.ssl_trust_certificate_path = m_config.ssl_trust_certificate_path;
     session_config.ssl_verify_callback = m_config.ssl_verify_callback;
     session_config.proxy_config = m_config.proxy_config;
+    session_config.flx_bootstrap_batch_size_bytes = m_config.flx_bootstrap_batch_size_bytes;
     if (m_config.on_download_message_received_hook) {
         session_config.on_download_message_received_hook =
             [hook = m_config.on_download_message_received_hook, anchor = weak_from_this()](
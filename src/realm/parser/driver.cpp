@@ -6,6 +6,9 @@
 #include <realm/uuid.hpp>
 #include "realm/util/base64.hpp"
 
+#include <mutex>
+#include <unordered_map>
+
 #define YY_NO_UNISTD_H 1
 #define YY_NO_INPUT 1
 #include "realm/parser/generated/query_flex.hpp"
@@ -60,6 +63,7 @@ static std::map<int, std::string> opstr = {
     {CompareNode::CONTAINS, "contains"},
     {CompareNode::LIKE, "like"},
     {CompareNode::IN, "in"},
+    {CompareNode::TEXT, "text"},
 };
 
 std::string print_pretty_objlink(const ObjLink& link, const Group* g, ParserDriver* drv)
@@ -606,6 +610,20 @@ Query StringOpsNode::visit(ParserDriver* drv)
 
     verify_only_string_types(right_type, opstr[op]);
 
+    if (op == CompareNode::TEXT) {
+        // Full-text search can only be done through the full-text index of a column
+        if (!prop || prop->links_exist() || !right->has_constant_evaluation() || left_type != type_String ||
+            right_type != type_String) {
+            throw InvalidQueryError("The 'text' operator requires a string property and a constant string");
+        }
+        auto col_key = prop->column_key();
+        if (!drv->m_base_table->has_fulltext_index(col_key)) {
+            throw InvalidQueryError(util::format("Column '%1' has no full-text index",
+                                                 drv->m_base_table->get_column_name(col_key)));
+        }
+        return drv->m_base_table->where().fulltext(col_key, right->get_mixed().get_string());
+    }
+
     if (prop && !prop->links_exist() && right->has_constant_evaluation() &&
         (left_type == right_type || left_type == type_Mixed)) {
         auto col_key = prop->column_key();
@@ -683,15 +701,16 @@ Query TrueOrFalseNode::visit(ParserDriver* drv)
 
 std::unique_ptr<Subexpr> PropNode::visit(ParserDriver* drv)
 {
+    // The node may be visited more than once, so it must be left unchanged
+    std::string identifier = this->identifier;
+    size_t path_size = path->path_elems.size();
     bool is_keys = false;
     if (identifier[0] == '@') {
         if (identifier == "@values") {
-            identifier = path->path_elems.back();
-            path->path_elems.pop_back();
+            identifier = path->path_elems[--path_size];
         }
         else if (identifier == "@keys") {
-            identifier = path->path_elems.back();
-            path->path_elems.pop_back();
+            identifier = path->path_elems[--path_size];
             is_keys = true;
         }
         else if (identifier == "@links") {
@@ -702,7 +721,7 @@ std::unique_ptr<Subexpr> PropNode::visit(ParserDriver* drv)
         }
     }
     try {
-        auto link_chain = path->visit(drv, comp_type);
+        auto link_chain = path->visit(drv, comp_type, path_size);
         std::unique_ptr<Subexpr> subexpr{drv->column(link_chain, identifier)};
         if (index) {
             if (auto s = dynamic_cast<Columns<Dictionary>*>(subexpr.get())) {
@@ -725,12 +744,11 @@ std::unique_ptr<Subexpr> PropNode::visit(ParserDriver* drv)
     }
     catch (const std::runtime_error& e) {
         // Is 'identifier' perhaps length operator?
-        if (!post_op && is_length_suffix(identifier) && path->path_elems.size() > 0) {
+        if (!post_op && is_length_suffix(identifier) && path_size > 0) {
             // If 'length' is the operator, the last id in the path must be the name
             // of a list property
-            auto prop = path->path_elems.back();
-            path->path_elems.pop_back();
-            std::unique_ptr<Subexpr> subexpr{path->visit(drv, comp_type).column(prop)};
+            auto prop = path->path_elems[path_size - 1];
+            std::unique_ptr<Subexpr> subexpr{path->visit(drv, comp_type, path_size - 1).column(prop)};
             if (auto list = dynamic_cast<ColumnListBase*>(subexpr.get())) {
                 if (auto length_expr = list->get_element_length())
                     return length_expr;
@@ -750,23 +768,23 @@ std::unique_ptr<Subexpr> SubqueryNode::visit(ParserDriver* drv)
                                        variable_name));
     }
     LinkChain lc = prop->path->visit(drv, prop->comp_type);
-    prop->identifier = drv->translate(lc, prop->identifier);
+    std::string identifier = drv->translate(lc, prop->identifier);
 
-    if (prop->identifier.find("@links") == 0) {
-        drv->backlink(lc, prop->identifier);
+    if (identifier.find("@links") == 0) {
+        drv->backlink(lc, identifier);
     }
     else {
-        ColKey col_key = lc.get_current_table()->get_column_key(prop->identifier);
+        ColKey col_key = lc.get_current_table()->get_column_key(identifier);
         if (col_key.is_list() && col_key.get_type() != col_type_LinkList) {
             throw InvalidQueryError(util::format(
-                "A subquery can not operate on a list of primitive values (property '%1')", prop->identifier));
+                "A subquery can not operate on a list of primitive values (property '%1')", identifier));
         }
         if (col_key.get_type() != col_type_LinkList) {
             throw InvalidQueryError(util::format("A subquery must operate on a list property, but '%1' is type '%2'",
-                                                 prop->identifier,
+                                                 identifier,
                                                  realm::get_data_type_name(DataType(col_key.get_type()))));
         }
-        lc.link(prop->identifier);
+        lc.link(identifier);
     }
     TableRef previous_table = drv->m_base_table;
     drv->m_base_table = lc.get_current_table().cast_away_const();
@@ -831,8 +849,7 @@ std::unique_ptr<Subexpr> LinkAggrNode::visit(ParserDriver* drv)
         throw InvalidQueryError(util::format("Operation '%1' cannot apply to property '%2' because it is not a list",
                                              agg_op_type_to_str(aggr_op->type), link));
     }
-    prop = drv->translate(link_chain, prop);
-    auto col_key = link_chain.get_current_table()->get_column_key(prop);
+    auto col_key = link_chain.get_current_table()->get_column_key(drv->translate(link_chain, prop));
 
     std::unique_ptr<Subexpr> sub_column;
     switch (col_key.get_type()) {
@@ -1208,11 +1225,12 @@ std::unique_ptr<Subexpr> ConstantNode::visit(ParserDriver* drv, DataType hint)
     return ret;
 }
 
-LinkChain PathNode::visit(ParserDriver* drv, ExpressionComparisonType comp_type)
+LinkChain PathNode::visit(ParserDriver* drv, ExpressionComparisonType comp_type, size_t num_elems)
 {
     LinkChain link_chain(drv->m_base_table, comp_type);
-    for (std::string path_elem : path_elems) {
-        path_elem = drv->translate(link_chain, path_elem);
+    num_elems = std::min(num_elems, path_elems.size());
+    for (size_t i = 0; i < num_elems; ++i) {
+        std::string path_elem = drv->translate(link_chain, path_elems[i]);
         if (path_elem.find("@links.") == 0) {
             drv->backlink(link_chain, path_elem);
         }
@@ -1297,6 +1315,68 @@ std::unique_ptr<DescriptorOrdering> DescriptorOrderingNode::visit(ParserDriver*
     return ordering;
 }
 
+GroupByNode::~GroupByNode() {}
+
+ColKey GroupByNode::column(ParserDriver* drv, const std::vector<std::string>& path, const std::string& id)
+{
+    if (!path.empty()) {
+        std::string key_path;
+        for (auto& elem : path)
+            key_path += elem + ".";
+        throw InvalidQueryError(
+            util::format("Key path '%1' is not supported in 'group by' clause, only properties of the object are",
+                         key_path + id));
+    }
+    LinkChain link_chain(drv->m_base_table);
+    ColKey col_key = drv->m_base_table->get_column_key(drv->translate(link_chain, id));
+    if (!col_key) {
+        throw InvalidQueryError(
+            util::format("No property '%1' found on object type '%2' specified in 'group by' clause", id,
+                         drv->get_printable_name(drv->m_base_table->get_name())));
+    }
+    return col_key;
+}
+
+std::vector<std::pair<Mixed, Mixed>> GroupByNode::visit(ParserDriver* drv, const Query& query)
+{
+    ColKey group_col = column(drv, group_path, group_id);
+    if (group_col.is_collection()) {
+        throw InvalidQueryError(util::format("Cannot group by the collection '%1'", group_id));
+    }
+    if (group_col.get_type() == col_type_BackLink || group_col.get_type() == col_type_TypedLink) {
+        throw InvalidQueryError(util::format("Cannot group by the property '%1'", group_id));
+    }
+    if (!aggr) {
+        return query.group_by(group_col).aggregate(act_Count);
+    }
+
+    ColKey value_col = column(drv, value_path, value_id);
+    Action action = act_Count;
+    switch (aggr->type) {
+        case AggrNode::MAX:
+            action = act_Max;
+            break;
+        case AggrNode::MIN:
+            action = act_Min;
+            break;
+        case AggrNode::SUM:
+            action = act_Sum;
+            break;
+        case AggrNode::AVG:
+            action = act_Average;
+            break;
+    }
+    if (value_col.is_collection()) {
+        throw InvalidQueryError(util::format("Cannot aggregate the collection '%1' per group", value_id));
+    }
+    auto type = value_col.get_type();
+    if ((action == act_Sum || action == act_Average) && type != col_type_Int && type != col_type_Float &&
+        type != col_type_Double && type != col_type_Decimal && type != col_type_Mixed) {
+        throw InvalidQueryError(util::format("Cannot sum or average the non-numeric property '%1'", value_id));
+    }
+    return query.group_by(group_col).aggregate(action, value_col);
+}
+
 // If one of the expresions is constant, it should be right
 static void verify_conditions(Subexpr* left, Subexpr* right, util::serializer::SerialisationState& state)
 {
@@ -1327,12 +1407,12 @@ ParserDriver::ParserDriver(TableRef t, Arguments& args, const query_parser::KeyP
     , m_args(args)
     , m_mapping(mapping)
 {
-    yylex_init(&m_yyscanner);
 }
 
 ParserDriver::~ParserDriver()
 {
-    yylex_destroy(m_yyscanner);
+    if (m_yyscanner)
+        yylex_destroy(m_yyscanner);
 }
 
 
@@ -1420,6 +1500,9 @@ int ParserDriver::parse(const std::string& str)
     // std::cout << str << std::endl;
     parse_buffer.append(str);
     parse_buffer.append("\0\0", 2); // Flex requires 2 terminating zeroes
+    // The scanner is only needed by drivers that parse, not by those lowering a prepared query
+    if (!m_yyscanner)
+        yylex_init(&m_yyscanner);
     scan_begin(m_yyscanner, trace_scanning);
     yy::parser parse(*this, m_yyscanner);
     parse.set_debug_level(trace_parsing);
@@ -1437,6 +1520,80 @@ void parse(const std::string& str)
     driver.parse(str);
 }
 
+const std::string& PreparedQuery::get_query_string() const noexcept
+{
+    return m_parsed->query_string;
+}
+
+namespace {
+
+// The most recently prepared queries by query string, each with the time of its last use
+struct PreparedQueryCache {
+    std::mutex mutex;
+    size_t max_size = 256;
+    uint64_t clock = 0;
+    std::unordered_map<std::string, std::pair<PreparedQuery, uint64_t>> entries;
+
+    void shrink_to(size_t size)
+    {
+        while (entries.size() > size) {
+            auto oldest = std::min_element(entries.begin(), entries.end(), [](auto& a, auto& b) {
+                return a.second.second < b.second.second;
+            });
+            entries.erase(oldest);
+        }
+    }
+};
+
+PreparedQueryCache& get_prepared_query_cache()
+{
+    static PreparedQueryCache cache;
+    return cache;
+}
+
+} // anonymous namespace
+
+PreparedQuery prepare(const std::string& query_string)
+{
+    auto& cache = get_prepared_query_cache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.entries.find(query_string);
+        if (it != cache.entries.end()) {
+            it->second.second = ++cache.clock;
+            return it->second.first;
+        }
+    }
+
+    auto parsed = std::make_shared<ParsedQuery>();
+    {
+        ParserDriver driver;
+        driver.parse(query_string); // Throws
+        driver.result->canonicalize();
+        parsed->query_string = query_string;
+        parsed->result = driver.result;
+        parsed->ordering = driver.ordering;
+        parsed->group_by = driver.group_by;
+        parsed->nodes = std::move(driver.m_parse_nodes);
+    }
+    PreparedQuery prepared(std::move(parsed));
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.max_size > 0) {
+        cache.shrink_to(cache.max_size - 1);
+        cache.entries.insert_or_assign(query_string, std::make_pair(prepared, ++cache.clock));
+    }
+    return prepared;
+}
+
+void set_prepared_query_cache_size(size_t size)
+{
+    auto& cache = get_prepared_query_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.max_size = size;
+    cache.shrink_to(size);
+}
+
 std::string check_escapes(const char* str)
 {
     std::string ret;
@@ -1480,10 +1637,56 @@ Query Table::query(const std::string& query_string, const std::vector<Mixed>& ar
 Query Table::query(const std::string& query_string, query_parser::Arguments& args,
                    const query_parser::KeyPathMapping& mapping) const
 {
+    return query(query_parser::prepare(query_string), args, mapping);
+}
+
+Query Table::query(const query_parser::PreparedQuery& query, const std::vector<Mixed>& arguments) const
+{
+    MixedArguments args(arguments);
+    return this->query(query, args, {});
+}
+
+Query Table::query(const query_parser::PreparedQuery& query, const std::vector<Mixed>& arguments,
+                   const query_parser::KeyPathMapping& mapping) const
+{
+    MixedArguments args(arguments);
+    return this->query(query, args, mapping);
+}
+
+Query Table::query(const query_parser::PreparedQuery& query, query_parser::Arguments& args,
+                   const query_parser::KeyPathMapping& mapping) const
+{
+    REALM_ASSERT(query);
+    // Lowering leaves the parsed nodes unchanged, so they may be shared by several drivers
+    const query_parser::ParsedQuery& parsed = *query.m_parsed;
+    if (parsed.group_by) {
+        throw query_parser::InvalidQueryError("A query with 'group by' must be run with aggregate_groups()");
+    }
+    ParserDriver driver(m_own_ref, args, mapping);
+    return parsed.result->visit(&driver).set_ordering(parsed.ordering->visit(&driver));
+}
+
+std::vector<std::pair<Mixed, Mixed>> Table::aggregate_groups(const std::string& query_string,
+                                                             const std::vector<Mixed>& arguments) const
+{
+    return aggregate_groups(query_string, arguments, {});
+}
+
+std::vector<std::pair<Mixed, Mixed>> Table::aggregate_groups(const std::string& query_string,
+                                                             const std::vector<Mixed>& arguments,
+                                                             const query_parser::KeyPathMapping& mapping) const
+{
+    auto prepared = query_parser::prepare(query_string);
+    const query_parser::ParsedQuery& parsed = *prepared.m_parsed;
+    if (!parsed.group_by) {
+        throw query_parser::InvalidQueryError("Expected a 'group by' clause");
+    }
+    if (!parsed.ordering->orderings.empty()) {
+        throw query_parser::InvalidQueryError("A query with 'group by' cannot be sorted, distinct or limited");
+    }
+    MixedArguments args(arguments);
     ParserDriver driver(m_own_ref, args, mapping);
-    driver.parse(query_string);
-    driver.result->canonicalize();
-    return driver.result->visit(&driver).set_ordering(driver.ordering->visit(&driver));
+    return parsed.group_by->visit(&driver, parsed.result->visit(&driver));
 }
 
 std::unique_ptr<Subexpr> LinkChain::column(const std::string& col)
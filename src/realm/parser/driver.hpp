@@ -110,6 +110,7 @@ public:
     static constexpr int CONTAINS = 8;
     static constexpr int LIKE = 9;
     static constexpr int IN = 10;
+    static constexpr int TEXT = 11;
 };
 
 class ConstantNode : public ParserNode {
@@ -319,7 +320,9 @@ class PathNode : public ParserNode {
 public:
     std::vector<std::string> path_elems;
 
-    LinkChain visit(ParserDriver*, ExpressionComparisonType = ExpressionComparisonType::Any);
+    // Follows the first \a num_elems elements of the path, or all of them
+    LinkChain visit(ParserDriver*, ExpressionComparisonType = ExpressionComparisonType::Any,
+                    size_t num_elems = realm::npos);
     void add_element(const std::string& str)
     {
         path_elems.push_back(str);
@@ -452,6 +455,36 @@ public:
     std::unique_ptr<DescriptorOrdering> visit(ParserDriver* drv);
 };
 
+// The 'GROUP BY(prop, aggregate)' clause, see Table::aggregate_groups()
+class GroupByNode : public ParserNode {
+public:
+    std::vector<std::string> group_path;
+    std::string group_id;
+    AggrNode* aggr = nullptr; // nullptr for '@count'
+    std::vector<std::string> value_path;
+    std::string value_id;
+
+    GroupByNode(PathNode* path, const std::string& id)
+        : group_path(path->path_elems)
+        , group_id(id)
+    {
+    }
+    GroupByNode(PathNode* path, const std::string& id, AggrNode* aggr_node, PathNode* value_path_node,
+                const std::string& value)
+        : group_path(path->path_elems)
+        , group_id(id)
+        , aggr(aggr_node)
+        , value_path(value_path_node->path_elems)
+        , value_id(value)
+    {
+    }
+    ~GroupByNode() override;
+    std::vector<std::pair<Mixed, Mixed>> visit(ParserDriver* drv, const Query& query);
+
+private:
+    ColKey column(ParserDriver* drv, const std::vector<std::string>& path, const std::string& id);
+};
+
 // Conducting the whole scanning and parsing of Calc++.
 class ParserDriver {
 public:
@@ -482,11 +515,12 @@ public:
     util::serializer::SerialisationState m_serializer_state;
     QueryNode* result = nullptr;
     DescriptorOrderingNode* ordering = nullptr;
+    GroupByNode* group_by = nullptr;
     TableRef m_base_table;
     Arguments& m_args;
     query_parser::KeyPathMapping m_mapping;
     ParserNodeStore m_parse_nodes;
-    void* m_yyscanner;
+    void* m_yyscanner = nullptr;
 
     // Run the parser on file F.  Return 0 on success.
     int parse(const std::string& str);
@@ -522,6 +556,16 @@ private:
     static query_parser::KeyPathMapping s_default_mapping;
 };
 
+// The nodes produced by parsing a query string, see PreparedQuery. Visiting
+// them must not change them, as they may be visited by several drivers.
+struct ParsedQuery {
+    std::string query_string;
+    ParserDriver::ParserNodeStore nodes;
+    QueryNode* result = nullptr;
+    DescriptorOrderingNode* ordering = nullptr;
+    GroupByNode* group_by = nullptr;
+};
+
 template <class T>
 Query ParserDriver::simple_query(int op, ColKey col_key, T val, bool case_sensitive)
 {
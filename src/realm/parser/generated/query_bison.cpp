@@ -218,6 +218,11 @@ namespace yy {
         value.YY_MOVE_OR_COPY< ExpressionNode* > (YY_MOVE (that.value));
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+        value.YY_MOVE_OR_COPY< GroupByNode* > (YY_MOVE (that.value));
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.YY_MOVE_OR_COPY< ListNode* > (YY_MOVE (that.value));
@@ -337,6 +342,11 @@ namespace yy {
         value.move< ExpressionNode* > (YY_MOVE (that.value));
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+        value.move< GroupByNode* > (YY_MOVE (that.value));
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.move< ListNode* > (YY_MOVE (that.value));
@@ -456,6 +466,11 @@ namespace yy {
         value.copy< ExpressionNode* > (that.value);
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+        value.copy< GroupByNode* > (that.value);
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.copy< ListNode* > (that.value);
@@ -573,6 +588,11 @@ namespace yy {
         value.move< ExpressionNode* > (that.value);
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+        value.move< GroupByNode* > (that.value);
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.move< ListNode* > (that.value);
@@ -1003,6 +1023,14 @@ namespace yy {
                  { yyo << yysym.value.template as < DescriptorNode* > (); }
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+                 { yyo << yysym.value.template as < GroupByNode* > (); }
+        break;
+
+      case symbol_kind::SYM_group_by_param: // group_by_param
+                 { yyo << yysym.value.template as < GroupByNode* > (); }
+        break;
+
       case symbol_kind::SYM_direction: // direction
                  { yyo << yysym.value.template as < bool > (); }
         break;
@@ -1307,6 +1335,11 @@ namespace yy {
         yylhs.value.emplace< ExpressionNode* > ();
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+        yylhs.value.emplace< GroupByNode* > ();
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         yylhs.value.emplace< ListNode* > ();
@@ -1401,8 +1434,8 @@ namespace yy {
         {
           switch (yyn)
             {
-  case 2: // final: query post_query
-                       { drv.result = yystack_[1].value.as < QueryNode* > (); drv.ordering = yystack_[0].value.as < DescriptorOrderingNode* > (); }
+  case 2: // final: query post_query group_by
+                                { drv.result = yystack_[2].value.as < QueryNode* > (); drv.ordering = yystack_[1].value.as < DescriptorOrderingNode* > (); drv.group_by = yystack_[0].value.as < GroupByNode* > (); }
     break;
 
   case 3: // query: compare
@@ -1461,351 +1494,391 @@ namespace yy {
                                 { yylhs.value.as < QueryNode* > () = drv.m_parse_nodes.create<BetweenNode>(yystack_[2].value.as < ValueNode* > (), yystack_[0].value.as < ListNode* > ()); }
     break;
 
-  case 15: // expr: value
+  case 15: // compare: value "identifier" value
+                                {
+                                    // The full-text operator 'TEXT' is scanned as an identifier
+                                    if (yystack_[1].value.as < std::string > () != "TEXT" && yystack_[1].value.as < std::string > () != "text") {
+                                        error("syntax error, unexpected identifier '" + yystack_[1].value.as < std::string > () + "'");
+                                        YYABORT;
+                                    }
+                                    yylhs.value.as < QueryNode* > () = drv.m_parse_nodes.create<StringOpsNode>(yystack_[2].value.as < ValueNode* > (), CompareNode::TEXT, yystack_[0].value.as < ValueNode* > ());
+                                }
+    break;
+
+  case 16: // expr: value
                                 { yylhs.value.as < ExpressionNode* > () = yystack_[0].value.as < ValueNode* > (); }
     break;
 
-  case 16: // expr: '(' expr ')'
+  case 17: // expr: '(' expr ')'
                                 { yylhs.value.as < ExpressionNode* > () = yystack_[1].value.as < ExpressionNode* > (); }
     break;
 
-  case 17: // expr: expr '*' expr
+  case 18: // expr: expr '*' expr
                                 { yylhs.value.as < ExpressionNode* > () = drv.m_parse_nodes.create<OperationNode>(yystack_[2].value.as < ExpressionNode* > (), '*', yystack_[0].value.as < ExpressionNode* > ()); }
     break;
 
-  case 18: // expr: expr '/' expr
+  case 19: // expr: expr '/' expr
                                 { yylhs.value.as < ExpressionNode* > () = drv.m_parse_nodes.create<OperationNode>(yystack_[2].value.as < ExpressionNode* > (), '/', yystack_[0].value.as < ExpressionNode* > ()); }
     break;
 
-  case 19: // expr: expr '+' expr
+  case 20: // expr: expr '+' expr
                                 { yylhs.value.as < ExpressionNode* > () = drv.m_parse_nodes.create<OperationNode>(yystack_[2].value.as < ExpressionNode* > (), '+', yystack_[0].value.as < ExpressionNode* > ()); }
     break;
 
-  case 20: // expr: expr '-' expr
+  case 21: // expr: expr '-' expr
                                 { yylhs.value.as < ExpressionNode* > () = drv.m_parse_nodes.create<OperationNode>(yystack_[2].value.as < ExpressionNode* > (), '-', yystack_[0].value.as < ExpressionNode* > ()); }
     break;
 
-  case 21: // value: constant
+  case 22: // value: constant
                                 { yylhs.value.as < ValueNode* > () = drv.m_parse_nodes.create<ValueNode>(yystack_[0].value.as < ConstantNode* > ());}
     break;
 
-  case 22: // value: prop
+  case 23: // value: prop
                                 { yylhs.value.as < ValueNode* > () = drv.m_parse_nodes.create<ValueNode>(yystack_[0].value.as < PropertyNode* > ());}
     break;
 
-  case 23: // prop: path id post_op
+  case 24: // prop: path id post_op
                                 { yylhs.value.as < PropertyNode* > () = drv.m_parse_nodes.create<PropNode>(yystack_[2].value.as < PathNode* > (), yystack_[1].value.as < std::string > (), yystack_[0].value.as < PostOpNode* > ()); }
     break;
 
-  case 24: // prop: path id '[' constant ']' post_op
+  case 25: // prop: path id '[' constant ']' post_op
                                        { yylhs.value.as < PropertyNode* > () = drv.m_parse_nodes.create<PropNode>(yystack_[5].value.as < PathNode* > (), yystack_[4].value.as < std::string > (), yystack_[2].value.as < ConstantNode* > (), yystack_[0].value.as < PostOpNode* > ()); }
     break;
 
-  case 25: // prop: comp_type path id post_op
+  case 26: // prop: comp_type path id post_op
                                 { yylhs.value.as < PropertyNode* > () = drv.m_parse_nodes.create<PropNode>(yystack_[2].value.as < PathNode* > (), yystack_[1].value.as < std::string > (), yystack_[0].value.as < PostOpNode* > (), ExpressionComparisonType(yystack_[3].value.as < int > ())); }
     break;
 
-  case 26: // prop: path "@links" post_op
+  case 27: // prop: path "@links" post_op
                                 { yylhs.value.as < PropertyNode* > () = drv.m_parse_nodes.create<PropNode>(yystack_[2].value.as < PathNode* > (), "@links", yystack_[0].value.as < PostOpNode* > ()); }
     break;
 
-  case 27: // prop: path id '.' aggr_op '.' id
+  case 28: // prop: path id '.' aggr_op '.' id
                                     { yylhs.value.as < PropertyNode* > () = drv.m_parse_nodes.create<LinkAggrNode>(yystack_[5].value.as < PathNode* > (), yystack_[4].value.as < std::string > (), yystack_[2].value.as < AggrNode* > (), yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 28: // prop: path id '.' aggr_op
+  case 29: // prop: path id '.' aggr_op
                                 { yylhs.value.as < PropertyNode* > () = drv.m_parse_nodes.create<ListAggrNode>(yystack_[3].value.as < PathNode* > (), yystack_[2].value.as < std::string > (), yystack_[0].value.as < AggrNode* > ()); }
     break;
 
-  case 29: // prop: subquery
+  case 30: // prop: subquery
                                 { yylhs.value.as < PropertyNode* > () = yystack_[0].value.as < SubqueryNode* > (); }
     break;
 
-  case 30: // simple_prop: path id
+  case 31: // simple_prop: path id
                                 { yylhs.value.as < PropNode* > () = drv.m_parse_nodes.create<PropNode>(yystack_[1].value.as < PathNode* > (), yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 31: // subquery: "subquery" '(' simple_prop ',' id ',' query ')' '.' "@size"
+  case 32: // subquery: "subquery" '(' simple_prop ',' id ',' query ')' '.' "@size"
                                                                { yylhs.value.as < SubqueryNode* > () = drv.m_parse_nodes.create<SubqueryNode>(yystack_[7].value.as < PropNode* > (), yystack_[5].value.as < std::string > (), yystack_[3].value.as < QueryNode* > ()); }
     break;
 
-  case 32: // post_query: %empty
+  case 33: // post_query: %empty
                                 { yylhs.value.as < DescriptorOrderingNode* > () = drv.m_parse_nodes.create<DescriptorOrderingNode>();}
     break;
 
-  case 33: // post_query: post_query sort
+  case 34: // post_query: post_query sort
                                 { yystack_[1].value.as < DescriptorOrderingNode* > ()->add_descriptor(yystack_[0].value.as < DescriptorNode* > ()); yylhs.value.as < DescriptorOrderingNode* > () = yystack_[1].value.as < DescriptorOrderingNode* > (); }
     break;
 
-  case 34: // post_query: post_query distinct
+  case 35: // post_query: post_query distinct
                                 { yystack_[1].value.as < DescriptorOrderingNode* > ()->add_descriptor(yystack_[0].value.as < DescriptorNode* > ()); yylhs.value.as < DescriptorOrderingNode* > () = yystack_[1].value.as < DescriptorOrderingNode* > (); }
     break;
 
-  case 35: // post_query: post_query limit
+  case 36: // post_query: post_query limit
                                 { yystack_[1].value.as < DescriptorOrderingNode* > ()->add_descriptor(yystack_[0].value.as < DescriptorNode* > ()); yylhs.value.as < DescriptorOrderingNode* > () = yystack_[1].value.as < DescriptorOrderingNode* > (); }
     break;
 
-  case 36: // distinct: "distinct" '(' distinct_param ')'
+  case 37: // distinct: "distinct" '(' distinct_param ')'
                                           { yylhs.value.as < DescriptorNode* > () = yystack_[1].value.as < DescriptorNode* > (); }
     break;
 
-  case 37: // distinct_param: path id
+  case 38: // distinct_param: path id
                                 { yylhs.value.as < DescriptorNode* > () = drv.m_parse_nodes.create<DescriptorNode>(DescriptorNode::DISTINCT); yylhs.value.as < DescriptorNode* > ()->add(yystack_[1].value.as < PathNode* > ()->path_elems, yystack_[0].value.as < std::string > ());}
     break;
 
-  case 38: // distinct_param: distinct_param ',' path id
+  case 39: // distinct_param: distinct_param ',' path id
                                  { yystack_[3].value.as < DescriptorNode* > ()->add(yystack_[1].value.as < PathNode* > ()->path_elems, yystack_[0].value.as < std::string > ()); yylhs.value.as < DescriptorNode* > () = yystack_[3].value.as < DescriptorNode* > (); }
     break;
 
-  case 39: // sort: "sort" '(' sort_param ')'
+  case 40: // sort: "sort" '(' sort_param ')'
                                  { yylhs.value.as < DescriptorNode* > () = yystack_[1].value.as < DescriptorNode* > (); }
     break;
 
-  case 40: // sort_param: path id direction
+  case 41: // sort_param: path id direction
                                 { yylhs.value.as < DescriptorNode* > () = drv.m_parse_nodes.create<DescriptorNode>(DescriptorNode::SORT); yylhs.value.as < DescriptorNode* > ()->add(yystack_[2].value.as < PathNode* > ()->path_elems, yystack_[1].value.as < std::string > (), yystack_[0].value.as < bool > ());}
     break;
 
-  case 41: // sort_param: sort_param ',' path id direction
+  case 42: // sort_param: sort_param ',' path id direction
                                         { yystack_[4].value.as < DescriptorNode* > ()->add(yystack_[2].value.as < PathNode* > ()->path_elems, yystack_[1].value.as < std::string > (), yystack_[0].value.as < bool > ()); yylhs.value.as < DescriptorNode* > () = yystack_[4].value.as < DescriptorNode* > (); }
     break;
 
-  case 42: // limit: "limit" '(' "natural0" ')'
+  case 43: // limit: "limit" '(' "natural0" ')'
                                 { yylhs.value.as < DescriptorNode* > () = drv.m_parse_nodes.create<DescriptorNode>(DescriptorNode::LIMIT, yystack_[1].value.as < std::string > ()); }
     break;
 
-  case 43: // direction: "ascending"
+  case 44: // group_by: %empty
+                                { yylhs.value.as < GroupByNode* > () = nullptr; }
+    break;
+
+  case 45: // group_by: "identifier" "identifier" '(' group_by_param ')'
+                                   {
+                                    // 'GROUP BY' is scanned as two identifiers
+                                    if ((yystack_[4].value.as < std::string > () != "GROUP" && yystack_[4].value.as < std::string > () != "group") || (yystack_[3].value.as < std::string > () != "BY" && yystack_[3].value.as < std::string > () != "by")) {
+                                        error("syntax error, unexpected identifier '" + yystack_[4].value.as < std::string > () + "'");
+                                        YYABORT;
+                                    }
+                                    yylhs.value.as < GroupByNode* > () = yystack_[1].value.as < GroupByNode* > ();
+                                }
+    break;
+
+  case 46: // group_by_param: path id ',' "@size"
+                                {
+                                    if (yystack_[0].value.as < std::string > () != "@count") {
+                                        error("syntax error, unexpected '" + yystack_[0].value.as < std::string > () + "', expecting '@count'");
+                                        YYABORT;
+                                    }
+                                    yylhs.value.as < GroupByNode* > () = drv.m_parse_nodes.create<GroupByNode>(yystack_[3].value.as < PathNode* > (), yystack_[2].value.as < std::string > ());
+                                }
+    break;
+
+  case 47: // group_by_param: path id ',' aggr_op '(' path id ')'
+                                          { yylhs.value.as < GroupByNode* > () = drv.m_parse_nodes.create<GroupByNode>(yystack_[7].value.as < PathNode* > (), yystack_[6].value.as < std::string > (), yystack_[4].value.as < AggrNode* > (), yystack_[2].value.as < PathNode* > (), yystack_[1].value.as < std::string > ()); }
+    break;
+
+  case 48: // direction: "ascending"
                                 { yylhs.value.as < bool > () = true; }
     break;
 
-  case 44: // direction: "descending"
+  case 49: // direction: "descending"
                                 { yylhs.value.as < bool > () = false; }
     break;
 
-  case 45: // list: '{' list_content '}'
+  case 50: // list: '{' list_content '}'
                                 { yylhs.value.as < ListNode* > () = yystack_[1].value.as < ListNode* > (); }
     break;
 
-  case 46: // list_content: constant
+  case 51: // list_content: constant
                                 { yylhs.value.as < ListNode* > () = drv.m_parse_nodes.create<ListNode>(yystack_[0].value.as < ConstantNode* > ()); }
     break;
 
-  case 47: // list_content: list_content ',' constant
+  case 52: // list_content: list_content ',' constant
                                 { yystack_[2].value.as < ListNode* > ()->add_element(yystack_[0].value.as < ConstantNode* > ()); yylhs.value.as < ListNode* > () = yystack_[2].value.as < ListNode* > (); }
     break;
 
-  case 48: // constant: "natural0"
+  case 53: // constant: "natural0"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::NUMBER, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 49: // constant: "number"
+  case 54: // constant: "number"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::NUMBER, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 50: // constant: "infinity"
+  case 55: // constant: "infinity"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::INFINITY_VAL, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 51: // constant: "NaN"
+  case 56: // constant: "NaN"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::NAN_VAL, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 52: // constant: "string"
+  case 57: // constant: "string"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::STRING, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 53: // constant: "base64"
+  case 58: // constant: "base64"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::BASE64, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 54: // constant: "float"
+  case 59: // constant: "float"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::FLOAT, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 55: // constant: "date"
+  case 60: // constant: "date"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::TIMESTAMP, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 56: // constant: "UUID"
+  case 61: // constant: "UUID"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::UUID_T, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 57: // constant: "ObjectId"
+  case 62: // constant: "ObjectId"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::OID, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 58: // constant: "link"
+  case 63: // constant: "link"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::LINK, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 59: // constant: "typed link"
+  case 64: // constant: "typed link"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::TYPED_LINK, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 60: // constant: "true"
+  case 65: // constant: "true"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::TRUE, ""); }
     break;
 
-  case 61: // constant: "false"
+  case 66: // constant: "false"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::FALSE, ""); }
     break;
 
-  case 62: // constant: "null"
+  case 67: // constant: "null"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::NULL_VAL, ""); }
     break;
 
-  case 63: // constant: "argument"
+  case 68: // constant: "argument"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::ARG, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 64: // boolexpr: "truepredicate"
+  case 69: // boolexpr: "truepredicate"
                                 { yylhs.value.as < TrueOrFalseNode* > () = drv.m_parse_nodes.create<TrueOrFalseNode>(true); }
     break;
 
-  case 65: // boolexpr: "falsepredicate"
+  case 70: // boolexpr: "falsepredicate"
                                 { yylhs.value.as < TrueOrFalseNode* > () = drv.m_parse_nodes.create<TrueOrFalseNode>(false); }
     break;
 
-  case 66: // comp_type: "any"
+  case 71: // comp_type: "any"
                                 { yylhs.value.as < int > () = int(ExpressionComparisonType::Any); }
     break;
 
-  case 67: // comp_type: "all"
+  case 72: // comp_type: "all"
                                 { yylhs.value.as < int > () = int(ExpressionComparisonType::All); }
     break;
 
-  case 68: // comp_type: "none"
+  case 73: // comp_type: "none"
                                 { yylhs.value.as < int > () = int(ExpressionComparisonType::None); }
     break;
 
-  case 69: // post_op: %empty
+  case 74: // post_op: %empty
                                 { yylhs.value.as < PostOpNode* > () = nullptr; }
     break;
 
-  case 70: // post_op: '.' "@size"
+  case 75: // post_op: '.' "@size"
                                 { yylhs.value.as < PostOpNode* > () = drv.m_parse_nodes.create<PostOpNode>(yystack_[0].value.as < std::string > (), PostOpNode::SIZE);}
     break;
 
-  case 71: // post_op: '.' "@type"
+  case 76: // post_op: '.' "@type"
                                 { yylhs.value.as < PostOpNode* > () = drv.m_parse_nodes.create<PostOpNode>(yystack_[0].value.as < std::string > (), PostOpNode::TYPE);}
     break;
 
-  case 72: // aggr_op: "@max"
+  case 77: // aggr_op: "@max"
                                 { yylhs.value.as < AggrNode* > () = drv.m_parse_nodes.create<AggrNode>(AggrNode::MAX);}
     break;
 
-  case 73: // aggr_op: "@min"
+  case 78: // aggr_op: "@min"
                                 { yylhs.value.as < AggrNode* > () = drv.m_parse_nodes.create<AggrNode>(AggrNode::MIN);}
     break;
 
-  case 74: // aggr_op: "@sun"
+  case 79: // aggr_op: "@sun"
                                 { yylhs.value.as < AggrNode* > () = drv.m_parse_nodes.create<AggrNode>(AggrNode::SUM);}
     break;
 
-  case 75: // aggr_op: "@average"
+  case 80: // aggr_op: "@average"
                                 { yylhs.value.as < AggrNode* > () = drv.m_parse_nodes.create<AggrNode>(AggrNode::AVG);}
     break;
 
-  case 76: // equality: "=="
+  case 81: // equality: "=="
                                 { yylhs.value.as < int > () = CompareNode::EQUAL; }
     break;
 
-  case 77: // equality: "!="
+  case 82: // equality: "!="
                                 { yylhs.value.as < int > () = CompareNode::NOT_EQUAL; }
     break;
 
-  case 78: // equality: "in"
+  case 83: // equality: "in"
                                 { yylhs.value.as < int > () = CompareNode::IN; }
     break;
 
-  case 79: // relational: "<"
+  case 84: // relational: "<"
                                 { yylhs.value.as < int > () = CompareNode::LESS; }
     break;
 
-  case 80: // relational: "<="
+  case 85: // relational: "<="
                                 { yylhs.value.as < int > () = CompareNode::LESS_EQUAL; }
     break;
 
-  case 81: // relational: ">"
+  case 86: // relational: ">"
                                 { yylhs.value.as < int > () = CompareNode::GREATER; }
     break;
 
-  case 82: // relational: ">="
+  case 87: // relational: ">="
                                 { yylhs.value.as < int > () = CompareNode::GREATER_EQUAL; }
     break;
 
-  case 83: // stringop: "beginswith"
+  case 88: // stringop: "beginswith"
                                 { yylhs.value.as < int > () = CompareNode::BEGINSWITH; }
     break;
 
-  case 84: // stringop: "endswith"
+  case 89: // stringop: "endswith"
                                 { yylhs.value.as < int > () = CompareNode::ENDSWITH; }
     break;
 
-  case 85: // stringop: "contains"
+  case 90: // stringop: "contains"
                                 { yylhs.value.as < int > () = CompareNode::CONTAINS; }
     break;
 
-  case 86: // stringop: "like"
+  case 91: // stringop: "like"
                                 { yylhs.value.as < int > () = CompareNode::LIKE; }
     break;
 
-  case 87: // path: %empty
+  case 92: // path: %empty
                                 { yylhs.value.as < PathNode* > () = drv.m_parse_nodes.create<PathNode>(); }
     break;
 
-  case 88: // path: path path_elem
+  case 93: // path: path path_elem
                                 { yystack_[1].value.as < PathNode* > ()->add_element(yystack_[0].value.as < std::string > ()); yylhs.value.as < PathNode* > () = yystack_[1].value.as < PathNode* > (); }
     break;
 
-  case 89: // path_elem: id '.'
+  case 94: // path_elem: id '.'
                                 { yylhs.value.as < std::string > () = yystack_[1].value.as < std::string > (); }
     break;
 
-  case 90: // id: "identifier"
+  case 95: // id: "identifier"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 91: // id: "@links" '.' "identifier" '.' "identifier"
+  case 96: // id: "@links" '.' "identifier" '.' "identifier"
                                 { yylhs.value.as < std::string > () = std::string("@links.") + yystack_[2].value.as < std::string > () + "." + yystack_[0].value.as < std::string > (); }
     break;
 
-  case 92: // id: "beginswith"
+  case 97: // id: "beginswith"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 93: // id: "endswith"
+  case 98: // id: "endswith"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 94: // id: "contains"
+  case 99: // id: "contains"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 95: // id: "like"
+  case 100: // id: "like"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 96: // id: "between"
+  case 101: // id: "between"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 97: // id: "key or value"
+  case 102: // id: "key or value"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 98: // id: "sort"
+  case 103: // id: "sort"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 99: // id: "distinct"
+  case 104: // id: "distinct"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 100: // id: "limit"
+  case 105: // id: "limit"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 101: // id: "in"
+  case 106: // id: "in"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
@@ -2157,154 +2230,160 @@ namespace yy {
   }
 
 
-  const signed char parser::yypact_ninf_ = -94;
+  const signed char parser::yypact_ninf_ = -95;
 
   const signed char parser::yytable_ninf_ = -1;
 
   const short
   parser::yypact_[] =
   {
-     118,   -94,   -94,   -54,   -94,   -94,   -94,   -94,   -94,   -94,
-     118,   -94,   -94,   -94,   -94,   -94,   -94,   -94,   -94,   -94,
-     -94,   -94,   -94,   -94,   118,    23,   -10,   -94,    75,    49,
-     -94,   -94,   -94,   -94,   -94,   306,   -94,   -94,   -15,   203,
-     -94,   118,   118,     9,   -94,   -94,   -94,   -94,   -94,   -94,
-     -94,   190,   190,   190,   190,   154,   190,   -94,   -94,   -94,
-     -94,   -22,   235,   318,   -19,   -94,   -94,   -94,   -94,   -94,
-     -94,   -94,   -94,   -94,   -94,   -94,   -94,    -8,   -12,   318,
-     -94,   -94,   -94,    38,     6,    15,    17,   -94,   -94,   -94,
-     190,   -27,   -94,   -27,   -94,   -94,   190,    48,    48,   284,
-     -94,   271,   -94,     8,    19,    -4,   -94,   284,     4,   -94,
-     318,    34,   -94,   -94,    65,    12,    48,    -3,   -94,   -94,
-      71,    32,   -94,    44,   -94,   -94,    46,   -94,   -94,   -94,
-     -94,    47,    45,   -94,   -42,   318,   -13,   318,    51,   284,
-     -94,    83,    50,   318,   118,   -94,   -94,     3,   -94,   -94,
-      34,   -94,   -94,   -94,    32,   -94,   -94,    -6,   318,   -94,
-     -94,   -94,   318,    52,     3,    34,    64,   -94,   -94
+     125,   -95,   -95,   -40,   -95,   -95,   -95,   -95,   -95,   -95,
+     125,   -95,   -95,   -95,   -95,   -95,   -95,   -95,   -95,   -95,
+     -95,   -95,   -95,   -95,   125,    23,   -13,   -95,    83,   143,
+     -95,   -95,   -95,   -95,   -95,   304,   -95,   -95,    -5,    14,
+     -95,   125,   125,    51,   -95,   -95,   -95,   -95,   -95,   -95,
+     -95,   197,   197,   197,   197,   161,   197,   269,   -95,   -95,
+     -95,   -95,   -29,   233,   316,   -11,   -95,   -95,   -95,   -95,
+     -95,   -95,   -95,   -95,   -95,   -95,   -95,   -95,    46,     2,
+     316,   -95,   -95,   -95,    30,    44,    27,    52,    61,   -95,
+     -95,   -95,   -95,   197,   -14,   -95,   -14,   -95,   -95,   197,
+     118,   118,   -95,   282,   -95,   269,   -95,    47,    59,    24,
+     -95,   282,    15,   -95,   316,    62,    67,   -95,   -95,    93,
+      58,   118,    53,   -95,   -95,    49,    38,   -95,    73,   -95,
+     -95,    68,   -95,   -95,   -95,   -95,    74,    82,   -95,   -95,
+     -52,   316,   -49,   316,    87,   282,   -95,   119,    88,   316,
+     125,    92,   316,   -95,   -95,     1,   -95,   -95,    62,   -95,
+     -95,   -95,    38,   -95,   -95,     5,   -95,    40,   316,   -95,
+     -95,   -95,   316,    91,    36,     1,    62,   130,   -95,   124,
+     -95,   -95,   -95,   316,    19,   -95
   };
 
   const signed char
   parser::yydefact_[] =
   {
-      87,    64,    65,     0,    60,    61,    62,    66,    67,    68,
-      87,    52,    53,    50,    51,    48,    49,    54,    55,    56,
-      57,    58,    59,    63,    87,     0,    32,     3,     0,    15,
-      22,    29,    21,     8,    87,     0,    87,     6,     0,     0,
-       1,    87,    87,     2,    76,    77,    79,    81,    82,    80,
-      78,    87,    87,    87,    87,    87,    87,    83,    84,    85,
-      86,     0,    87,     0,    69,    90,    92,    93,    94,    95,
-      96,   101,    98,    99,   100,    97,    88,    69,     0,     0,
-       7,    16,     5,     4,     0,     0,     0,    34,    33,    35,
-      87,    19,    15,    20,    17,    18,    87,     9,    11,     0,
-      14,    87,    12,     0,    69,     0,    26,     0,    89,    23,
-       0,    30,    87,    87,     0,     0,    10,     0,    46,    13,
-       0,    89,    25,     0,    70,    71,     0,    72,    73,    74,
-      75,    28,     0,    89,     0,     0,     0,     0,     0,     0,
-      45,     0,    69,     0,    87,    39,    87,     0,    36,    87,
-      37,    42,    47,    91,     0,    24,    27,     0,     0,    43,
-      44,    40,     0,     0,     0,    38,     0,    41,    31
+      92,    69,    70,     0,    65,    66,    67,    71,    72,    73,
+      92,    57,    58,    55,    56,    53,    54,    59,    60,    61,
+      62,    63,    64,    68,    92,     0,    33,     3,     0,    16,
+      23,    30,    22,     8,    92,     0,    92,     6,     0,     0,
+       1,    92,    92,    44,    81,    82,    84,    86,    87,    85,
+      83,    92,    92,    92,    92,    92,    92,    92,    88,    89,
+      90,    91,     0,    92,     0,    74,    95,    97,    98,    99,
+     100,   101,   106,   103,   104,   105,   102,    93,    74,     0,
+       0,     7,    17,     5,     4,     0,     0,     0,     0,    35,
+      34,    36,     2,    92,    20,    16,    21,    18,    19,    92,
+       9,    11,    15,     0,    14,    92,    12,     0,    74,     0,
+      27,     0,    94,    24,     0,    31,     0,    92,    92,     0,
+       0,    10,     0,    51,    13,     0,    94,    26,     0,    75,
+      76,     0,    77,    78,    79,    80,    29,     0,    94,    92,
+       0,     0,     0,     0,     0,     0,    50,     0,    74,     0,
+      92,     0,     0,    40,    92,     0,    37,    92,    38,    43,
+      52,    96,     0,    25,    28,     0,    45,     0,     0,    48,
+      49,    41,     0,     0,     0,     0,    39,     0,    46,     0,
+      42,    32,    92,     0,     0,    47
   };
 
   const signed char
   parser::yypgoto_[] =
   {
-     -94,   -94,    -9,   -94,   -17,     0,   -94,   -94,   -94,   -94,
-     -94,   -94,   -94,   -94,   -94,   -46,   -94,   -94,   -93,   -94,
-     -94,   -64,   -94,   -94,   -94,   -94,   -32,   -94,   -60
+     -95,   -95,    -8,   -95,    -6,     0,   -95,   -95,   -95,   -95,
+     -95,   -95,   -95,   -95,   -95,   -95,   -95,    10,   -95,   -95,
+     -94,   -95,   -95,   -73,     3,   -95,   -95,   -95,   -33,   -95,
+     -60
   };
 
   const unsigned char
   parser::yydefgoto_[] =
   {
-       0,    25,    26,    27,    28,    92,    30,    78,    31,    43,
-      87,   136,    88,   134,    89,   161,   100,   117,    32,    33,
-      34,   106,   131,    55,    56,    62,    35,    76,    77
+       0,    25,    26,    27,    28,    95,    30,    79,    31,    43,
+      89,   142,    90,   140,    91,    92,   151,   171,   104,   122,
+      32,    33,    34,   110,   136,    55,    56,    63,    35,    77,
+      78
   };
 
   const unsigned char
   parser::yytable_[] =
   {
-      29,    37,    63,   104,    79,    36,   118,    39,   159,   160,
-      29,    41,    42,   109,   126,    38,    41,    42,   145,   111,
-      41,    42,   146,    40,    29,   123,   127,   128,   129,   130,
-      53,    54,    82,    83,    91,    93,    94,    95,    97,    98,
-     122,    29,    29,    99,   105,    80,   152,   148,   124,   125,
-     132,   149,   110,   107,   163,   108,   124,   125,    84,    85,
-      86,   139,   102,   140,    41,   112,   133,    51,    52,    53,
-      54,   120,    81,   115,   113,   147,   114,   150,   155,   116,
-     135,   137,   121,   156,   124,   125,    44,    45,    46,    47,
-      48,    49,    57,    58,    59,    60,    61,   133,   164,   138,
-     123,   119,   165,    51,    52,    53,    54,   141,   142,   144,
-     143,   151,   153,   154,   158,   166,   168,   162,   167,     0,
-       0,     1,     2,    50,     0,     3,     4,     5,     6,     0,
-      51,    52,    53,    54,     0,   157,     7,     8,     9,     0,
-       0,     0,     0,     0,    29,     0,    10,     0,    11,    12,
-      13,    14,    15,    16,    17,    18,    19,    20,    21,    22,
-      23,     3,     4,     5,     6,     0,     0,     0,     0,     0,
-       0,    96,     7,     8,     9,     0,     0,    24,     0,     0,
-       0,     0,     0,     0,    11,    12,    13,    14,    15,    16,
-      17,    18,    19,    20,    21,    22,    23,     3,     4,     5,
-       6,     0,     0,     0,     0,     0,     0,     0,     7,     8,
-       9,     0,     0,    90,    44,    45,    46,    47,    48,    49,
-      11,    12,    13,    14,    15,    16,    17,    18,    19,    20,
-      21,    22,    23,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     3,     4,     5,     6,     0,     0,     0,    90,
-       0,    50,   101,     7,     8,     9,     0,     0,    51,    52,
-      53,    54,     0,    81,     0,    11,    12,    13,    14,    15,
+      29,    64,    37,    80,   108,   113,   169,   170,   153,   123,
+      29,   156,   154,    41,    42,   157,    38,   131,    39,    36,
+     115,    41,    42,    40,    29,    44,    45,    46,    47,    48,
+      49,    41,    42,    83,    84,   127,   103,   132,   133,   134,
+     135,    29,    29,    53,    54,    94,    96,    97,    98,   100,
+     101,   160,   109,   128,   137,    81,    41,   102,   132,   133,
+     134,   135,    50,   106,   138,   173,   114,   129,   130,    51,
+      52,    53,    54,   116,    82,   163,   129,   130,   128,   185,
+      85,   155,   138,   158,   141,   143,   117,   120,   178,   164,
+     129,   130,   167,   121,    44,    45,    46,    47,    48,    49,
+      86,    87,    88,   138,   174,   124,   152,   111,   175,   112,
+     125,   118,   176,    51,    52,    53,    54,   145,    82,   146,
+     119,   168,   126,   184,   172,   138,   139,   144,     1,     2,
+     148,    50,     3,     4,     5,     6,   147,   149,    51,    52,
+      53,    54,   165,     7,     8,     9,   150,   159,   161,   183,
+      29,   162,   166,    10,   177,    11,    12,    13,    14,    15,
       16,    17,    18,    19,    20,    21,    22,    23,     3,     4,
-       5,     6,     0,     0,     0,     0,     0,     0,     0,     7,
-       8,     9,     4,     5,     6,     0,     0,     0,     0,     0,
-       0,    11,    12,    13,    14,    15,    16,    17,    18,    19,
-      20,    21,    22,    23,    11,    12,    13,    14,    15,    16,
-      17,    18,    19,    20,    21,    22,    23,    64,     0,     0,
-       0,     0,     0,     0,     0,    65,     0,     0,     0,   103,
-       0,     0,     0,     0,     0,     0,     0,    65,     0,    66,
-      67,    68,    69,    70,    71,    72,    73,    74,     0,     0,
-      75,    66,    67,    68,    69,    70,    71,    72,    73,    74,
-       0,     0,    75
+       5,     6,    57,    51,    52,    53,    54,   179,    99,     7,
+       8,     9,   181,   182,    24,   180,    58,    59,    60,    61,
+      62,    11,    12,    13,    14,    15,    16,    17,    18,    19,
+      20,    21,    22,    23,     3,     4,     5,     6,     0,     0,
+       0,     0,     0,     0,     0,     7,     8,     9,     0,     0,
+      93,     0,     0,     0,     0,     0,     0,    11,    12,    13,
+      14,    15,    16,    17,    18,    19,    20,    21,    22,    23,
+       3,     4,     5,     6,     0,     0,     0,     0,     0,     0,
+     105,     7,     8,     9,     0,     0,    93,     0,     0,     0,
+       0,     0,     0,    11,    12,    13,    14,    15,    16,    17,
+      18,    19,    20,    21,    22,    23,     3,     4,     5,     6,
+       0,     0,     0,     0,     0,     0,     0,     7,     8,     9,
+       4,     5,     6,     0,     0,     0,     0,     0,     0,    11,
+      12,    13,    14,    15,    16,    17,    18,    19,    20,    21,
+      22,    23,    11,    12,    13,    14,    15,    16,    17,    18,
+      19,    20,    21,    22,    23,    65,     0,     0,     0,     0,
+       0,     0,     0,    66,     0,     0,     0,   107,     0,     0,
+       0,     0,     0,     0,     0,    66,     0,    67,    68,    69,
+      70,    71,    72,    73,    74,    75,     0,     0,    76,    67,
+      68,    69,    70,    71,    72,    73,    74,    75,     0,     0,
+      76
   };
 
   const short
   parser::yycheck_[] =
   {
-       0,    10,    34,    63,    36,    59,    99,    24,     5,     6,
-      10,    26,    27,    77,   107,    24,    26,    27,    60,    79,
-      26,    27,    64,     0,    24,    29,    22,    23,    24,    25,
-      57,    58,    41,    42,    51,    52,    53,    54,    55,    56,
-     104,    41,    42,    65,    63,    60,   139,    60,    52,    53,
-     110,    64,    64,    61,    60,    63,    52,    53,    49,    50,
-      51,    64,    62,    66,    26,    59,    63,    55,    56,    57,
-      58,    63,    60,    90,    59,   135,    59,   137,   142,    96,
-     112,   113,    63,   143,    52,    53,    11,    12,    13,    14,
-      15,    16,    43,    44,    45,    46,    47,    63,   158,    34,
-      29,   101,   162,    55,    56,    57,    58,    63,    62,    64,
-      63,    60,    29,    63,   146,    63,    52,   149,   164,    -1,
-      -1,     3,     4,    48,    -1,     7,     8,     9,    10,    -1,
-      55,    56,    57,    58,    -1,   144,    18,    19,    20,    -1,
-      -1,    -1,    -1,    -1,   144,    -1,    28,    -1,    30,    31,
-      32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,     7,     8,     9,    10,    -1,    -1,    -1,    -1,    -1,
-      -1,    17,    18,    19,    20,    -1,    -1,    59,    -1,    -1,
-      -1,    -1,    -1,    -1,    30,    31,    32,    33,    34,    35,
-      36,    37,    38,    39,    40,    41,    42,     7,     8,     9,
-      10,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    18,    19,
-      20,    -1,    -1,    59,    11,    12,    13,    14,    15,    16,
-      30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
-      40,    41,    42,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,     7,     8,     9,    10,    -1,    -1,    -1,    59,
-      -1,    48,    17,    18,    19,    20,    -1,    -1,    55,    56,
-      57,    58,    -1,    60,    -1,    30,    31,    32,    33,    34,
+       0,    34,    10,    36,    64,    78,     5,     6,    60,   103,
+      10,    60,    64,    26,    27,    64,    24,   111,    24,    59,
+      80,    26,    27,     0,    24,    11,    12,    13,    14,    15,
+      16,    26,    27,    41,    42,   108,    65,    22,    23,    24,
+      25,    41,    42,    57,    58,    51,    52,    53,    54,    55,
+      56,   145,    63,    29,   114,    60,    26,    57,    22,    23,
+      24,    25,    48,    63,    63,    60,    64,    52,    53,    55,
+      56,    57,    58,    29,    60,   148,    52,    53,    29,    60,
+      29,   141,    63,   143,   117,   118,    59,    93,    52,   149,
+      52,    53,   152,    99,    11,    12,    13,    14,    15,    16,
+      49,    50,    51,    63,    64,   105,   139,    61,   168,    63,
+      63,    59,   172,    55,    56,    57,    58,    64,    60,    66,
+      59,   154,    63,   183,   157,    63,    59,    34,     3,     4,
+      62,    48,     7,     8,     9,    10,    63,    63,    55,    56,
+      57,    58,   150,    18,    19,    20,    64,    60,    29,   182,
+     150,    63,    60,    28,    63,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,     7,     8,
-       9,    10,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    18,
-      19,    20,     8,     9,    10,    -1,    -1,    -1,    -1,    -1,
-      -1,    30,    31,    32,    33,    34,    35,    36,    37,    38,
-      39,    40,    41,    42,    30,    31,    32,    33,    34,    35,
-      36,    37,    38,    39,    40,    41,    42,    21,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    29,    -1,    -1,    -1,    21,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    29,    -1,    43,
+       9,    10,    29,    55,    56,    57,    58,   174,    17,    18,
+      19,    20,    52,    59,    59,   175,    43,    44,    45,    46,
+      47,    30,    31,    32,    33,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,     7,     8,     9,    10,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    18,    19,    20,    -1,    -1,
+      59,    -1,    -1,    -1,    -1,    -1,    -1,    30,    31,    32,
+      33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
+       7,     8,     9,    10,    -1,    -1,    -1,    -1,    -1,    -1,
+      17,    18,    19,    20,    -1,    -1,    59,    -1,    -1,    -1,
+      -1,    -1,    -1,    30,    31,    32,    33,    34,    35,    36,
+      37,    38,    39,    40,    41,    42,     7,     8,     9,    10,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    18,    19,    20,
+       8,     9,    10,    -1,    -1,    -1,    -1,    -1,    -1,    30,
+      31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
+      41,    42,    30,    31,    32,    33,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    21,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    29,    -1,    -1,    -1,    21,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    29,    -1,    43,    44,    45,
+      46,    47,    48,    49,    50,    51,    -1,    -1,    54,    43,
       44,    45,    46,    47,    48,    49,    50,    51,    -1,    -1,
-      54,    43,    44,    45,    46,    47,    48,    49,    50,    51,
-      -1,    -1,    54
+      54
   };
 
   const signed char
@@ -2313,52 +2392,54 @@ namespace yy {
        0,     3,     4,     7,     8,     9,    10,    18,    19,    20,
       28,    30,    31,    32,    33,    34,    35,    36,    37,    38,
       39,    40,    41,    42,    59,    68,    69,    70,    71,    72,
-      73,    75,    85,    86,    87,    93,    59,    69,    69,    71,
+      73,    75,    87,    88,    89,    95,    59,    69,    69,    71,
        0,    26,    27,    76,    11,    12,    13,    14,    15,    16,
-      48,    55,    56,    57,    58,    90,    91,    43,    44,    45,
-      46,    47,    92,    93,    21,    29,    43,    44,    45,    46,
-      47,    48,    49,    50,    51,    54,    94,    95,    74,    93,
-      60,    60,    69,    69,    49,    50,    51,    77,    79,    81,
-      59,    71,    72,    71,    71,    71,    17,    71,    71,    65,
-      83,    17,    72,    21,    95,    63,    88,    61,    63,    88,
-      64,    95,    59,    59,    59,    71,    71,    84,    85,    72,
-      63,    63,    88,    29,    52,    53,    85,    22,    23,    24,
-      25,    89,    95,    63,    80,    93,    78,    93,    34,    64,
-      66,    63,    62,    63,    64,    60,    64,    95,    60,    64,
-      95,    60,    85,    29,    63,    88,    95,    69,    93,     5,
-       6,    82,    93,    60,    95,    95,    63,    82,    52
+      48,    55,    56,    57,    58,    92,    93,    29,    43,    44,
+      45,    46,    47,    94,    95,    21,    29,    43,    44,    45,
+      46,    47,    48,    49,    50,    51,    54,    96,    97,    74,
+      95,    60,    60,    69,    69,    29,    49,    50,    51,    77,
+      79,    81,    82,    59,    71,    72,    71,    71,    71,    17,
+      71,    71,    72,    65,    85,    17,    72,    21,    97,    63,
+      90,    61,    63,    90,    64,    97,    29,    59,    59,    59,
+      71,    71,    86,    87,    72,    63,    63,    90,    29,    52,
+      53,    87,    22,    23,    24,    25,    91,    97,    63,    59,
+      80,    95,    78,    95,    34,    64,    66,    63,    62,    63,
+      64,    83,    95,    60,    64,    97,    60,    64,    97,    60,
+      87,    29,    63,    90,    97,    69,    60,    97,    95,     5,
+       6,    84,    95,    60,    64,    97,    97,    63,    52,    91,
+      84,    52,    59,    95,    97,    60
   };
 
   const signed char
   parser::yyr1_[] =
   {
        0,    67,    68,    69,    69,    69,    69,    69,    69,    70,
-      70,    70,    70,    70,    70,    71,    71,    71,    71,    71,
-      71,    72,    72,    73,    73,    73,    73,    73,    73,    73,
-      74,    75,    76,    76,    76,    76,    77,    78,    78,    79,
-      80,    80,    81,    82,    82,    83,    84,    84,    85,    85,
-      85,    85,    85,    85,    85,    85,    85,    85,    85,    85,
-      85,    85,    85,    85,    86,    86,    87,    87,    87,    88,
-      88,    88,    89,    89,    89,    89,    90,    90,    90,    91,
-      91,    91,    91,    92,    92,    92,    92,    93,    93,    94,
-      95,    95,    95,    95,    95,    95,    95,    95,    95,    95,
-      95,    95
+      70,    70,    70,    70,    70,    70,    71,    71,    71,    71,
+      71,    71,    72,    72,    73,    73,    73,    73,    73,    73,
+      73,    74,    75,    76,    76,    76,    76,    77,    78,    78,
+      79,    80,    80,    81,    82,    82,    83,    83,    84,    84,
+      85,    86,    86,    87,    87,    87,    87,    87,    87,    87,
+      87,    87,    87,    87,    87,    87,    87,    87,    87,    88,
+      88,    89,    89,    89,    90,    90,    90,    91,    91,    91,
+      91,    92,    92,    92,    93,    93,    93,    93,    94,    94,
+      94,    94,    95,    95,    96,    97,    97,    97,    97,    97,
+      97,    97,    97,    97,    97,    97,    97
   };
 
   const signed char
   parser::yyr2_[] =
   {
-       0,     2,     2,     1,     3,     3,     2,     3,     1,     3,
-       4,     3,     3,     4,     3,     1,     3,     3,     3,     3,
-       3,     1,     1,     3,     6,     4,     3,     6,     4,     1,
-       2,    10,     0,     2,     2,     2,     4,     2,     4,     4,
-       3,     5,     4,     1,     1,     3,     1,     3,     1,     1,
+       0,     2,     3,     1,     3,     3,     2,     3,     1,     3,
+       4,     3,     3,     4,     3,     3,     1,     3,     3,     3,
+       3,     3,     1,     1,     3,     6,     4,     3,     6,     4,
+       1,     2,    10,     0,     2,     2,     2,     4,     2,     4,
+       4,     3,     5,     4,     0,     5,     4,     8,     1,     1,
+       3,     1,     3,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     0,     2,     2,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     0,
-       2,     2,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     0,     2,     2,
-       1,     5,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1
+       1,     1,     0,     2,     2,     1,     5,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1
   };
 
 
@@ -2383,9 +2464,10 @@ namespace yy {
   "']'", "'.'", "','", "'{'", "'}'", "$accept", "final", "query",
   "compare", "expr", "value", "prop", "simple_prop", "subquery",
   "post_query", "distinct", "distinct_param", "sort", "sort_param",
-  "limit", "direction", "list", "list_content", "constant", "boolexpr",
-  "comp_type", "post_op", "aggr_op", "equality", "relational", "stringop",
-  "path", "path_elem", "id", YY_NULLPTR
+  "limit", "group_by", "group_by_param", "direction", "list",
+  "list_content", "constant", "boolexpr", "comp_type", "post_op",
+  "aggr_op", "equality", "relational", "stringop", "path", "path_elem",
+  "id", YY_NULLPTR
   };
 #endif
 
@@ -2394,17 +2476,17 @@ namespace yy {
   const short
   parser::yyrline_[] =
   {
-       0,   148,   148,   151,   152,   153,   154,   155,   156,   159,
-     160,   165,   166,   167,   172,   175,   176,   177,   178,   179,
-     180,   183,   184,   188,   189,   190,   191,   192,   193,   194,
-     197,   200,   203,   204,   205,   206,   208,   211,   212,   214,
-     217,   218,   220,   223,   224,   226,   230,   231,   234,   235,
-     236,   237,   238,   239,   240,   241,   242,   243,   244,   245,
-     246,   247,   248,   249,   252,   253,   256,   257,   258,   261,
-     262,   263,   266,   267,   268,   269,   272,   273,   274,   277,
-     278,   279,   280,   283,   284,   285,   286,   289,   290,   293,
-     296,   297,   298,   299,   300,   301,   302,   303,   304,   305,
-     306,   307
+       0,   150,   150,   153,   154,   155,   156,   157,   158,   161,
+     162,   167,   168,   169,   174,   175,   185,   186,   187,   188,
+     189,   190,   193,   194,   198,   199,   200,   201,   202,   203,
+     204,   207,   210,   213,   214,   215,   216,   218,   221,   222,
+     224,   227,   228,   230,   233,   234,   244,   251,   254,   255,
+     257,   261,   262,   265,   266,   267,   268,   269,   270,   271,
+     272,   273,   274,   275,   276,   277,   278,   279,   280,   283,
+     284,   287,   288,   289,   292,   293,   294,   297,   298,   299,
+     300,   303,   304,   305,   308,   309,   310,   311,   314,   315,
+     316,   317,   320,   321,   324,   327,   328,   329,   330,   331,
+     332,   333,   334,   335,   336,   337,   338
   };
 
   void
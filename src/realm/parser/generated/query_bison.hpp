@@ -64,6 +64,7 @@
     class PathNode;
     class DescriptorOrderingNode;
     class DescriptorNode;
+    class GroupByNode;
     class PropNode;
     class SubqueryNode;
   }
@@ -445,43 +446,47 @@ namespace yy {
       // expr
       char dummy5[sizeof (ExpressionNode*)];
 
+      // group_by
+      // group_by_param
+      char dummy6[sizeof (GroupByNode*)];
+
       // list
       // list_content
-      char dummy6[sizeof (ListNode*)];
+      char dummy7[sizeof (ListNode*)];
 
       // path
-      char dummy7[sizeof (PathNode*)];
+      char dummy8[sizeof (PathNode*)];
 
       // post_op
-      char dummy8[sizeof (PostOpNode*)];
+      char dummy9[sizeof (PostOpNode*)];
 
       // simple_prop
-      char dummy9[sizeof (PropNode*)];
+      char dummy10[sizeof (PropNode*)];
 
       // prop
-      char dummy10[sizeof (PropertyNode*)];
+      char dummy11[sizeof (PropertyNode*)];
 
       // query
       // compare
-      char dummy11[sizeof (QueryNode*)];
+      char dummy12[sizeof (QueryNode*)];
 
       // subquery
-      char dummy12[sizeof (SubqueryNode*)];
+      char dummy13[sizeof (SubqueryNode*)];
 
       // boolexpr
-      char dummy13[sizeof (TrueOrFalseNode*)];
+      char dummy14[sizeof (TrueOrFalseNode*)];
 
       // value
-      char dummy14[sizeof (ValueNode*)];
+      char dummy15[sizeof (ValueNode*)];
 
       // direction
-      char dummy15[sizeof (bool)];
+      char dummy16[sizeof (bool)];
 
       // comp_type
       // equality
       // relational
       // stringop
-      char dummy16[sizeof (int)];
+      char dummy17[sizeof (int)];
 
       // "identifier"
       // "string"
@@ -511,7 +516,7 @@ namespace yy {
       // "key or value"
       // path_elem
       // id
-      char dummy17[sizeof (std::string)];
+      char dummy18[sizeof (std::string)];
     };
 
     /// The size of the largest semantic type.
@@ -710,20 +715,22 @@ namespace yy {
         SYM_sort = 79,                           // sort
         SYM_sort_param = 80,                     // sort_param
         SYM_limit = 81,                          // limit
-        SYM_direction = 82,                      // direction
-        SYM_list = 83,                           // list
-        SYM_list_content = 84,                   // list_content
-        SYM_constant = 85,                       // constant
-        SYM_boolexpr = 86,                       // boolexpr
-        SYM_comp_type = 87,                      // comp_type
-        SYM_post_op = 88,                        // post_op
-        SYM_aggr_op = 89,                        // aggr_op
-        SYM_equality = 90,                       // equality
-        SYM_relational = 91,                     // relational
-        SYM_stringop = 92,                       // stringop
-        SYM_path = 93,                           // path
-        SYM_path_elem = 94,                      // path_elem
-        SYM_id = 95                              // id
+        SYM_group_by = 82,                       // group_by
+        SYM_group_by_param = 83,                 // group_by_param
+        SYM_direction = 84,                      // direction
+        SYM_list = 85,                           // list
+        SYM_list_content = 86,                   // list_content
+        SYM_constant = 87,                       // constant
+        SYM_boolexpr = 88,                       // boolexpr
+        SYM_comp_type = 89,                      // comp_type
+        SYM_post_op = 90,                        // post_op
+        SYM_aggr_op = 91,                        // aggr_op
+        SYM_equality = 92,                       // equality
+        SYM_relational = 93,                     // relational
+        SYM_stringop = 94,                       // stringop
+        SYM_path = 95,                           // path
+        SYM_path_elem = 96,                      // path_elem
+        SYM_id = 97                              // id
       };
     };
 
@@ -782,6 +789,11 @@ namespace yy {
         value.move< ExpressionNode* > (std::move (that.value));
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+        value.move< GroupByNode* > (std::move (that.value));
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.move< ListNode* > (std::move (that.value));
@@ -943,6 +955,18 @@ namespace yy {
       {}
 #endif
 
+#if 201103L <= YY_CPLUSPLUS
+      basic_symbol (typename Base::kind_type t, GroupByNode*&& v)
+        : Base (t)
+        , value (std::move (v))
+      {}
+#else
+      basic_symbol (typename Base::kind_type t, const GroupByNode*& v)
+        : Base (t)
+        , value (v)
+      {}
+#endif
+
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t, ListNode*&& v)
         : Base (t)
@@ -1151,6 +1175,11 @@ switch (yykind)
         value.template destroy< ExpressionNode* > ();
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+        value.template destroy< GroupByNode* > ();
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.template destroy< ListNode* > ();
@@ -2552,8 +2581,8 @@ switch (yykind)
     /// Constants.
     enum
     {
-      yylast_ = 372,     ///< Last index in yytable_.
-      yynnts_ = 29,  ///< Number of nonterminal symbols.
+      yylast_ = 370,     ///< Last index in yytable_.
+      yynnts_ = 31,  ///< Number of nonterminal symbols.
       yyfinal_ = 40 ///< Termination state number.
     };
 
@@ -2649,6 +2678,11 @@ switch (yykind)
         value.copy< ExpressionNode* > (YY_MOVE (that.value));
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+        value.copy< GroupByNode* > (YY_MOVE (that.value));
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.copy< ListNode* > (YY_MOVE (that.value));
@@ -2784,6 +2818,11 @@ switch (yykind)
         value.move< ExpressionNode* > (YY_MOVE (s.value));
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+        value.move< GroupByNode* > (YY_MOVE (s.value));
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.move< ListNode* > (YY_MOVE (s.value));
@@ -26,6 +26,7 @@
     class PathNode;
     class DescriptorOrderingNode;
     class DescriptorNode;
+    class GroupByNode;
     class PropNode;
     class SubqueryNode;
   }
@@ -125,6 +126,7 @@ using namespace realm::query_parser;
 %type  <QueryNode*> query compare
 %type  <PathNode*> path
 %type  <DescriptorOrderingNode*> post_query
+%type  <GroupByNode*> group_by group_by_param
 %type  <DescriptorNode*> sort sort_param distinct distinct_param limit
 %type  <SubqueryNode*> subquery
 %type  <std::string> path_elem id
@@ -145,7 +147,7 @@ using namespace realm::query_parser;
 %right NOT;
 
 final
-    : query post_query { drv.result = $1; drv.ordering = $2; };
+    : query post_query group_by { drv.result = $1; drv.ordering = $2; drv.group_by = $3; };
 
 query
     : compare                   { $$ = $1; }
@@ -170,6 +172,14 @@ compare
                                     $$ = tmp;
                                 }
     | value BETWEEN list        { $$ = drv.m_parse_nodes.create<BetweenNode>($1, $3); }
+    | value ID value            {
+                                    // The full-text operator 'TEXT' is scanned as an identifier
+                                    if ($2 != "TEXT" && $2 != "text") {
+                                        error("syntax error, unexpected identifier '" + $2 + "'");
+                                        YYABORT;
+                                    }
+                                    $$ = drv.m_parse_nodes.create<StringOpsNode>($1, CompareNode::TEXT, $3);
+                                }
 
 expr
     : value                     { $$ = $1; }
@@ -219,6 +229,27 @@ sort_param
 
 limit: LIMIT '(' NATURAL0 ')'   { $$ = drv.m_parse_nodes.create<DescriptorNode>(DescriptorNode::LIMIT, $3); }
 
+group_by
+    : %empty                    { $$ = nullptr; }
+    | ID ID '(' group_by_param ')' {
+                                    // 'GROUP BY' is scanned as two identifiers
+                                    if (($1 != "GROUP" && $1 != "group") || ($2 != "BY" && $2 != "by")) {
+                                        error("syntax error, unexpected identifier '" + $1 + "'");
+                                        YYABORT;
+                                    }
+                                    $$ = $4;
+                                }
+
+group_by_param
+    : path id ',' SIZE          {
+                                    if ($4 != "@count") {
+                                        error("syntax error, unexpected '" + $4 + "', expecting '@count'");
+                                        YYABORT;
+                                    }
+                                    $$ = drv.m_parse_nodes.create<GroupByNode>($1, $2);
+                                }
+    | path id ',' aggr_op '(' path id ')' { $$ = drv.m_parse_nodes.create<GroupByNode>($1, $2, $4, $6, $7); }
+
 direction
     : ASCENDING                 { $$ = true; }
     | DESCENDING                { $$ = false; }
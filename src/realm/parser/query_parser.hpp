@@ -29,6 +29,13 @@
 #include <realm/util/any.hpp>
 #include <realm/mixed.hpp>
 
+#include <memory>
+#include <string>
+
+namespace realm {
+class Table;
+}
+
 namespace realm::query_parser {
 
 /// Exception thrown when parsing fails due to invalid syntax.
@@ -317,6 +324,45 @@ public:
 
 void parse(const std::string&);
 
+struct ParsedQuery;
+
+/// A query string that has been parsed. Table::query() turns it into a Query
+/// on that table for any arguments and key path mapping without parsing it
+/// again, as the parsed form does not depend on either. Copies share the
+/// parsed query, which may be used from several threads at once.
+class PreparedQuery {
+public:
+    PreparedQuery() = default;
+
+    explicit operator bool() const noexcept
+    {
+        return bool(m_parsed);
+    }
+    const std::string& get_query_string() const noexcept;
+
+private:
+    std::shared_ptr<const ParsedQuery> m_parsed;
+
+    PreparedQuery(std::shared_ptr<const ParsedQuery> parsed)
+        : m_parsed(std::move(parsed))
+    {
+    }
+
+    friend PreparedQuery prepare(const std::string&);
+    friend class realm::Table;
+};
+
+/// Parses \a query_string. The most recently prepared query strings are
+/// cached, so preparing one of them again returns the cached PreparedQuery.
+/// Table::query() prepares its query string this way.
+///
+/// \throw SyntaxError if the query string cannot be parsed.
+PreparedQuery prepare(const std::string& query_string);
+
+/// Sets how many query strings prepare() caches (by default 256). Zero
+/// disables the cache.
+void set_prepared_query_cache_size(size_t size);
+
 } // namespace realm::query_parser
 
 
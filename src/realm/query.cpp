@@ -934,6 +934,13 @@ Query& Query::like(ColKey column_key, StringData value, bool case_sensitive)
         add_condition<LikeIns>(column_key, value);
     return *this;
 }
+Query& Query::fulltext(ColKey column_key, StringData terms)
+{
+    if (!m_table->has_fulltext_index(column_key))
+        throw LogicError(LogicError::no_search_index);
+    add_node(std::unique_ptr<ParentNode>(new FullTextNode(terms, column_key)));
+    return *this;
+}
 
 
 // Aggregates =================================================================================
@@ -1318,6 +1325,140 @@ Decimal128 Query::average_mixed(ColKey column_key, size_t* resultcount) const
     return average<Mixed>(column_key, resultcount);
 }
 
+// Group by
+
+namespace {
+
+template <template <class> class Operator>
+std::unique_ptr<QueryStateGroupByBase> make_numeric_group_state(ColKey value_column)
+{
+    switch (value_column.get_type()) {
+        case col_type_Int:
+            return std::make_unique<QueryStateGroupBy<Operator<int64_t>>>();
+        case col_type_Float:
+            return std::make_unique<QueryStateGroupBy<Operator<float>>>();
+        case col_type_Double:
+            return std::make_unique<QueryStateGroupBy<Operator<double>>>();
+        case col_type_Decimal:
+            return std::make_unique<QueryStateGroupBy<Operator<Decimal128>>>();
+        case col_type_Mixed:
+            return std::make_unique<QueryStateGroupBy<Operator<Mixed>>>();
+        default:
+            break;
+    }
+    throw LogicError(LogicError::type_mismatch);
+}
+
+} // anonymous namespace
+
+Query::GroupBy Query::group_by(ColKey group_column) const
+{
+    m_table->check_column(group_column);
+    auto type = group_column.get_type();
+    if (group_column.is_collection() || type == col_type_BackLink || type == col_type_TypedLink)
+        throw LogicError(LogicError::illegal_type);
+    return GroupBy(*this, group_column);
+}
+
+std::vector<std::pair<Mixed, Mixed>> Query::GroupBy::aggregate(Action action, ColKey value_column) const
+{
+    if (action != act_Count) {
+        m_query.m_table->check_column(value_column);
+        if (value_column.is_collection())
+            throw LogicError(LogicError::illegal_type);
+    }
+
+    std::unique_ptr<QueryStateGroupByBase> st;
+    switch (action) {
+        case act_Count:
+            // The values are not needed to count the objects of the groups
+            value_column = ColKey();
+            st = std::make_unique<QueryStateGroupBy<GroupCount>>();
+            break;
+        case act_Sum:
+            st = make_numeric_group_state<aggregate_operations::Sum>(value_column);
+            break;
+        case act_Average:
+            st = make_numeric_group_state<aggregate_operations::Average>(value_column);
+            break;
+        case act_Min:
+            st = std::make_unique<QueryStateGroupBy<aggregate_operations::Minimum<Mixed>>>();
+            break;
+        case act_Max:
+            st = std::make_unique<QueryStateGroupBy<aggregate_operations::Maximum<Mixed>>>();
+            break;
+        default:
+            throw LogicError(LogicError::illegal_combination);
+    }
+    m_query.aggregate_groups(*st, m_group_column, value_column);
+    return st->get_result();
+}
+
+void Query::aggregate_groups(QueryStateGroupByBase& st, ColKey group_column, ColKey value_column) const
+{
+    auto report_object = [&](const Obj& obj) {
+        st.m_group = obj.get_any(group_column);
+        st.m_key_offset = obj.get_key().value;
+        st.match(realm::npos, value_column ? obj.get_any(value_column) : Mixed());
+    };
+
+    if (has_conditions())
+        init();
+
+    if (m_view) {
+        m_view->for_each([&](const Obj& obj) {
+            if (eval_object(obj))
+                report_object(obj);
+            return false;
+        });
+        return;
+    }
+
+    ParentNode* node = nullptr;
+    if (has_conditions()) {
+        auto pn = root_node();
+        auto best = find_best_node(pn);
+        if (pn->m_children[best]->has_search_index()) {
+            auto keys = pn->m_children[best]->index_based_keys();
+            // All the objects found through the index match the condition of the index node
+            pn->m_children[best] = pn->m_children.back();
+            pn->m_children.pop_back();
+            for (auto key : keys) {
+                auto obj = m_table->get_object(key);
+                if (pn->m_children.empty() || eval_object(obj))
+                    report_object(obj);
+            }
+            return;
+        }
+        node = pn;
+    }
+
+    // Traverse the cluster tree, reading the group of each match from the leaf of the group column
+    auto group_leaf = m_table->make_leaf_accessor(group_column);
+    auto value_leaf = value_column ? m_table->make_leaf_accessor(value_column) : nullptr;
+    st.m_group_leaf = group_leaf.get();
+    auto f = [&](const Cluster* cluster) {
+        size_t e = cluster->node_size();
+        cluster->init_leaf(group_column, group_leaf.get());
+        if (value_leaf)
+            cluster->init_leaf(value_column, value_leaf.get());
+        st.m_key_offset = cluster->get_offset();
+        st.m_key_values = cluster->get_key_array();
+        if (node) {
+            node->set_cluster(cluster);
+            aggregate_internal(node, &st, 0, e, value_leaf.get());
+        }
+        else {
+            for (size_t i = 0; i < e; i++)
+                st.match(i, value_leaf ? value_leaf->get_any(i) : Mixed());
+        }
+        // Continue
+        return false;
+    };
+    m_table->traverse_clusters(f);
+    st.m_group_leaf = nullptr;
+}
+
 
 // Grouping
 Query& Query::group()
@@ -24,6 +24,7 @@
 #include <climits>
 #include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 #define REALM_MULTITHREAD_QUERY 0
@@ -36,6 +37,7 @@
 
 #include <realm/aggregate_ops.hpp>
 #include <realm/obj_list.hpp>
+#include <realm/query_state.hpp>
 #include <realm/table_ref.hpp>
 #include <realm/binary_data.hpp>
 #include <realm/timestamp.hpp>
@@ -56,6 +58,7 @@ class Array;
 class Expression;
 class Group;
 class Transaction;
+class QueryStateGroupByBase;
 
 namespace metrics {
 class QueryInfo;
@@ -211,6 +214,11 @@ public:
     Query& contains(ColKey column_key, StringData value, bool case_sensitive = true);
     Query& like(ColKey column_key, StringData value, bool case_sensitive = true);
 
+    // Full-text search of a column with a full-text index (see
+    // Table::add_fulltext_index()). Matches the objects containing all the
+    // words in `terms`, except those containing a word prefixed by '-'.
+    Query& fulltext(ColKey column_key, StringData terms);
+
     // These are shortcuts for equal(StringData(c_str)) and
     // not_equal(StringData(c_str)), and are needed to avoid unwanted
     // implicit conversion of char* to bool.
@@ -280,6 +288,11 @@ public:
     Mixed minimum_mixed(ColKey column_key, ObjKey* return_ndx = nullptr) const;
     Decimal128 average_mixed(ColKey column_key, size_t* resultcount = nullptr) const;
 
+    // Aggregates per distinct value of a column, which must not be a
+    // collection or a backlink column
+    class GroupBy;
+    GroupBy group_by(ColKey group_column) const;
+
     // Deletion
     size_t remove();
 
@@ -372,6 +385,8 @@ private:
     void aggregate_internal(ParentNode* pn, QueryStateBase* st, size_t start, size_t end,
                             ArrayPayload* source_column) const;
 
+    void aggregate_groups(QueryStateGroupByBase& st, ColKey group_column, ColKey value_column) const;
+
     void do_find_all(TableView& tv, size_t limit) const;
     size_t do_count(size_t limit = size_t(-1)) const;
     void delete_nodes() noexcept;
@@ -417,6 +432,34 @@ private:
     util::bind_ptr<DescriptorOrdering> m_ordering;
 };
 
+/// The objects matching a query, grouped by the value of a column. All groups
+/// are aggregated in a single pass over the matches, which replaces running a
+/// query per distinct value of the column.
+class Query::GroupBy {
+public:
+    /// The groups in ascending order, each with its aggregate of `value_column`.
+    /// act_Count counts the objects of each group and needs no value column.
+    /// act_Sum and act_Average require a numeric column and give the same
+    /// result types as `sum_*()` and `average_*()`. act_Min and act_Max give a
+    /// value of the column. The aggregate of a group with no non-null values is
+    /// null, except for act_Sum, which is zero. Values that compare equal,
+    /// such as 1 and 1.0 in a Mixed column, form one group, and a link to a
+    /// deleted object is grouped as null.
+    std::vector<std::pair<Mixed, Mixed>> aggregate(Action action, ColKey value_column = {}) const;
+
+private:
+    friend class Query;
+
+    GroupBy(const Query& query, ColKey group_column)
+        : m_query(query)
+        , m_group_column(group_column)
+    {
+    }
+
+    Query m_query;
+    ColKey m_group_column;
+};
+
 // Implementation:
 
 inline Query& Query::equal(ColKey column_key, const char* c_str, bool case_sensitive)
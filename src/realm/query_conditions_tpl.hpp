@@ -22,8 +22,11 @@
 #include <realm/aggregate_ops.hpp>
 #include <realm/query_conditions.hpp>
 #include <realm/column_type_traits.hpp>
+#include <realm/node.hpp>
 
 #include <cmath>
+#include <map>
+#include <vector>
 
 namespace realm {
 
@@ -114,6 +117,80 @@ private:
     aggregate_operations::Maximum<typename util::RemoveOptional<R>::type> m_state;
 };
 
+// State of a group-by aggregation, see Query::group_by(). Matches are reported
+// with the value of the aggregated column. The group of a match is read from
+// `m_group_leaf` at the index of the match, or taken from `m_group` when there
+// is no leaf, as is the case for matches found through a search index.
+class QueryStateGroupByBase : public QueryStateBase {
+public:
+    QueryStateGroupByBase()
+        : QueryStateBase(size_t(-1))
+    {
+    }
+    // The groups in ascending order, each with its aggregate
+    virtual std::vector<std::pair<Mixed, Mixed>> get_result() const = 0;
+
+    ArrayPayload* m_group_leaf = nullptr;
+    Mixed m_group;
+
+protected:
+    Mixed current_group(size_t index) const noexcept
+    {
+        Mixed group = m_group_leaf ? m_group_leaf->get_any(index) : m_group;
+        // A link to a deleted object is null, as with Obj::get_any()
+        if (group.is_type(type_Link) && group.get<ObjKey>().is_unresolved())
+            return Mixed();
+        return group;
+    }
+};
+
+// Counts the matches of a group, including those where the aggregated value is null
+class GroupCount {
+public:
+    bool accumulate(Mixed)
+    {
+        ++m_count;
+        return true;
+    }
+    bool is_null() const
+    {
+        return false;
+    }
+    int64_t result() const
+    {
+        return m_count;
+    }
+
+private:
+    int64_t m_count = 0;
+};
+
+// Accumulator is GroupCount or one of the aggregate_operations
+template <class Accumulator>
+class QueryStateGroupBy : public QueryStateGroupByBase {
+public:
+    bool match(size_t index, Mixed value) noexcept final
+    {
+        m_groups[current_group(index)].accumulate(value);
+        ++m_match_count;
+        return true;
+    }
+    std::vector<std::pair<Mixed, Mixed>> get_result() const final
+    {
+        std::vector<std::pair<Mixed, Mixed>> result;
+        result.reserve(m_groups.size());
+        for (auto& [group, accumulator] : m_groups) {
+            result.emplace_back(group, accumulator.is_null() ? Mixed() : Mixed(accumulator.result()));
+        }
+        return result;
+    }
+
+private:
+    // Ordered by Mixed::compare(), so that values which compare equal, such
+    // as 1 and 1.0 in a Mixed column, form a single group
+    std::map<Mixed, Accumulator> m_groups;
+};
+
 } // namespace realm
 
 #endif /* REALM_QUERY_CONDITIONS_TPL_HPP */
@@ -240,6 +240,73 @@ size_t MixedNode<Equal>::find_first_local(size_t start, size_t end)
     return not_found;
 }
 
+std::vector<std::string> StringNodeBase::search_trigrams(StringData upper, StringData lower, bool wildcards)
+{
+    if (upper.size() != lower.size())
+        return {};
+
+    // The trigram index folds ASCII letters to lower case, so a byte of the
+    // search string is known if it folds to the same byte in both versions.
+    // Each run of known bytes must occur in a matching string.
+    auto fold = [](char c) {
+        return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+    };
+    std::set<std::string> trigrams;
+    std::string run;
+    for (size_t i = 0; i <= upper.size(); ++i) {
+        bool known = i < upper.size() && fold(upper[i]) == fold(lower[i]);
+        if (known && wildcards)
+            known = upper[i] != '*' && upper[i] != '?';
+        if (known) {
+            run += fold(lower[i]);
+        }
+        else {
+            trigrams.merge(tokenize_trigrams(run));
+            run.clear();
+        }
+    }
+    return std::vector<std::string>(trigrams.begin(), trigrams.end());
+}
+
+void StringNodeBase::init_trigram_matches(util::FunctionRef<bool(StringData)> match)
+{
+    m_dT = 0.0;
+    m_trigram_matches.clear();
+    m_trigram_matches_get = 0;
+    m_trigram_last_start_key = ObjKey();
+
+    auto table = m_table.unchecked_ptr();
+    auto index = table->get_trigram_index(m_condition_column_key);
+    REALM_ASSERT(index);
+
+    // Intersect the lists of the index, starting with the shortest one
+    std::vector<std::pair<size_t, StringData>> trigrams;
+    for (auto& trigram : m_trigrams) {
+        StringData str(trigram);
+        trigrams.emplace_back(index->count(str), str);
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+
+    std::vector<ObjKey> candidates;
+    std::vector<ObjKey> keys;
+    std::vector<ObjKey> intersection;
+    index->find_all(candidates, trigrams.front().second);
+    for (size_t i = 1; i < trigrams.size() && !candidates.empty(); ++i) {
+        keys.clear();
+        intersection.clear();
+        index->find_all(keys, trigrams[i].second);
+        std::set_intersection(candidates.begin(), candidates.end(), keys.begin(), keys.end(),
+                              std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+
+    // The trigrams do not tell where they occur in the string, so check the candidates
+    for (auto key : candidates) {
+        if (match(table->get_object(key).get<StringData>(m_condition_column_key)))
+            m_trigram_matches.push_back(key);
+    }
+}
+
 void StringNodeEqualBase::init(bool will_query_ranges)
 {
     StringNodeBase::init(will_query_ranges);
@@ -456,6 +523,66 @@ size_t StringNode<EqualIns>::_find_first_local(size_t start, size_t end)
     return not_found;
 }
 
+void FullTextNode::init(bool will_query_ranges)
+{
+    ParentNode::init(will_query_ranges);
+    m_dT = 0.0;
+    m_result.clear();
+    m_result_get = 0;
+    m_last_start_key = ObjKey();
+
+    std::set<std::string> words;
+    std::set<std::string> excluded_words;
+    size_t pos = 0;
+    while (pos < m_terms.size()) {
+        size_t term_end = m_terms.find_first_of(" \t\r\n", pos);
+        if (term_end == std::string::npos)
+            term_end = m_terms.size();
+        StringData term(m_terms.data() + pos, term_end - pos);
+        if (term.begins_with("-")) {
+            excluded_words.merge(tokenize_text(term.substr(1)));
+        }
+        else {
+            words.merge(tokenize_text(term));
+        }
+        pos = term_end + 1;
+    }
+
+    auto index = m_table->get_fulltext_index(m_condition_column_key);
+    REALM_ASSERT(index);
+
+    // The lists of the index are sorted by key, so they can be intersected directly
+    std::vector<ObjKey> keys;
+    std::vector<ObjKey> matches;
+    if (words.empty()) {
+        // Only words to exclude, so start out with all objects
+        m_result.reserve(m_table->size());
+        for (auto obj : *m_table) {
+            m_result.push_back(obj.get_key());
+        }
+    }
+    else {
+        auto word = words.begin();
+        index->find_all(m_result, StringData(*word));
+        while (++word != words.end() && !m_result.empty()) {
+            keys.clear();
+            matches.clear();
+            index->find_all(keys, StringData(*word));
+            std::set_intersection(m_result.begin(), m_result.end(), keys.begin(), keys.end(),
+                                  std::back_inserter(matches));
+            m_result.swap(matches);
+        }
+    }
+
+    for (auto& word : excluded_words) {
+        keys.clear();
+        matches.clear();
+        index->find_all(keys, StringData(word));
+        std::set_difference(m_result.begin(), m_result.end(), keys.begin(), keys.end(), std::back_inserter(matches));
+        m_result.swap(matches);
+    }
+}
+
 std::unique_ptr<ArrayPayload> TwoColumnsNodeBase::update_cached_leaf_pointers_for_column(Allocator& alloc,
                                                                                          const ColKey& col_key)
 {
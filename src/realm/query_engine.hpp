@@ -1502,6 +1502,18 @@ public:
     void table_changed() override
     {
         m_is_string_enum = m_table.unchecked_ptr()->is_enumerated(m_condition_column_key);
+        m_has_trigram_index =
+            !m_trigrams.empty() && m_table.unchecked_ptr()->has_trigram_index(m_condition_column_key);
+    }
+
+    bool has_search_index() const override
+    {
+        return m_has_trigram_index;
+    }
+
+    const std::vector<ObjKey>& index_based_keys() override
+    {
+        return m_trigram_matches;
     }
 
     void cluster_changed() override
@@ -1537,6 +1549,8 @@ public:
         : ParentNode(from)
         , m_value(from.m_value)
         , m_is_string_enum(from.m_is_string_enum)
+        , m_trigrams(from.m_trigrams)
+        , m_has_trigram_index(from.m_has_trigram_index)
     {
     }
 
@@ -1566,10 +1580,34 @@ protected:
     size_t m_leaf_start = 0;
     size_t m_leaf_end = 0;
 
+    // Trigrams that any matching string must contain. Set by the substring conditions, which then use the trigram
+    // index of the column, if it has one, to find the candidates.
+    std::vector<std::string> m_trigrams;
+    bool m_has_trigram_index = false;
+    std::vector<ObjKey> m_trigram_matches;
+    ObjKey m_trigram_last_start_key;
+    size_t m_trigram_matches_get = 0;
+
     inline StringData get_string(size_t s)
     {
         return m_leaf_ptr->get(s);
     }
+
+    // The trigrams of the search string that a match must contain when every
+    // byte of the string equals the byte of either \a upper or \a lower at the
+    // same position. With \a wildcards, '*' and '?' may match anything.
+    static std::vector<std::string> search_trigrams(StringData upper, StringData lower, bool wildcards);
+
+    // Collects the objects that contain all of m_trigrams and satisfy \a match
+    void init_trigram_matches(util::FunctionRef<bool(StringData)> match);
+
+    size_t find_first_trigram_match(size_t start, size_t end)
+    {
+        if (start < end)
+            return do_search_index(m_trigram_last_start_key, m_trigram_matches_get, m_trigram_matches, m_cluster, start,
+                                   end);
+        return not_found;
+    }
 };
 
 // Conditions for strings. Note that Equal is specialized later in this file!
@@ -1587,6 +1625,12 @@ public:
         else {
             m_ucase = std::move(*upper);
             m_lcase = std::move(*lower);
+            if constexpr (std::is_same_v<TConditionFunction, Like>) {
+                m_trigrams = search_trigrams(v, v, true);
+            }
+            else if constexpr (std::is_same_v<TConditionFunction, LikeIns>) {
+                m_trigrams = search_trigrams(m_ucase, m_lcase, true);
+            }
         }
     }
 
@@ -1594,10 +1638,19 @@ public:
     {
         StringNodeBase::init(will_query_ranges);
         clear_leaf_state();
+        if (m_has_trigram_index) {
+            TConditionFunction cond;
+            init_trigram_matches([&](StringData t) {
+                return cond(StringData(m_value), m_ucase.c_str(), m_lcase.c_str(), t);
+            });
+        }
     }
 
     size_t find_first_local(size_t start, size_t end) override
     {
+        if (m_has_trigram_index)
+            return find_first_trigram_match(start, end);
+
         TConditionFunction cond;
 
         for (size_t s = start; s < end; ++s) {
@@ -1653,17 +1706,27 @@ public:
             m_charmap[c] = jump;
         }
         m_dT = 50.0;
+        m_trigrams = search_trigrams(v, v, false);
     }
 
     void init(bool will_query_ranges) override
     {
         StringNodeBase::init(will_query_ranges);
         clear_leaf_state();
+        if (m_has_trigram_index) {
+            Contains cond;
+            init_trigram_matches([&](StringData t) {
+                return cond(StringData(m_value), m_charmap, t);
+            });
+        }
     }
 
 
     size_t find_first_local(size_t start, size_t end) override
     {
+        if (m_has_trigram_index)
+            return find_first_trigram_match(start, end);
+
         Contains cond;
 
         for (size_t s = start; s < end; ++s) {
@@ -1730,17 +1793,27 @@ public:
             m_charmap[lc] = jump;
         }
         m_dT = 75.0;
+        m_trigrams = search_trigrams(m_ucase, m_lcase, false);
     }
 
     void init(bool will_query_ranges) override
     {
         StringNodeBase::init(will_query_ranges);
         clear_leaf_state();
+        if (m_has_trigram_index) {
+            ContainsIns cond;
+            init_trigram_matches([&](StringData t) {
+                return cond(StringData(m_value), m_ucase.c_str(), m_lcase.c_str(), m_charmap, t);
+            });
+        }
     }
 
 
     size_t find_first_local(size_t start, size_t end) override
     {
+        if (m_has_trigram_index)
+            return find_first_trigram_match(start, end);
+
         ContainsIns cond;
 
         for (size_t s = start; s < end; ++s) {
@@ -1978,6 +2051,54 @@ private:
     size_t _find_first_local(size_t start, size_t end) override;
 };
 
+// Full-text search: matches the objects whose string contains all the words
+// of the search terms, and none of the words of terms prefixed by '-'. The
+// matches are always found through the full-text index of the column.
+class FullTextNode : public ParentNode {
+public:
+    FullTextNode(StringData terms, ColKey column)
+        : m_terms(terms)
+    {
+        m_condition_column_key = column;
+    }
+
+    void init(bool will_query_ranges) override;
+
+    bool has_search_index() const override
+    {
+        return true;
+    }
+
+    const std::vector<ObjKey>& index_based_keys() override
+    {
+        return m_result;
+    }
+
+    size_t find_first_local(size_t start, size_t end) override
+    {
+        if (start < end)
+            return do_search_index(m_last_start_key, m_result_get, m_result, m_cluster, start, end);
+        return not_found;
+    }
+
+    std::string describe(util::serializer::SerialisationState& state) const override
+    {
+        return state.describe_column(ParentNode::m_table, m_condition_column_key) + " TEXT " +
+               util::serializer::print_value(StringData(m_terms));
+    }
+
+    std::unique_ptr<ParentNode> clone() const override
+    {
+        return std::unique_ptr<ParentNode>(new FullTextNode(*this));
+    }
+
+private:
+    std::string m_terms;
+    std::vector<ObjKey> m_result;
+    ObjKey m_last_start_key;
+    size_t m_result_get = 0;
+};
+
 // OR node contains at least two node pointers: Two or more conditions to OR
 // together in m_conditions, and the next AND condition (if any) in m_child.
 //
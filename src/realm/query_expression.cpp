@@ -19,6 +19,9 @@
 #include <realm/query_expression.hpp>
 #include <realm/group.hpp>
 #include <realm/dictionary.hpp>
+#include <realm/table_view.hpp>
+
+#include <unordered_set>
 
 namespace realm {
 
@@ -251,6 +254,76 @@ std::vector<ObjKey> LinkMap::get_origin_ndxs(ObjKey key, size_t column) const
     return ret;
 }
 
+TableVersions LinkMap::get_content_versions() const
+{
+    TableVersions versions;
+    for (auto& t : m_tables) {
+        versions.emplace_back(t->get_key(), t->get_content_version());
+    }
+    return versions;
+}
+
+bool LinkMap::can_find_origin_keys() const
+{
+    for (size_t i = 0; i < m_link_column_keys.size(); i++) {
+        ColKey link_col_key = m_link_column_keys[i];
+        m_tables[i]->check_column(link_col_key); // Throws
+        if (m_link_types[i] == col_type_BackLink)
+            link_col_key = m_tables[i]->get_opposite_column(link_col_key);
+        auto type = link_col_key.get_type();
+        if (link_col_key.is_dictionary() || (type != col_type_Link && type != col_type_LinkList))
+            return false;
+    }
+    return true;
+}
+
+std::vector<ObjKey> LinkMap::find_origin_keys(Query target_query) const
+{
+    REALM_ASSERT(can_find_origin_keys());
+    TableView matches = target_query.find_all();
+    std::vector<ObjKey> keys;
+    keys.reserve(matches.size());
+    for (size_t i = 0; i < matches.size(); i++)
+        keys.push_back(matches.get_key(i));
+
+    std::unordered_set<ObjKey> origin_keys;
+    for (size_t column = m_link_column_keys.size(); column > 0 && !keys.empty(); column--) {
+        auto origin = m_tables[column - 1];
+        auto target = m_tables[column];
+        auto origin_col = m_link_column_keys[column - 1];
+        origin_keys.clear();
+        if (m_link_types[column - 1] == col_type_BackLink) {
+            // The origin objects are the ones linked to by the matches
+            ColKey link_col_key = origin->get_opposite_column(origin_col);
+            for (auto k : keys) {
+                const Obj o = target->get_object(k);
+                if (link_col_key.is_collection()) {
+                    auto coll = o.get_linkcollection_ptr(link_col_key);
+                    auto sz = coll->size();
+                    for (size_t i = 0; i < sz; i++) {
+                        if (ObjKey x = coll->get_key(i))
+                            origin_keys.insert(x);
+                    }
+                }
+                else if (ObjKey x = o.get<ObjKey>(link_col_key)) {
+                    origin_keys.insert(x);
+                }
+            }
+        }
+        else {
+            for (auto k : keys) {
+                const Obj o = target->get_object(k);
+                auto cnt = o.get_backlink_count(*origin, origin_col);
+                for (size_t i = 0; i < cnt; i++)
+                    origin_keys.insert(o.get_backlink(*origin, origin_col, i));
+            }
+        }
+        keys.assign(origin_keys.begin(), origin_keys.end());
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
 ColumnDictionaryKey Columns<Dictionary>::key(const Mixed& key_value)
 {
     if (m_key_type != type_Mixed && key_value.get_type() != m_key_type) {
@@ -642,6 +642,13 @@ public:
         return {};
     }
 
+    // For a property reached through a chain of links, the same property read
+    // directly in the target table of the chain
+    virtual std::unique_ptr<Subexpr> get_target_column() const
+    {
+        return {};
+    }
+
     virtual DataType get_type() const = 0;
 
     virtual void evaluate(size_t index, ValueBase& destination) = 0;
@@ -1429,6 +1436,19 @@ public:
 
     std::vector<ObjKey> get_origin_ndxs(ObjKey key, size_t column = 0) const;
 
+    // True if every link of the chain can be followed backwards, which is
+    // required by find_origin_keys(). Throws if a link column has been removed.
+    bool can_find_origin_keys() const;
+    // The keys of the objects in the base table from which an object in the
+    // target table matching `target_query` can be reached, sorted. Instead of
+    // following the links of every object in the base table, the query is run
+    // once, and the links of its matches are followed backwards one table at
+    // a time, removing duplicates with a hash set.
+    std::vector<ObjKey> find_origin_keys(Query target_query) const;
+    // The content versions of all the tables of the chain. The result of
+    // find_origin_keys() stays valid as long as none of them change.
+    TableVersions get_content_versions() const;
+
     size_t count_links(size_t row) const
     {
         CountLinks counter;
@@ -1598,6 +1618,13 @@ public:
         return target_table->get_primary_key_column() == m_column_key || target_table->has_search_index(m_column_key);
     }
 
+    std::unique_ptr<Subexpr> get_target_column() const final
+    {
+        if (!links_exist())
+            return {};
+        return make_subexpr<Columns<T>>(m_column_key, m_link_map.get_target_table());
+    }
+
     std::vector<ObjKey> find_all(Mixed value) const final
     {
         std::vector<ObjKey> ret;
@@ -3906,6 +3933,9 @@ public:
             m_index_end = m_matches.size();
             dT = 0;
         }
+        else if (m_left_is_const && init_semi_join()) {
+            dT = 0;
+        }
 
         return dT;
     }
@@ -4032,6 +4062,38 @@ private:
         }
     }
 
+    // Comparing a constant to a property at the end of a chain of links is
+    // done as a semi-join: the condition is evaluated once for all objects in
+    // the target table, and the matching objects of the base table are found
+    // by following the links of the matches backwards. The result is kept
+    // until the content of one of the tables along the links changes, as a
+    // subquery initializes its conditions for every object. Returns false if the condition cannot be
+    // evaluated this way.
+    bool init_semi_join()
+    {
+        auto prop = dynamic_cast<const ObjPropertyBase*>(m_right.get());
+        if (!prop || !prop->links_exist() || m_right->get_comparison_type() != ExpressionComparisonType::Any)
+            return false;
+        // An object whose chain of single links is broken compares as null
+        if (prop->only_unary_links() && TCond()(m_left_value, QueryValue()))
+            return false;
+        LinkMap link_map = prop->get_link_map();
+        if (!link_map.can_find_origin_keys())
+            return false;
+
+        auto content_versions = link_map.get_content_versions();
+        if (!m_has_semi_join_matches || !(content_versions == m_semi_join_versions)) {
+            Query target_query = make_expression<Compare<TCond>>(m_left->clone(), m_right->get_target_column());
+            m_matches = link_map.find_origin_keys(std::move(target_query));
+            m_semi_join_versions = std::move(content_versions);
+            m_has_semi_join_matches = true;
+        }
+        m_has_matches = true;
+        m_index_get = 0;
+        m_index_end = m_matches.size();
+        return true;
+    }
+
     std::unique_ptr<Subexpr> m_left;
     std::unique_ptr<Subexpr> m_right;
     const Cluster* m_cluster;
@@ -4041,6 +4103,8 @@ private:
     std::vector<ObjKey> m_matches;
     mutable size_t m_index_get = 0;
     size_t m_index_end = 0;
+    bool m_has_semi_join_matches = false;
+    TableVersions m_semi_join_versions;
 };
 } // namespace realm
 #endif // REALM_QUERY_EXPRESSION_HPP
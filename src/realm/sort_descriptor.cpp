@@ -21,9 +21,65 @@
 #include <realm/db.hpp>
 #include <realm/util/assert.hpp>
 #include <realm/list.hpp>
+#include <realm/util/parallel_for.hpp>
+
+#include <atomic>
+#include <unordered_set>
 
 using namespace realm;
 
+namespace {
+
+std::atomic<size_t> g_parallel_sort_threshold{0};
+std::atomic<unsigned> g_parallel_sort_threads{0};
+
+// Sort `num_threads` chunks of `v` concurrently and merge them pairwise.
+// `less` must be safe to call from several threads at once.
+void parallel_sort(BaseDescriptor::IndexPairs& v, const BaseDescriptor::Sorter& less, size_t num_threads)
+{
+    std::vector<size_t> bounds(num_threads + 1);
+    for (size_t i = 0; i <= num_threads; ++i)
+        bounds[i] = v.size() * i / num_threads;
+
+    util::parallel_for(num_threads, num_threads, [&](size_t i) {
+        std::sort(v.begin() + bounds[i], v.begin() + bounds[i + 1], std::ref(less));
+    });
+
+    while (bounds.size() > 2) {
+        size_t num_chunks = bounds.size() - 1;
+        util::parallel_for(num_chunks / 2, num_chunks / 2, [&](size_t i) {
+            std::inplace_merge(v.begin() + bounds[2 * i], v.begin() + bounds[2 * i + 1],
+                               v.begin() + bounds[2 * i + 2], std::ref(less));
+        });
+        std::vector<size_t> merged_bounds;
+        for (size_t i = 0; i < bounds.size(); i += 2)
+            merged_bounds.push_back(bounds[i]);
+        if (num_chunks % 2)
+            merged_bounds.push_back(bounds.back());
+        bounds = std::move(merged_bounds);
+    }
+}
+
+} // anonymous namespace
+
+void realm::set_parallel_sort_threshold(size_t min_size, unsigned num_threads) noexcept
+{
+    g_parallel_sort_threshold.store(min_size, std::memory_order_relaxed);
+    g_parallel_sort_threads.store(num_threads, std::memory_order_relaxed);
+}
+
+size_t realm::get_parallel_sort_threads(size_t size) noexcept
+{
+    size_t threshold = g_parallel_sort_threshold.load(std::memory_order_relaxed);
+    if (threshold == 0 || size < threshold)
+        return 1;
+    size_t num_threads = g_parallel_sort_threads.load(std::memory_order_relaxed);
+    if (num_threads == 0)
+        num_threads = util::hardware_thread_count();
+    // Don't bother with threads that would get less than a couple of thousand entries each
+    return std::max<size_t>(1, std::min(num_threads, size / 2048));
+}
+
 LinkPathPart::LinkPathPart(ColKey col_key, ConstTableRef source)
     : column_key(col_key)
     , from(source->get_key())
@@ -205,6 +261,7 @@ BaseDescriptor::Sorter::Sorter(std::vector<std::vector<ColKey>> const& column_li
         }
     }
     m_cache.resize(column_lists.size() - 1);
+    m_cache_size = translated_size;
 }
 
 BaseDescriptor::Sorter DistinctDescriptor::sorter(Table const& table, const IndexPairs& indexes) const
@@ -225,22 +282,71 @@ void DistinctDescriptor::execute(IndexPairs& v, const Sorter& predicate, const B
         v.erase(nulls, v.end());
     }
 
-    // Sort by the columns to distinct on
-    std::sort(v.begin(), v.end(), std::ref(predicate));
+    size_t num_threads = get_parallel_sort_threads(v.size());
+    if (num_threads > 1) {
+        predicate.cache_remaining_columns(v);
+    }
+
+    if (num_threads > 1 && predicate.has_hashable_columns()) {
+        // Keep the entry with the lowest index_in_view among those with equal values
+        std::vector<size_t> hashes(v.size());
+        util::parallel_for(num_threads, num_threads, [&](size_t i) {
+            size_t end = v.size() * (i + 1) / num_threads;
+            for (size_t j = v.size() * i / num_threads; j < end; ++j)
+                hashes[j] = predicate.hash(v[j]);
+        });
+        auto hash = [&](size_t ndx) {
+            return hashes[ndx];
+        };
+        auto equal = [&](size_t a, size_t b) {
+            return !predicate(v[a], v[b], false) && !predicate(v[b], v[a], false);
+        };
+        std::unordered_set<size_t, decltype(hash), decltype(equal)> unique_entries(v.size(), hash, equal);
+        std::vector<bool> keep(v.size());
+        for (size_t i = 0; i < v.size(); ++i) {
+            auto [it, inserted] = unique_entries.insert(i);
+            if (inserted) {
+                keep[i] = true;
+            }
+            else if (v[i].index_in_view < v[*it].index_in_view) {
+                keep[*it] = false;
+                keep[i] = true;
+                unique_entries.erase(it);
+                unique_entries.insert(i);
+            }
+        }
+        size_t kept = 0;
+        for (size_t i = 0; i < v.size(); ++i) {
+            if (keep[i])
+                v[kept++] = v[i];
+        }
+        v.erase(v.begin() + kept, v.end());
+    }
+    else {
+        // Sort by the columns to distinct on
+        if (num_threads > 1) {
+            parallel_sort(v, predicate, num_threads);
+        }
+        else {
+            std::sort(v.begin(), v.end(), std::ref(predicate));
+        }
+
+        // Move duplicates to the back - "not less than" is "equal" since they're sorted
+        auto duplicates = std::unique(v.begin(), v.end(), [&](const IP& a, const IP& b) {
+            return !predicate(a, b, false);
+        });
+        // Erase the duplicates
+        v.erase(duplicates, v.end());
+    }
 
-    // Move duplicates to the back - "not less than" is "equal" since they're sorted
-    auto duplicates = std::unique(v.begin(), v.end(), [&](const IP& a, const IP& b) {
-        return !predicate(a, b, false);
-    });
-    // Erase the duplicates
-    v.erase(duplicates, v.end());
     bool will_be_sorted_next = next && next->get_type() == DescriptorType::Sort;
-    if (!will_be_sorted_next) {
+    auto in_view_order = [](const IP& a, const IP& b) {
+        return a.index_in_view < b.index_in_view;
+    };
+    if (!will_be_sorted_next && !std::is_sorted(v.begin(), v.end(), in_view_order)) {
         // Restore the original order, this is either the original
         // tableview order or the order of the previous sort
-        std::sort(v.begin(), v.end(), [](const IP& a, const IP& b) {
-            return a.index_in_view < b.index_in_view;
-        });
+        std::sort(v.begin(), v.end(), in_view_order);
     }
 }
 
@@ -252,7 +358,26 @@ BaseDescriptor::Sorter SortDescriptor::sorter(Table const& table, const IndexPai
 
 void SortDescriptor::execute(IndexPairs& v, const Sorter& predicate, const BaseDescriptor* next) const
 {
-    std::sort(v.begin(), v.end(), std::ref(predicate));
+    // If the sort is immediately followed by a limit, only the first 'limit' entries
+    // need to be put in order. The limit descriptor will discard the rest.
+    size_t limit = size_t(-1);
+    if (next && next->get_type() == DescriptorType::Limit) {
+        limit = static_cast<const LimitDescriptor*>(next)->get_limit();
+    }
+
+    size_t num_threads = get_parallel_sort_threads(v.size());
+    if (limit < v.size() / num_threads) {
+        // The predicate imposes a total ordering, so the result is identical
+        // to sorting everything and then truncating.
+        std::partial_sort(v.begin(), v.begin() + limit, v.end(), std::ref(predicate));
+    }
+    else if (num_threads > 1) {
+        predicate.cache_remaining_columns(v);
+        parallel_sort(v, predicate, num_threads);
+    }
+    else {
+        std::sort(v.begin(), v.end(), std::ref(predicate));
+    }
 
     // not doing this on the last step is an optimisation
     if (next) {
@@ -312,31 +437,7 @@ bool BaseDescriptor::Sorter::operator()(IndexPair i, IndexPair j, bool total_ord
             c = i.cached_value.compare(j.cached_value);
         }
         else {
-            if (m_cache[t - 1].empty()) {
-                m_cache[t - 1].resize(256);
-            }
-            ObjKey key_i = i.key_for_object;
-            ObjKey key_j = j.key_for_object;
-
-            if (!m_columns[t].translated_keys.empty()) {
-                key_i = m_columns[t].translated_keys[i.index_in_view];
-                key_j = m_columns[t].translated_keys[j.index_in_view];
-            }
-            ObjCache& cache_i = m_cache[t - 1][key_i.value & 0xFF];
-            ObjCache& cache_j = m_cache[t - 1][key_j.value & 0xFF];
-
-            if (cache_i.key != key_i) {
-                cache_i.value = m_columns[t].table->get_object(key_i).get_any(m_columns[t].col_key);
-                cache_i.key = key_i;
-            }
-            Mixed val_i = cache_i.value;
-
-            if (cache_j.key != key_j) {
-                cache_j.value = m_columns[t].table->get_object(key_j).get_any(m_columns[t].col_key);
-                cache_j.key = key_j;
-            }
-
-            c = val_i.compare(cache_j.value);
+            c = get_cached_value(t, i).compare(get_cached_value(t, j));
         }
         // if c is negative i comes before j
         if (c) {
@@ -347,6 +448,64 @@ bool BaseDescriptor::Sorter::operator()(IndexPair i, IndexPair j, bool total_ord
     return total_ordering ? i.index_in_view < j.index_in_view : 0;
 }
 
+Mixed BaseDescriptor::Sorter::get_cached_value(size_t t, IndexPair i) const
+{
+    ValueCache& cache = m_cache[t - 1];
+    if (cache.values.empty()) {
+        cache.values.resize(m_cache_size);
+        cache.is_cached.resize(m_cache_size);
+    }
+    size_t ndx = i.index_in_view;
+    if (!cache.is_cached[ndx]) {
+        const SortColumn& col = m_columns[t];
+        ObjKey key = col.translated_keys.empty() ? i.key_for_object : col.translated_keys[ndx];
+        cache.values[ndx] = col.table->get_object(key).get_any(col.col_key);
+        cache.is_cached[ndx] = true;
+    }
+    return cache.values[ndx];
+}
+
+void BaseDescriptor::Sorter::cache_remaining_columns(const IndexPairs& v) const
+{
+    for (size_t t = 1; t < m_columns.size(); ++t) {
+        auto& is_null = m_columns[t].is_null;
+        for (auto& index : v) {
+            if (is_null.empty() || !is_null[index.index_in_view])
+                get_cached_value(t, index);
+        }
+    }
+}
+
+bool BaseDescriptor::Sorter::has_hashable_columns() const
+{
+    return std::all_of(m_columns.begin(), m_columns.end(), [](auto&& col) {
+        switch (col.col_key.get_type()) {
+            case col_type_Int:
+            case col_type_Bool:
+            case col_type_String:
+            case col_type_Timestamp:
+            case col_type_ObjectId:
+            case col_type_UUID:
+                return true;
+            default:
+                // Floating point values and Mixed may compare equal with different
+                // representations, and links and decimals can't be hashed.
+                return false;
+        }
+    });
+}
+
+size_t BaseDescriptor::Sorter::hash(IndexPair i) const
+{
+    size_t h = i.cached_value.hash();
+    for (size_t t = 1; t < m_columns.size(); ++t) {
+        if (!m_columns[t].is_null.empty() && m_columns[t].is_null[i.index_in_view])
+            continue;
+        h ^= get_cached_value(t, i).hash() + 0x9e3779b9 + (h << 6) + (h >> 2);
+    }
+    return h;
+}
+
 void BaseDescriptor::Sorter::cache_first_column(IndexPairs& v)
 {
     if (m_columns.empty())
@@ -359,12 +518,12 @@ void BaseDescriptor::Sorter::cache_first_column(IndexPairs& v)
         ObjKey key = index.key_for_object;
 
         if (!col.translated_keys.empty()) {
-            if (col.is_null[i]) {
+            if (col.is_null[index.index_in_view]) {
                 index.cached_value = Mixed();
                 continue;
             }
             else {
-                key = col.translated_keys[v[i].index_in_view];
+                key = col.translated_keys[index.index_in_view];
             }
         }
 
@@ -34,6 +34,17 @@ class Group;
 
 enum class DescriptorType { Sort, Distinct, Limit };
 
+/// Sort and distinct on views with at least `min_size` entries, and the
+/// building of search indexes on tables with at least `min_size` objects, will
+/// be spread over `num_threads` threads (0 means the number of hardware
+/// threads). A `min_size` of zero, which is the default, disables
+/// multi-threaded execution.
+void set_parallel_sort_threshold(size_t min_size, unsigned num_threads = 0) noexcept;
+
+/// The number of threads to use for sorting `size` entries according to the
+/// setting above.
+size_t get_parallel_sort_threads(size_t size) noexcept;
+
 struct LinkPathPart {
     // Constructor for forward links
     LinkPathPart(ColKey col_key)
@@ -95,6 +106,13 @@ public:
             });
         }
         void cache_first_column(IndexPairs& v);
+        // Fetch the values of all but the first column up front. After this the
+        // predicate no longer modifies any state, and can be used from several
+        // threads at once.
+        void cache_remaining_columns(const IndexPairs& v) const;
+        // True if equal values are guaranteed to have the same Mixed::hash()
+        bool has_hashable_columns() const;
+        size_t hash(IndexPair i) const;
 
     private:
         struct SortColumn {
@@ -112,12 +130,16 @@ public:
             bool ascending;
         };
         std::vector<SortColumn> m_columns;
-        struct ObjCache {
-            ObjKey key;
-            Mixed value;
+        // Values of the secondary sort columns. They are only needed when the preceding
+        // columns compare equal, so they are fetched on demand, but at most once per entry.
+        struct ValueCache {
+            std::vector<Mixed> values;
+            std::vector<bool> is_cached;
         };
-        using TableCache = std::vector<ObjCache>;
-        mutable std::vector<TableCache> m_cache;
+        mutable std::vector<ValueCache> m_cache;
+        size_t m_cache_size = 0;
+
+        Mixed get_cached_value(size_t t, IndexPair i) const;
 
         friend class ObjList;
     };
@@ -168,6 +168,8 @@ ColKey Spec::update_colkey(ColKey existing_key, size_t spec_ndx, TableKey table_
     // index and uniqueness are not passed on to the key, so clear them
     attr.reset(col_attr_Indexed);
     attr.reset(col_attr_Unique);
+    attr.reset(col_attr_FullText_Indexed);
+    attr.reset(col_attr_Trigram_Indexed);
     auto type = get_column_type(spec_ndx);
     if (existing_key.get_type() != type || existing_key.get_attrs() != attr) {
         unsigned upper = unsigned(table_key.value);
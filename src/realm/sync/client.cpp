@@ -239,6 +239,7 @@ private:
     util::Optional<ClientReset> m_client_reset_config;
 
     util::Optional<ProxyConfig> m_proxy_config;
+    const size_t m_flx_bootstrap_batch_size_bytes;
 
     util::UniqueFunction<SyncTransactCallback> m_sync_transact_handler;
     util::UniqueFunction<ProgressHandler> m_progress_handler;
@@ -768,7 +769,6 @@ bool SessionImpl::process_flx_bootstrap_message(const SyncProgress& progress, Do
 
 void SessionImpl::process_pending_flx_bootstrap()
 {
-    constexpr size_t batch_size_in_bytes = 1024 * 1024;
     if (!m_is_flx_sync_session) {
         return;
     }
@@ -782,7 +782,7 @@ void SessionImpl::process_pending_flx_bootstrap()
     int64_t query_version = -1;
     try {
         while (bootstrap_store->has_pending()) {
-            auto pending_batch = bootstrap_store->peek_pending(batch_size_in_bytes);
+            auto pending_batch = bootstrap_store->peek_pending(m_wrapper.m_flx_bootstrap_batch_size_bytes);
             if (!pending_batch.progress) {
                 logger.info("Incomplete pending bootstrap found for query version %1", pending_batch.query_version);
                 bootstrap_store->clear();
@@ -885,6 +885,7 @@ SessionWrapper::SessionWrapper(ClientImpl& client, DBRef db, std::shared_ptr<Sub
     , m_signed_access_token{std::move(config.signed_user_token)}
     , m_client_reset_config{std::move(config.client_reset_config)}
     , m_proxy_config{config.proxy_config} // Throws
+    , m_flx_bootstrap_batch_size_bytes{config.flx_bootstrap_batch_size_bytes}
     , m_on_download_message_received_hook(std::move(config.on_download_message_received_hook))
     , m_on_bootstrap_message_processed_hook(config.on_bootstrap_message_processed_hook)
     , m_flx_subscription_store(std::move(flx_sub_store))
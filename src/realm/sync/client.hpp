@@ -307,6 +307,13 @@ public:
 
         util::Optional<SyncConfig::ProxyConfig> proxy_config;
 
+        /// The approximate number of bytes of changesets that are integrated
+        /// per write transaction when applying a completed FLX bootstrap from
+        /// the pending bootstrap store. The bootstrap is applied in as many
+        /// transactions as needed, and the query version is not reported as
+        /// complete until the last of them has been committed.
+        size_t flx_bootstrap_batch_size_bytes = 1024 * 1024;
+
         /// Set to true to cause the integration of the first received changeset
         /// (in a DOWNLOAD message) to fail.
         ///
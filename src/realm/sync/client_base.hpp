@@ -279,6 +279,13 @@ struct ClientConfig {
     /// consumption.
     bool disable_upload_compaction = false;
 
+    /// If `enable_permessage_deflate` is true, the client offers the
+    /// permessage-deflate WebSocket extension when connecting. If the server
+    /// accepts it, larger messages are compressed in both directions. This
+    /// mostly benefits messages that the sync protocol does not already
+    /// compress, such as UPLOAD messages with many small changesets.
+    bool enable_permessage_deflate = false;
+
     /// The specified function will be called whenever a PONG message is
     /// received on any connection. The round-trip time in milliseconds will
     /// be pased to the function. The specified function will always be
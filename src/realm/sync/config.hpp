@@ -170,6 +170,11 @@ struct SyncConfig {
     // If true, upload/download waits are canceled on any sync error and not just fatal ones
     bool cancel_waits_on_nonfatal_error = false;
 
+    // The approximate number of bytes of changesets from a completed FLX bootstrap that are integrated in a single
+    // write transaction. A smaller value lowers the peak memory usage and how long the write lock is held at a time,
+    // at the cost of more commits. At least one changeset is always integrated per transaction.
+    size_t flx_bootstrap_batch_size_bytes = 1024 * 1024;
+
     // If false, changesets incoming from the server are discarded without
     // applying them to the Realm file. This is required when writing objects
     // directly to replication, and will break horribly otherwise
@@ -168,6 +168,7 @@ void InstructionApplier::operator()(const Instruction::EraseTable& instr)
 
     log("sync::erase_table(m_group, \"%1\")", table_name);
     m_transaction.remove_table(table_name);
+    invalidate_caches();
 }
 
 void InstructionApplier::operator()(const Instruction::CreateObject& instr)
@@ -256,6 +257,7 @@ void InstructionApplier::operator()(const Instruction::EraseObject& instr)
         obj->invalidate();
     }
     m_last_object.reset();
+    m_last_list.reset();
 }
 
 template <class F>
@@ -296,16 +298,7 @@ void InstructionApplier::visit_payload(const Instruction::Payload& payload, F&&
         case Type::Decimal:
             return visitor(data.decimal);
         case Type::Link: {
-            StringData class_name = get_string(data.link.target_table);
-            Group::TableNameBuffer buffer;
-            StringData target_table_name = Group::class_name_to_table_name(class_name, buffer);
-            TableRef target_table = m_transaction.get_table(target_table_name);
-            if (!target_table) {
-                bad_transaction_log("Link with invalid target table '%1'", target_table_name);
-            }
-            if (target_table->is_embedded()) {
-                bad_transaction_log("Link to embedded table '%1'", target_table_name);
-            }
+            TableRef target_table = get_link_target_table(data.link.target_table);
             ObjKey target = get_object_key(*target_table, data.link.target);
             ObjLink link = ObjLink{target_table->get_key(), target};
             return visitor(link);
@@ -653,6 +646,7 @@ void InstructionApplier::operator()(const Instruction::EraseColumn& instr)
     }
 
     table->remove_column(col);
+    invalidate_caches();
 }
 
 void InstructionApplier::operator()(const Instruction::ArrayInsert& instr)
@@ -918,16 +912,7 @@ bool InstructionApplier::check_links_exist(const Instruction::Payload& payload)
     bool valid_payload = true;
     using Type = Instruction::Payload::Type;
     if (payload.type == Type::Link) {
-        StringData class_name = get_string(payload.data.link.target_table);
-        Group::TableNameBuffer buffer;
-        StringData target_table_name = Group::class_name_to_table_name(class_name, buffer);
-        TableRef target_table = m_transaction.get_table(target_table_name);
-        if (!target_table) {
-            bad_transaction_log("Link with invalid target table '%1'", target_table_name);
-        }
-        if (target_table->is_embedded()) {
-            bad_transaction_log("Link to embedded table '%1'", target_table_name);
-        }
+        TableRef target_table = get_link_target_table(payload.data.link.target_table);
         Mixed linked_pk =
             mpark::visit(util::overload{[&](mpark::monostate) {
                                             return Mixed{}; // the link exists and the pk is null
@@ -1138,21 +1123,75 @@ TableRef InstructionApplier::get_table(const Instruction::TableInstruction& inst
         return m_last_table;
     }
     else {
-        auto table_name = get_table_name(instr, name);
-        TableRef table = m_transaction.get_table(table_name);
+        TableRef table = find_table(instr.table);
         if (!table) {
-            bad_transaction_log("%1: Table '%2' does not exist", name, table_name);
+            bad_transaction_log("%1: Table '%2' does not exist", name, get_table_name(instr, name));
         }
         m_last_table = table;
         m_last_table_name = instr.table;
         m_last_object_key.reset();
         m_last_object.reset();
+        m_last_list.reset();
         m_last_field_name = InternString{};
         m_last_field = ColKey{};
         return table;
     }
 }
 
+TableRef InstructionApplier::find_table(InternString class_name)
+{
+    if (class_name.value < m_table_cache.size() && m_table_cache[class_name.value]) {
+        return m_table_cache[class_name.value];
+    }
+    StringData table_name = Group::class_name_to_table_name(get_string(class_name), m_table_name_buffer);
+    TableRef table = m_transaction.get_table(table_name);
+    if (table) {
+        // get_string() has verified that the intern string is valid for this changeset
+        if (class_name.value >= m_table_cache.size())
+            m_table_cache.resize(class_name.value + 1);
+        m_table_cache[class_name.value] = table;
+    }
+    return table;
+}
+
+TableRef InstructionApplier::get_link_target_table(InternString class_name)
+{
+    TableRef target_table = find_table(class_name);
+    if (!target_table) {
+        Group::TableNameBuffer buffer;
+        bad_transaction_log("Link with invalid target table '%1'",
+                            Group::class_name_to_table_name(get_string(class_name), buffer));
+    }
+    if (target_table->is_embedded()) {
+        bad_transaction_log("Link to embedded table '%1'", target_table->get_name());
+    }
+    return target_table;
+}
+
+ColKey InstructionApplier::find_column(const Table& table, InternString field)
+{
+    uint64_t cache_key = (uint64_t(table.get_key().value) << 32) | field.value;
+    auto it = m_column_cache.find(cache_key);
+    if (it != m_column_cache.end()) {
+        return it->second;
+    }
+    ColKey col = table.get_column_key(get_string(field));
+    if (col) {
+        m_column_cache.emplace(cache_key, col);
+    }
+    return col;
+}
+
+void InstructionApplier::invalidate_caches()
+{
+    m_table_cache.clear();
+    m_column_cache.clear();
+    m_last_table_name = InternString{};
+    m_last_table = TableRef{};
+    m_last_object.reset();
+    m_last_list.reset();
+}
+
 util::Optional<Obj> InstructionApplier::get_top_object(const Instruction::ObjectInstruction& instr,
                                                        const std::string_view& name)
 {
@@ -1311,7 +1350,7 @@ InstructionApplier::PathResolver::Status InstructionApplier::PathResolver::resol
 InstructionApplier::PathResolver::Status InstructionApplier::PathResolver::resolve_field(Obj& obj, InternString field)
 {
     auto field_name = get_string(field);
-    ColKey col = obj.get_table()->get_column_key(field_name);
+    ColKey col = m_applier->find_column(*obj.get_table(), field);
     if (!col) {
         on_error(util::format("%1: No such field: '%2' in class '%3'", m_instr_name, field_name,
                               obj.get_table()->get_name()));
@@ -1347,7 +1386,13 @@ InstructionApplier::PathResolver::Status InstructionApplier::PathResolver::resol
 
     if (col.is_list()) {
         if (auto pindex = mpark::get_if<uint32_t>(&*m_it_begin)) {
-            std::unique_ptr<LstBase> list = InstructionApplier::get_list_from_path(obj, col);
+            // Consecutive instructions often target elements of the same list, so
+            // keep the accessor around rather than recreating it every time.
+            auto& list = m_applier->m_last_list;
+            if (!list || list->get_col_key() != col || list->get_owner_key() != obj.get_key() ||
+                list->get_table() != obj.get_table()) {
+                list = InstructionApplier::get_list_from_path(obj, col);
+            }
             ++m_it_begin;
             return resolve_list_element(*list, *pindex);
         }
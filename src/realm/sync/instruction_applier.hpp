@@ -26,6 +26,7 @@
 #include <realm/dictionary.hpp>
 
 #include <tuple>
+#include <unordered_map>
 
 namespace realm {
 namespace sync {
@@ -133,8 +134,20 @@ private:
     util::Optional<Obj> m_last_object;
     std::unique_ptr<LstBase> m_last_list;
 
+    // Resolved tables and columns for the changeset being applied. Tables are
+    // indexed by the intern string of the class name, and columns by the table
+    // key and the intern string of the field name.
+    std::vector<TableRef> m_table_cache;
+    std::unordered_map<uint64_t, ColKey> m_column_cache;
+
     StringData get_table_name(const Instruction::TableInstruction&, const std::string_view& instr = "(unspecified)");
     TableRef get_table(const Instruction::TableInstruction&, const std::string_view& instr = "(unspecified)");
+    // Returns a null ref if the table does not exist
+    TableRef find_table(InternString class_name);
+    TableRef get_link_target_table(InternString class_name);
+    // Returns a null key if the column does not exist
+    ColKey find_column(const Table&, InternString field);
+    void invalidate_caches();
 
     // Note: This may return a non-invalid ObjKey if the key is dangling.
     ObjKey get_object_key(Table& table, const Instruction::PrimaryKey&,
@@ -173,6 +186,8 @@ inline void InstructionApplier::end_apply() noexcept
     m_last_object.reset();
     m_last_object_key.reset();
     m_last_list.reset();
+    m_table_cache.clear();
+    m_column_cache.clear();
 }
 
 template <class A>
@@ -123,6 +123,7 @@ ClientImpl::ClientImpl(ClientConfig config)
           m_random,
           m_service,
           get_user_agent_string(),
+          config.enable_permessage_deflate,
       })
     , m_client_protocol{} // Throws
     , m_one_connection_per_session{config.one_connection_per_session}
@@ -156,6 +157,8 @@ ClientImpl::ClientImpl(ClientConfig config)
                  config.fast_reconnect_limit); // Throws
     logger.debug("Config param: disable_upload_compaction = %1",
                  config.disable_upload_compaction); // Throws
+    logger.debug("Config param: enable_permessage_deflate = %1",
+                 config.enable_permessage_deflate); // Throws
     logger.debug("Config param: disable_sync_to_disk = %1",
                  config.disable_sync_to_disk); // Throws
     logger.debug("User agent string: '%1'", get_user_agent_string());
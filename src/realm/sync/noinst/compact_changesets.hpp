@@ -10,14 +10,20 @@ namespace _impl {
 /// Compact changesets by removing redundant instructions.
 ///
 /// Instructions considered for removal:
-///   - Set
-///   - CreateObject
-///   - EraseObject
+///   - Update, when followed by another Update of the same path into the same
+///     field of the same object, with no other instruction touching the field
+///     in between, and when the later one wins over it in any merge.
+///   - Update, when the object is erased later on.
 ///
 /// Instructions not (yet) considered for removal:
+///   - CreateObject
+///   - EraseObject
 ///   - AddInteger
-///   - ContainerInsert
-///   - ContainerSet
+///   - ArrayInsert, ArrayMove, ArrayErase, Clear, SetInsert, SetErase
+///
+/// This is done in a single pass over the instructions, looking up the
+/// previous Update of each field in a hash map keyed by class, object, and
+/// field.
 ///
 /// NOTE: All changesets are considered, in the sense that an instruction from
 /// and earlier changeset being made redundant by a different instruction in a
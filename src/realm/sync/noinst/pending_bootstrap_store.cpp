@@ -248,6 +248,7 @@ PendingBootstrapStore::PendingBatch PendingBootstrapStore::peek_pending(size_t l
             cur_changeset.get<int64_t>(m_changeset_last_integrated_client_version);
         parsed_changeset.data = BinaryData(uncompressed_buffer.data(), uncompressed_buffer.size());
         ret.changesets.push_back(std::move(parsed_changeset));
+        bytes_so_far += uncompressed_buffer.size();
     }
     ret.remaining = changeset_list.size() - ret.changesets.size();
 
@@ -272,9 +273,7 @@ void PendingBootstrapStore::pop_front_pending(const TransactionRef& tr, size_t c
         changeset_list.clear();
     }
     else {
-        for (size_t idx = 0; idx < count; ++idx) {
-            changeset_list.remove(0);
-        }
+        changeset_list.remove(0, count);
     }
 
     if (changeset_list.is_empty()) {
@@ -203,6 +203,23 @@ void ServerProtocol::make_download_message(int protocol_version, OutputBuffer& o
                                            const char* body, std::size_t uncompressed_body_size,
                                            std::size_t compressed_body_size, bool body_is_compressed,
                                            util::Logger& logger)
+{
+    make_download_message_header(protocol_version, out, session_ident, download_server_version,
+                                 download_client_version, latest_server_version, latest_server_version_salt,
+                                 upload_client_version, upload_server_version, downloadable_bytes, num_changesets,
+                                 uncompressed_body_size, compressed_body_size, body_is_compressed, logger); // Throws
+
+    std::size_t body_size = (body_is_compressed ? compressed_body_size : uncompressed_body_size);
+    out.write(body, body_size);
+}
+
+
+void ServerProtocol::make_download_message_header(
+    int protocol_version, OutputBuffer& out, session_ident_type session_ident, version_type download_server_version,
+    version_type download_client_version, version_type latest_server_version, salt_type latest_server_version_salt,
+    version_type upload_client_version, version_type upload_server_version, std::uint_fast64_t downloadable_bytes,
+    std::size_t num_changesets, std::size_t uncompressed_body_size, std::size_t compressed_body_size,
+    bool body_is_compressed, util::Logger& logger)
 {
     static_cast<void>(protocol_version);
     // The header of the download message.
@@ -211,9 +228,6 @@ void ServerProtocol::make_download_message(int protocol_version, OutputBuffer& o
         << upload_server_version << " " << downloadable_bytes << " " << int(body_is_compressed) << " "
         << uncompressed_body_size << " " << compressed_body_size << "\n"; // Throws
 
-    std::size_t body_size = (body_is_compressed ? compressed_body_size : uncompressed_body_size);
-    out.write(body, body_size);
-
     logger.detail("Sending: DOWNLOAD(download_server_version=%1, download_client_version=%2, "
                   "latest_server_version=%3, latest_server_version_salt=%4, "
                   "upload_client_version=%5, upload_server_version=%6, "
@@ -526,6 +526,17 @@ public:
                                std::size_t uncompressed_body_size, std::size_t compressed_body_size,
                                bool body_is_compressed, util::Logger&);
 
+    /// Same as make_download_message(), but leaves out the body, which the
+    /// caller must then send immediately after the header as part of the same
+    /// message.
+    void make_download_message_header(int protocol_version, OutputBuffer&, session_ident_type session_ident,
+                                      version_type download_server_version, version_type download_client_version,
+                                      version_type latest_server_version, salt_type latest_server_version_salt,
+                                      version_type upload_client_version, version_type upload_server_version,
+                                      std::uint_fast64_t downloadable_bytes, std::size_t num_changesets,
+                                      std::size_t uncompressed_body_size, std::size_t compressed_body_size,
+                                      bool body_is_compressed, util::Logger&);
+
     void make_mark_message(OutputBuffer&, session_ident_type session_ident, request_ident_type request_ident);
 
     void make_error_message(int protocol_version, OutputBuffer&, sync::ProtocolError error_code, const char* message,
@@ -47,7 +47,9 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <functional>
+#include <list>
 #include <locale>
 #include <map>
 #include <memory>
@@ -55,6 +57,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <thread>
+#include <tuple>
 #include <vector>
 
 // NOTE: The protocol specification is in `/doc/protocol.md`
@@ -191,6 +194,7 @@ bool determine_try_again(ProtocolError error_code) noexcept
 
 class ServerFile;
 class ServerImpl;
+class Worker;
 class HTTPConnection;
 class SyncConnection;
 class Session;
@@ -219,17 +223,93 @@ public:
 };
 
 
-struct DownloadCache {
-    std::unique_ptr<char[]> body;
-    std::size_t uncompressed_body_size;
-    std::size_t compressed_body_size;
-    bool body_is_compressed;
-    version_type end_version;
-    DownloadCursor download_progress;
-    std::uint_fast64_t downloadable_bytes;
-    std::size_t num_changesets;
-    std::size_t accum_original_size;
-    std::size_t accum_compacted_size;
+// Least recently used cache of DOWNLOAD message bodies, keyed by the range of
+// the history they were produced from.
+class DownloadCache {
+public:
+    struct Key {
+        DownloadCursor download_progress;
+        version_type end_version;
+        std::size_t max_download_size;
+
+        bool operator<(const Key& other) const noexcept
+        {
+            return std::tie(download_progress.server_version, download_progress.last_integrated_client_version,
+                            end_version, max_download_size) <
+                   std::tie(other.download_progress.server_version,
+                            other.download_progress.last_integrated_client_version, other.end_version,
+                            other.max_download_size);
+        }
+    };
+
+    struct Entry {
+        // Shared with the connections that are in the process of sending it
+        std::shared_ptr<char[]> body;
+        std::size_t uncompressed_body_size;
+        std::size_t compressed_body_size;
+        bool body_is_compressed;
+        DownloadCursor download_progress;
+        std::uint_fast64_t downloadable_bytes;
+        std::size_t num_changesets;
+        std::size_t accum_original_size;
+        std::size_t accum_compacted_size;
+
+        std::size_t body_size() const noexcept
+        {
+            return (body_is_compressed ? compressed_body_size : uncompressed_body_size);
+        }
+    };
+
+    // Returns null if there is no entry for the specified key
+    const Entry* find(const Key& key) noexcept
+    {
+        auto i = m_index.find(key);
+        if (i == m_index.end())
+            return nullptr;
+        m_entries.splice(m_entries.begin(), m_entries, i->second);
+        return &i->second->second;
+    }
+
+    // Discards the least recently used entries until the new entry fits within
+    // `max_total_size`, or no other entries remain.
+    void insert(const Key& key, Entry entry, std::size_t max_total_size)
+    {
+        if (auto i = m_index.find(key); i != m_index.end())
+            erase(i);
+        std::size_t size = entry.body_size();
+        while (!m_entries.empty() && m_total_size + size > max_total_size)
+            erase(m_index.find(m_entries.back().first));
+        m_entries.emplace_front(key, std::move(entry)); // Throws
+        m_index.emplace(key, m_entries.begin());        // Throws
+        m_total_size += size;
+    }
+
+    // Discards all entries produced from the specified start position. This is
+    // used to release a large bootstrap body before a new one is generated.
+    void discard(DownloadCursor download_progress) noexcept
+    {
+        auto i = m_index.lower_bound(Key{download_progress, 0, 0});
+        while (i != m_index.end() &&
+               i->first.download_progress.server_version == download_progress.server_version &&
+               i->first.download_progress.last_integrated_client_version ==
+                   download_progress.last_integrated_client_version)
+            i = erase(i);
+    }
+
+private:
+    using List = std::list<std::pair<Key, Entry>>;
+    using Index = std::map<Key, List::iterator>;
+
+    List m_entries;
+    Index m_index;
+    std::size_t m_total_size = 0;
+
+    Index::iterator erase(Index::iterator i) noexcept
+    {
+        m_total_size -= i->second->second.body_size();
+        m_entries.erase(i->second);
+        return m_index.erase(i);
+    }
 };
 
 
@@ -432,8 +512,8 @@ public:
     // Logger to be used by the worker thread
     util::PrefixLogger wlogger;
 
-    ServerFile(ServerImpl& server, ServerFileAccessCache& cache, const std::string& virt_path, std::string real_path,
-               bool disable_sync_to_disk);
+    ServerFile(ServerImpl& server, ServerFileAccessCache& cache, Worker& worker, const std::string& virt_path,
+               std::string real_path, bool disable_sync_to_disk);
     ~ServerFile() noexcept;
 
     void initialize();
@@ -464,6 +544,13 @@ public:
         return m_worker_file.access(); // Throws
     }
 
+    // Start opening the file in the background if it is not open, because a
+    // session will need it soon.
+    void prefetch()
+    {
+        m_file.prefetch(); // Throws
+    }
+
     version_type get_realm_version() const noexcept
     {
         return m_version_info.realm_version;
@@ -534,10 +621,22 @@ public:
     // NOTE: This function is executed by the worker thread
     void worker_process_work_unit(WorkerState&);
 
+    // Run one pass of incremental history compaction. Returns true if more
+    // passes are needed.
+    //
+    // NOTE: This function is executed by the worker thread
+    bool worker_compact_history();
+
     void recognize_external_change();
 
 private:
     ServerImpl& m_server;
+
+    // The worker that integrates changes into this file. All work units of a
+    // file are processed by the same worker, so they are serialized, and the
+    // file uses the file access cache of that worker.
+    Worker& m_worker;
+
     ServerFileAccessCache::Slot m_file;
 
     // In general, `m_version_info` refers to the last snapshot of the Realm
@@ -639,6 +738,10 @@ private:
     // (group_postprocess_stage_3()). Always zero for partial files.
     bool m_has_work_in_progress = 0;
 
+    // Set while the file is in the compaction queue of the worker. Must only
+    // be accessed by the worker thread.
+    bool m_worker_compaction_scheduled = false;
+
     // This one must only be accessed by the worker thread.
     //
     // More specifically, `m_worker_file.access()` must only be called by the
@@ -691,6 +794,8 @@ private:
     // Overriding member functions in CompactionControl
     LastClientAccessesRange get_last_client_accesses() override final;
     version_type get_max_compactable_server_version() override final;
+
+    friend class Worker;
 };
 
 
@@ -718,22 +823,38 @@ inline void ServerFile::group_finalize_work_stage_2()
 // blocked waiting for the worker thread to end a long running write
 // transaction.
 //
+// There are `Server::Config::num_workers` workers, each running its own
+// thread. A Realm file is served by the same worker for the life of the
+// server, so a worker's file access cache and history context are only ever
+// used by its own thread.
+//
 // FIXME: Currently, the event loop thread does perform a number of write
 // transactions, but only on subtier nodes of a star topology server cluster.
 class Worker : public ServerHistory::Context {
 public:
     util::PrefixLogger logger;
 
-    explicit Worker(ServerImpl&);
+    Worker(ServerImpl&, int index);
 
     ServerFileAccessCache& get_file_access_cache() noexcept;
 
     void enqueue(ServerFile*);
 
+    // Schedule an incremental history compaction of the specified file for
+    // when this worker is idle.
+    //
+    // NOTE: This function must only be called by the worker thread.
+    void schedule_compaction(ServerFile*);
+
+    // Thread-safe
+    Server::WorkerQueueMetrics get_queue_metrics();
+
     // Overriding members of ServerHistory::Context
     std::mt19937_64& server_history_get_random() noexcept override final;
     bool get_compaction_params(bool&, std::chrono::seconds&, std::chrono::seconds&) noexcept override final;
     Clock::time_point get_compaction_clock_now() const noexcept override final;
+    std::chrono::milliseconds get_compaction_time_budget() const noexcept override final;
+    std::size_t get_history_block_size() const noexcept override final;
     sync::Transformer& get_transformer() override final;
     util::Buffer<char>& get_transform_buffer() override final;
 
@@ -751,8 +872,15 @@ private:
 
     util::CircularBuffer<ServerFile*> m_queue; // Protected by `m_mutex`
 
+    std::size_t m_max_queue_depth = 0;       // Protected by `m_mutex`
+    std::uint_fast64_t m_num_work_units = 0; // Protected by `m_mutex`
+
     WorkerState m_state;
 
+    // Files with unfinished incremental history compaction. Only accessed by
+    // the worker thread.
+    std::deque<ServerFile*> m_compaction_queue;
+
     void run();
     void stop() noexcept;
 
@@ -849,11 +977,17 @@ public:
         return m_scratch_memory;
     }
 
-    Worker& get_worker() noexcept
+    // Returns the worker to which the next new file is assigned. Files are
+    // assigned to the workers in turn.
+    Worker& assign_worker() noexcept
     {
-        return m_worker;
+        Worker& worker = *m_workers[m_next_worker];
+        m_next_worker = (m_next_worker + 1) % m_workers.size();
+        return worker;
     }
 
+    std::vector<Server::WorkerQueueMetrics> get_worker_queue_metrics();
+
     void get_workunit_timers(milliseconds_type& parallel_section, milliseconds_type& sequential_section)
     {
         parallel_section = m_par_time;
@@ -922,8 +1056,8 @@ public:
         m_realm_names.insert(virt_path);          // Throws
         {
             bool disable_sync_to_disk = m_config.disable_sync_to_disk;
-            file.reset(new ServerFile(*this, m_file_access_cache, virt_path, virt_path_components.real_realm_path,
-                                      disable_sync_to_disk)); // Throws
+            file.reset(new ServerFile(*this, m_file_access_cache, assign_worker(), virt_path,
+                                      virt_path_components.real_realm_path, disable_sync_to_disk)); // Throws
         }
 
         file->initialize();
@@ -1024,7 +1158,8 @@ private:
 
     std::unique_ptr<util::network::ssl::Context> m_ssl_context;
     ServerFileAccessCache m_file_access_cache;
-    Worker m_worker;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::size_t m_next_worker = 0;
     std::map<std::string, util::bind_ptr<ServerFile>> m_files; // Key is virtual path
     util::network::Acceptor m_acceptor;
     std::int_fast64_t m_next_conn_id = 0;
@@ -1072,6 +1207,17 @@ private:
         return config.max_upload_backlog;
     }
 
+    static std::vector<std::unique_ptr<Worker>> make_workers(ServerImpl& server, int num_workers)
+    {
+        if (num_workers < 1)
+            throw std::runtime_error("The number of workers must be at least one.");
+        std::vector<std::unique_ptr<Worker>> workers;
+        workers.reserve(num_workers); // Throws
+        for (int i = 0; i < num_workers; ++i)
+            workers.push_back(std::make_unique<Worker>(server, i)); // Throws
+        return workers;
+    }
+
     static ProtocolVersionRange determine_protocol_version_range(Server::Config& config)
     {
         const int actual_min = ServerImplBase::get_oldest_supported_protocol_version();
@@ -1102,7 +1248,7 @@ public:
     SyncConnection(ServerImpl& serv, std::int_fast64_t id, std::unique_ptr<util::network::Socket>&& socket,
                    std::unique_ptr<util::network::ssl::Stream>&& ssl_stream,
                    std::unique_ptr<util::network::ReadAheadBuffer>&& read_ahead_buffer, int client_protocol_version,
-                   std::string client_user_agent, std::string remote_endpoint)
+                   std::string client_user_agent, std::string remote_endpoint, bool permessage_deflate)
         : logger{make_logger_prefix(id), serv.logger} // Throws
         , m_server{serv}
         , m_id{id}
@@ -1113,6 +1259,7 @@ public:
         , m_client_protocol_version{client_protocol_version}
         , m_client_user_agent{std::move(client_user_agent)}
         , m_remote_endpoint{std::move(remote_endpoint)}
+        , m_permessage_deflate{permessage_deflate}
     {
         // Make the output buffer stream throw std::bad_alloc if it fails to
         // expand the buffer
@@ -1202,6 +1349,17 @@ public:
         }
     }
 
+    void async_write_gather(const util::network::ConstBuffer* buffers, size_t num_buffers,
+                            util::websocket::WriteCompletionHandler handler) final override
+    {
+        if (m_ssl_stream) {
+            m_ssl_stream->async_write_gather(buffers, num_buffers, std::move(handler)); // Throws
+        }
+        else {
+            m_socket->async_write_gather(buffers, num_buffers, std::move(handler)); // Throws
+        }
+    }
+
     void async_read(char* buffer, size_t size, util::websocket::ReadCompletionHandler handler) final override
     {
         if (m_ssl_stream) {
@@ -1283,13 +1441,27 @@ public:
         return m_output_buffer;
     }
 
+    void write_output_buffer();
+    bool add_output_buffer_to_batch();
+    void flush_message_batch();
+    void handle_write_message_batch();
+
     // More advanced memory strategies can be implemented if needed.
-    void release_output_buffer() {}
+    void release_output_buffer()
+    {
+        m_output_body.reset();
+    }
 
     // When this function is called, the connection will initiate a write with
     // its output_buffer. Sessions use this method.
     void initiate_write_output_buffer();
 
+    // Same as initiate_write_output_buffer(), but `body` is sent immediately
+    // after the contents of the output buffer, as part of the same message,
+    // without first being copied into the output buffer. The connection keeps
+    // the body alive until the message has been written.
+    void initiate_write_output_buffer(std::shared_ptr<char[]> body, std::size_t body_size);
+
     void initiate_pong_output_buffer();
 
     void handle_protocol_error(ServerProtocol::Error error);
@@ -1328,6 +1500,8 @@ private:
     util::websocket::Socket m_websocket;
     std::unique_ptr<char[]> m_input_body_buffer;
     OutputBuffer m_output_buffer;
+    std::shared_ptr<char[]> m_output_body;
+    std::size_t m_output_body_size = 0;
     std::map<session_ident_type, std::unique_ptr<Session>> m_sessions;
 
     // The protocol version in use by the connected client.
@@ -1338,6 +1512,18 @@ private:
 
     const std::string m_remote_endpoint;
 
+    // Whether the permessage-deflate extension was negotiated in the handshake.
+    const bool m_permessage_deflate;
+
+    // Small messages produced by consecutive sessions in send_next_message()
+    // are collected here, and written together by flush_message_batch().
+    // m_message_batch_ends holds the end offset of each message. If a message
+    // does not fit, it is kept in m_output_buffer and written after the batch
+    // (m_output_deferred).
+    std::vector<char> m_message_batch;
+    std::vector<std::size_t> m_message_batch_ends;
+    bool m_output_deferred = false;
+
     // A queue of sessions that have enlisted for an opportunity to send a
     // message. Sessions will be served in the order that they enlist. A session
     // can only occur once in this queue (linked list). If the queue is not
@@ -1862,6 +2048,9 @@ private:
         }
         REALM_ASSERT(response);
         add_common_http_response_headers(*response);
+        bool permessage_deflate = false;
+        if (m_server.get_config().enable_permessage_deflate)
+            permessage_deflate = websocket::accept_permessage_deflate(request, *response); // Throws
 
         std::string user_agent;
         {
@@ -1870,7 +2059,8 @@ private:
                 user_agent = i->second; // Throws (copy)
         }
 
-        auto handler = [negotiated_protocol_version, user_agent = std::move(user_agent), this](std::error_code ec) {
+        auto handler = [negotiated_protocol_version, permessage_deflate, user_agent = std::move(user_agent),
+                        this](std::error_code ec) {
             // If the operation is aborted, the socket object may have been destroyed.
             if (ec != util::error::operation_aborted) {
                 if (ec) {
@@ -1880,8 +2070,8 @@ private:
 
                 std::unique_ptr<SyncConnection> sync_conn = std::make_unique<SyncConnection>(
                     m_server, m_id, std::move(m_socket), std::move(m_ssl_stream), std::move(m_read_ahead_buffer),
-                    negotiated_protocol_version, std::move(user_agent),
-                    std::move(m_remote_endpoint)); // Throws
+                    negotiated_protocol_version, std::move(user_agent), std::move(m_remote_endpoint),
+                    permessage_deflate); // Throws
                 SyncConnection& sync_conn_ref = *sync_conn;
                 m_server.add_sync_connection(m_id, std::move(sync_conn));
                 m_server.remove_http_connection(m_id);
@@ -2287,6 +2477,7 @@ public:
         m_server_file = server.get_or_create_file(path); // Throws
 
         m_server_file->add_unidentified_session(this); // Throws
+        m_server_file->prefetch();                      // Throws
 
         logger.info("Client info: (path='%1', from=%2, protocol=%3) %4", path, m_connection.get_remote_endpoint(),
                     m_connection.get_client_protocol_version(),
@@ -2843,6 +3034,7 @@ private:
             m_server_file->register_client_access(m_client_file_ident);     // Throws
             const ServerHistory& history = m_server_file->access().history; // Throws
             const char* body;
+            std::shared_ptr<char[]> shared_body; // Set when `body` is owned by the cache
             std::size_t uncompressed_body_size;
             std::size_t compressed_body_size = 0;
             bool body_is_compressed = false;
@@ -2855,28 +3047,56 @@ private:
             std::size_t accum_compacted_size;
             ServerProtocol& protocol = get_server_protocol();
             bool disable_download_compaction = config.disable_download_compaction;
-            bool enable_cache = (config.enable_download_bootstrap_cache && m_download_progress.server_version == 0 &&
-                                 m_upload_progress.client_version == 0 && m_upload_threshold.client_version == 0);
+            bool enable_bootstrap_cache =
+                (config.enable_download_bootstrap_cache && m_download_progress.server_version == 0 &&
+                 m_upload_progress.client_version == 0 && m_upload_threshold.client_version == 0);
+            // A DOWNLOAD body is determined by the scanned range of the history
+            // and the last client version integrated before it, as long as none
+            // of the changesets in the range were uploaded by the receiving
+            // client. Such bodies can be shared between sessions.
+            bool enable_cache = (enable_bootstrap_cache || config.max_download_cache_size != 0);
+            std::size_t max_download_size =
+                (enable_bootstrap_cache ? std::numeric_limits<size_t>::max() : config.max_download_size);
             DownloadCache& cache = m_server_file->get_download_cache();
-            bool fetch_from_cache = (enable_cache && cache.body && end_version == cache.end_version);
-            if (fetch_from_cache) {
-                body = cache.body.get();
-                uncompressed_body_size = cache.uncompressed_body_size;
-                compressed_body_size = cache.compressed_body_size;
-                body_is_compressed = cache.body_is_compressed;
-                download_progress = cache.download_progress;
-                downloadable_bytes = cache.downloadable_bytes;
-                num_changesets = cache.num_changesets;
-                accum_original_size = cache.accum_original_size;
-                accum_compacted_size = cache.accum_compacted_size;
+            DownloadCache::Key cache_key{m_download_progress, end_version, max_download_size};
+            const DownloadCache::Entry* cached = (enable_cache ? cache.find(cache_key) : nullptr);
+            if (cached) {
+                bool shareable = false;
+                bool not_expired = history.check_shared_download(
+                    m_client_file_ident, m_download_progress.server_version, cached->download_progress.server_version,
+                    shareable, upload_progress); // Throws
+                if (REALM_UNLIKELY(!not_expired)) {
+                    logger.debug("History scanning failed: Client file entry "
+                                 "expired during session"); // Throws
+                    get_connection().protocol_error(ProtocolError::client_file_expired, this);
+                    // Session object may have been destroyed at this point
+                    // (suicide).
+                    return;
+                }
+                if (!shareable)
+                    cached = nullptr;
+            }
+            if (cached) {
+                body = cached->body.get();
+                shared_body = cached->body;
+                uncompressed_body_size = cached->uncompressed_body_size;
+                compressed_body_size = cached->compressed_body_size;
+                body_is_compressed = cached->body_is_compressed;
+                download_progress = cached->download_progress;
+                downloadable_bytes = cached->downloadable_bytes;
+                num_changesets = cached->num_changesets;
+                accum_original_size = cached->accum_original_size;
+                accum_compacted_size = cached->accum_compacted_size;
+                logger.debug("Reusing cached DOWNLOAD body for server versions %1 to %2",
+                             m_download_progress.server_version, download_progress.server_version); // Throws
             }
             else {
-                // Discard the old cached DOWNLOAD body before generating a new
-                // one to be cached. This can make a big difference because the
-                // size of that body can be very large (10GiB has been seen in a
-                // real-world case).
-                if (enable_cache)
-                    cache.body = {};
+                // Discard the old cached bootstrap DOWNLOAD body before
+                // generating a new one to be cached. This can make a big
+                // difference because the size of that body can be very large
+                // (10GiB has been seen in a real-world case).
+                if (enable_bootstrap_cache)
+                    cache.discard(m_download_progress);
 
                 OutputBuffer& out = server.get_misc_buffers().download_message;
                 out.reset();
@@ -2920,44 +3140,55 @@ private:
                     accum_compacted_size = handler.accum_compacted_size;
                     return true;
                 };
-                if (enable_cache) {
-                    std::size_t max_download_size = std::numeric_limits<size_t>::max();
-                    if (!fetch_and_compress(max_download_size)) { // Throws
-                        // Session object may have been destroyed at this point
-                        // (suicide).
-                        return;
-                    }
-                    REALM_ASSERT(upload_progress.client_version == 0);
-                    std::size_t body_size = (body_is_compressed ? compressed_body_size : uncompressed_body_size);
-                    cache.body = std::make_unique<char[]>(body_size); // Throws
-                    std::copy(body, body + body_size, cache.body.get());
-                    cache.uncompressed_body_size = uncompressed_body_size;
-                    cache.compressed_body_size = compressed_body_size;
-                    cache.body_is_compressed = body_is_compressed;
-                    cache.end_version = end_version;
-                    cache.download_progress = download_progress;
-                    cache.downloadable_bytes = downloadable_bytes;
-                    cache.num_changesets = num_changesets;
-                    cache.accum_original_size = accum_original_size;
-                    cache.accum_compacted_size = accum_compacted_size;
+                if (!fetch_and_compress(max_download_size)) { // Throws
+                    // Session object may have been destroyed at this point
+                    // (suicide).
+                    return;
                 }
-                else {
-                    std::size_t max_download_size = config.max_download_size;
-                    if (!fetch_and_compress(max_download_size)) { // Throws
-                        // Session object may have been destroyed at this point
-                        // (suicide).
-                        return;
-                    }
+                if (enable_bootstrap_cache)
+                    REALM_ASSERT(upload_progress.client_version == 0);
+                // Bodies containing changesets from this client are not
+                // shareable. Those changesets would have advanced the last
+                // integrated client version.
+                bool shareable = (download_progress.last_integrated_client_version ==
+                                  m_download_progress.last_integrated_client_version);
+                if (enable_cache && shareable && num_changesets != 0) {
+                    DownloadCache::Entry entry;
+                    entry.uncompressed_body_size = uncompressed_body_size;
+                    entry.compressed_body_size = compressed_body_size;
+                    entry.body_is_compressed = body_is_compressed;
+                    std::size_t body_size = entry.body_size();
+                    entry.body.reset(new char[body_size]); // Throws
+                    std::copy(body, body + body_size, entry.body.get());
+                    body = entry.body.get();
+                    shared_body = entry.body;
+                    entry.download_progress = download_progress;
+                    entry.downloadable_bytes = downloadable_bytes;
+                    entry.num_changesets = num_changesets;
+                    entry.accum_original_size = accum_original_size;
+                    entry.accum_compacted_size = accum_compacted_size;
+                    cache.insert(cache_key, std::move(entry), config.max_download_cache_size); // Throws
                 }
             }
 
+            // A body owned by the cache is written directly from there
             OutputBuffer& out = m_connection.get_output_buffer();
-            protocol.make_download_message(
-                m_connection.get_client_protocol_version(), out, m_session_ident, download_progress.server_version,
-                download_progress.last_integrated_client_version, last_server_version.version,
-                last_server_version.salt, upload_progress.client_version,
-                upload_progress.last_integrated_server_version, downloadable_bytes, num_changesets, body,
-                uncompressed_body_size, compressed_body_size, body_is_compressed, logger); // Throws
+            if (shared_body) {
+                protocol.make_download_message_header(
+                    m_connection.get_client_protocol_version(), out, m_session_ident,
+                    download_progress.server_version, download_progress.last_integrated_client_version,
+                    last_server_version.version, last_server_version.salt, upload_progress.client_version,
+                    upload_progress.last_integrated_server_version, downloadable_bytes, num_changesets,
+                    uncompressed_body_size, compressed_body_size, body_is_compressed, logger); // Throws
+            }
+            else {
+                protocol.make_download_message(
+                    m_connection.get_client_protocol_version(), out, m_session_ident,
+                    download_progress.server_version, download_progress.last_integrated_client_version,
+                    last_server_version.version, last_server_version.salt, upload_progress.client_version,
+                    upload_progress.last_integrated_server_version, downloadable_bytes, num_changesets, body,
+                    uncompressed_body_size, compressed_body_size, body_is_compressed, logger); // Throws
+            }
 
             if (!disable_download_compaction) {
                 std::size_t saved = accum_original_size - accum_compacted_size;
@@ -2968,7 +3199,8 @@ private:
             m_download_progress = download_progress;
             logger.debug("Setting of m_download_progress.server_version = %1",
                          m_download_progress.server_version); // Throws
-            send_download_message();
+            std::size_t body_size = (body_is_compressed ? compressed_body_size : uncompressed_body_size);
+            send_download_message(std::move(shared_body), body_size); // Throws
             m_one_download_message_sent = true;
 
             enlist_to_send();
@@ -3012,8 +3244,13 @@ private:
         // Protocol state is now WaitForStateRequest or WaitForIdent
     }
 
-    void send_download_message()
+    // If `shared_body` is null, the body is already in the output buffer
+    void send_download_message(std::shared_ptr<char[]> shared_body, std::size_t body_size)
     {
+        if (shared_body) {
+            m_connection.initiate_write_output_buffer(std::move(shared_body), body_size); // Throws
+            return;
+        }
         m_connection.initiate_write_output_buffer(); // Throws
     }
 
@@ -3170,14 +3407,14 @@ void SessionQueue::clear() noexcept
 
 // ============================ ServerFile implementation ============================
 
-ServerFile::ServerFile(ServerImpl& server, ServerFileAccessCache& cache, const std::string& virt_path,
-                       std::string real_path, bool disable_sync_to_disk)
-    : logger{"ServerFile[" + virt_path + "]: ", server.logger}               // Throws
-    , wlogger{"ServerFile[" + virt_path + "]: ", server.get_worker().logger} // Throws
+ServerFile::ServerFile(ServerImpl& server, ServerFileAccessCache& cache, Worker& worker,
+                       const std::string& virt_path, std::string real_path, bool disable_sync_to_disk)
+    : logger{"ServerFile[" + virt_path + "]: ", server.logger} // Throws
+    , wlogger{"ServerFile[" + virt_path + "]: ", worker.logger} // Throws
     , m_server{server}
+    , m_worker{worker}
     , m_file{cache, real_path, virt_path, *this, false, disable_sync_to_disk} // Throws
-    , m_worker_file{
-          server.get_worker().get_file_access_cache(), real_path, virt_path, *this, true, disable_sync_to_disk}
+    , m_worker_file{worker.get_file_access_cache(), real_path, virt_path, *this, true, disable_sync_to_disk}
 {
 }
 
@@ -3213,7 +3450,7 @@ void ServerFile::register_client_access(file_ident_type client_file_ident)
 {
     const Server::Config& config = m_server.get_config();
     if (!config.disable_history_compaction) {
-        Clock::time_point now = m_server.get_worker().get_compaction_clock_now();
+        Clock::time_point now = m_worker.get_compaction_clock_now();
         std::time_t now_2 = Clock::clock::to_time_t(now);
         util::LockGuard lock{m_server.last_client_accesses_mutex};
         m_last_client_accesses[client_file_ident] = {now_2}; // Throws
@@ -3395,6 +3632,9 @@ void ServerFile::worker_process_work_unit(WorkerState& state)
             worker_integrate_changes_from_downstream(state); // Throws
     }
 
+    if (m_worker.get_compaction_time_budget().count() != 0 && state.use_file_cache)
+        m_worker.schedule_compaction(this); // Throws
+
     wlogger.debug("Work unit execution completed"); // Throws
 
     milliseconds_type time = steady_duration(start_time);
@@ -3449,8 +3689,7 @@ void ServerFile::group_unblock_work()
         if (REALM_LIKELY(work.has_primary_work)) {
             logger.trace("Work unit unblocked"); // Throws
             m_has_work_in_progress = true;
-            Worker& worker = m_server.get_worker();
-            worker.enqueue(this); // Throws
+            m_worker.enqueue(this); // Throws
         }
     }
 }
@@ -3575,6 +3814,15 @@ bool ServerFile::worker_integrate_changes_from_downstream(WorkerState& state)
     return produced_new_sync_version;
 }
 
+// NOTE: This function is executed by the worker thread
+bool ServerFile::worker_compact_history()
+{
+    ServerHistory& hist = worker_access().history; // Throws
+    std::chrono::milliseconds time_budget = m_worker.get_compaction_time_budget();
+    return hist.compact_history_incrementally(time_budget, wlogger); // Throws
+}
+
+
 ServerHistory& ServerFile::get_client_file_history(WorkerState& state, std::unique_ptr<ServerHistory>& hist_ptr,
                                                    DBRef& sg_ptr)
 {
@@ -3740,11 +3988,12 @@ version_type ServerFile::get_max_compactable_server_version()
 
 // ============================ Worker implementation ============================
 
-Worker::Worker(ServerImpl& server)
-    : logger{"Worker: ", server.logger} // Throws
+Worker::Worker(ServerImpl& server, int index)
+    : logger{index == 0 ? std::string{"Worker: "} : util::format("Worker[%1]: ", index), server.logger} // Throws
     , m_server{server}
     , m_transformer{make_transformer()} // Throws
-    , m_file_access_cache{server.get_config().max_open_files, logger, *this, server.get_config().encryption_key}
+    , m_file_access_cache{server.get_config().max_open_files, logger, *this, server.get_config().encryption_key,
+                          server.get_config().max_open_files_size, server.get_config().num_file_io_threads}
 {
     util::seed_prng_nondeterministically(m_random); // Throws
 }
@@ -3754,10 +4003,31 @@ void Worker::enqueue(ServerFile* file)
 {
     util::LockGuard lock{m_mutex};
     m_queue.push_back(file); // Throws
+    m_max_queue_depth = std::max(m_max_queue_depth, m_queue.size());
     m_cond.notify_all();
 }
 
 
+void Worker::schedule_compaction(ServerFile* file)
+{
+    if (file->m_worker_compaction_scheduled)
+        return;
+    m_compaction_queue.push_back(file); // Throws
+    file->m_worker_compaction_scheduled = true;
+}
+
+
+Server::WorkerQueueMetrics Worker::get_queue_metrics()
+{
+    util::LockGuard lock{m_mutex};
+    Server::WorkerQueueMetrics metrics;
+    metrics.queue_depth = m_queue.size();
+    metrics.max_queue_depth = m_max_queue_depth;
+    metrics.num_work_units = m_num_work_units;
+    return metrics;
+}
+
+
 std::mt19937_64& Worker::server_history_get_random() noexcept
 {
     return m_random;
@@ -3787,6 +4057,22 @@ Clock::time_point Worker::get_compaction_clock_now() const noexcept
 }
 
 
+std::chrono::milliseconds Worker::get_compaction_time_budget() const noexcept
+{
+    const Server::Config& config = m_server.get_config();
+    if (config.disable_history_compaction)
+        return std::chrono::milliseconds{0};
+    return config.history_compaction_time_budget;
+}
+
+
+std::size_t Worker::get_history_block_size() const noexcept
+{
+    const Server::Config& config = m_server.get_config();
+    return config.history_block_size;
+}
+
+
 sync::Transformer& Worker::get_transformer()
 {
     return *m_transformer;
@@ -3810,12 +4096,28 @@ void Worker::run()
                 if (!m_queue.empty()) {
                     file = m_queue.front();
                     m_queue.pop_front();
+                    ++m_num_work_units;
                     break;
                 }
+                if (!m_compaction_queue.empty())
+                    break;
                 m_cond.wait(lock);
             }
         }
-        file->worker_process_work_unit(m_state); // Throws
+        if (file) {
+            file->worker_process_work_unit(m_state); // Throws
+            continue;
+        }
+
+        // Idle, so run a pass of incremental history compaction. Work units
+        // that arrive in the meantime will wait for no longer than the time
+        // budget of one pass.
+        file = m_compaction_queue.front();
+        m_compaction_queue.pop_front();
+        file->m_worker_compaction_scheduled = false;
+        bool more = file->worker_compact_history(); // Throws
+        if (more)
+            schedule_compaction(file); // Throws
     }
 }
 
@@ -3838,8 +4140,9 @@ ServerImpl::ServerImpl(const std::string& root_dir, util::Optional<sync::PKey> p
     , m_root_dir{root_dir} // Throws
     , m_access_control{std::move(pkey)}
     , m_protocol_version_range{determine_protocol_version_range(config)}                 // Throws
-    , m_file_access_cache{m_config.max_open_files, logger, *this, config.encryption_key} // Throws
-    , m_worker{*this}                                                                    // Throws
+    , m_file_access_cache{m_config.max_open_files, logger, *this, config.encryption_key,
+                          m_config.max_open_files_size, m_config.num_file_io_threads} // Throws
+    , m_workers{make_workers(*this, m_config.num_workers)}                               // Throws
     , m_acceptor{get_service()}
     , m_server_protocol{}       // Throws
     , m_compress_memory_arena{} // Throws
@@ -3852,6 +4155,16 @@ ServerImpl::ServerImpl(const std::string& root_dir, util::Optional<sync::PKey> p
 }
 
 
+std::vector<Server::WorkerQueueMetrics> ServerImpl::get_worker_queue_metrics()
+{
+    std::vector<Server::WorkerQueueMetrics> metrics;
+    metrics.reserve(m_workers.size()); // Throws
+    for (const auto& worker : m_workers)
+        metrics.push_back(worker->get_queue_metrics());
+    return metrics;
+}
+
+
 ServerImpl::~ServerImpl() noexcept
 {
     bool server_destroyed_while_still_running = m_running;
@@ -3885,7 +4198,10 @@ void ServerImpl::start()
                     "NOT RECOMMENDED FOR PRODUCTION"); // Throws
     }
     logger.info("Directory holding persistent state: %1", m_root_dir);        // Throws
-    logger.info("Maximum number of open files: %1", m_config.max_open_files); // Throws
+    logger.info("Maximum number of open files: %1", m_config.max_open_files);           // Throws
+    logger.info("Maximum size of open files: %1 bytes", m_config.max_open_files_size); // Throws
+    logger.info("Number of file I/O threads: %1", m_config.num_file_io_threads);       // Throws
+    logger.info("Number of workers: %1", m_config.num_workers);                        // Throws
     {
         const char* lead_text = "Encryption";
         if (m_config.encryption_key) {
@@ -3914,6 +4230,8 @@ void ServerImpl::start()
     logger.info("Download bootstrap caching: %1",
                 (m_config.enable_download_bootstrap_cache ? "Yes" : "No"));                // Throws
     logger.info("Max download size: %1 bytes", m_config.max_download_size);                // Throws
+    logger.info("Permessage deflate: %1", (m_config.enable_permessage_deflate ? "Yes" : "No")); // Throws
+    logger.info("Max coalesced write size: %1 bytes", m_config.max_coalesced_write_size);       // Throws
     logger.info("Max upload backlog: %1 bytes", m_max_upload_backlog);                     // Throws
     logger.info("HTTP request timeout: %1 ms", m_config.http_request_timeout);             // Throws
     logger.info("HTTP response timeout: %1 ms", m_config.http_response_timeout);           // Throws
@@ -3929,9 +4247,10 @@ void ServerImpl::start()
             std::chrono::seconds interval = m_config.history_compaction_interval;
             std::chrono::seconds time_to_live = m_config.history_ttl;
             bool ignore_clients = m_config.history_compaction_ignore_clients;
-            logger.info("%1: Enabled (interval=%2s, time_to_live=%3s, ignore_clients=%4)", lead_text,
-                        interval.count(), time_to_live.count(),
-                        (ignore_clients ? "yes" : "no")); // Throws
+            std::chrono::milliseconds time_budget = m_config.history_compaction_time_budget;
+            logger.info("%1: Enabled (interval=%2s, time_to_live=%3s, ignore_clients=%4, time_budget=%5ms)",
+                        lead_text, interval.count(), time_to_live.count(), (ignore_clients ? "yes" : "no"),
+                        time_budget.count()); // Throws
             if (ignore_clients) {
                 logger.warn("In-place history compaction option 'ignore clients' enabled. Do not "
                             "enable this unless you know that you have to!"); // Throws
@@ -3939,6 +4258,13 @@ void ServerImpl::start()
         }
     }
 
+    if (m_config.history_block_size > 0) {
+        logger.info("Sealed history blocks: Enabled (block_size=%1)", m_config.history_block_size); // Throws
+    }
+    else {
+        logger.info("Sealed history blocks: Disabled"); // Throws
+    }
+
     logger.debug("Authorization header name: %1", m_config.authorization_header_name); // Throws
 
     m_transformer = make_transformer(); // Throws
@@ -3974,19 +4300,27 @@ void ServerImpl::run()
     auto ta = util::make_temp_assign(m_running, true);
 
     {
-        auto worker_thread = util::make_thread_exec_guard(m_worker, *this); // Throws
+        std::vector<util::ThreadExecGuardWithParent<Worker, ServerImpl>> worker_threads;
+        worker_threads.reserve(m_workers.size()); // Throws
         std::string name;
-        if (util::Thread::get_name(name)) {
-            name += "-worker";
-            worker_thread.start_with_signals_blocked(name); // Throws
-        }
-        else {
-            worker_thread.start_with_signals_blocked(); // Throws
+        bool has_name = util::Thread::get_name(name);
+        for (std::size_t i = 0; i < m_workers.size(); ++i) {
+            auto& worker_thread = worker_threads.emplace_back(*m_workers[i], *this); // Throws
+            if (has_name) {
+                std::string worker_name = name + "-worker";
+                if (i > 0)
+                    worker_name += std::to_string(i);
+                worker_thread.start_with_signals_blocked(worker_name); // Throws
+            }
+            else {
+                worker_thread.start_with_signals_blocked(); // Throws
+            }
         }
 
         m_service.run(); // Throws
 
-        worker_thread.stop_and_rethrow(); // Throws
+        for (auto& worker_thread : worker_threads)
+            worker_thread.stop_and_rethrow(); // Throws
     }
 
     logger.info("Realm sync server stopped");
@@ -4316,7 +4650,7 @@ void SyncConnection::initiate()
 {
     m_last_activity_at = steady_clock_now();
     logger.debug("Sync Connection initiated");
-    m_websocket.initiate_server_websocket_after_handshake();
+    m_websocket.initiate_server_websocket_after_handshake(m_permessage_deflate);
 }
 
 
@@ -4600,7 +4934,12 @@ void SyncConnection::send_next_message()
     for (;;) {
         Session* sess = m_sessions_enlisted_to_send.pop_front();
         if (!sess) {
-            // No sessions were enlisted to send
+            // No sessions were enlisted to send. Batched messages go before a
+            // connection level ERROR.
+            if (!m_message_batch_ends.empty()) {
+                flush_message_batch(); // Throws
+                return;
+            }
             if (REALM_LIKELY(!m_is_closing))
                 return; // Nothing more to do right now
             // Send a connection level ERROR
@@ -4612,9 +4951,9 @@ void SyncConnection::send_next_message()
         // NOTE: The session might have gotten destroyed at this time!
 
         // At this point, `m_is_sending` is true if, and only if the session
-        // chose to send a message. If it chose to not send a message, we must
-        // loop back and give the next session in `m_sessions_enlisted_to_send`
-        // a chance.
+        // chose to send a message that was not added to the message batch. If
+        // it chose to not send a message, we must loop back and give the next
+        // session in `m_sessions_enlisted_to_send` a chance.
         if (m_is_sending)
             return;
     }
@@ -4623,16 +4962,92 @@ void SyncConnection::send_next_message()
 
 void SyncConnection::initiate_write_output_buffer()
 {
+    if (add_output_buffer_to_batch()) // Throws
+        return;
+    m_output_body_size = 0;
+    write_output_buffer(); // Throws
+}
+
+
+void SyncConnection::initiate_write_output_buffer(std::shared_ptr<char[]> body, std::size_t body_size)
+{
+    m_output_body = std::move(body);
+    m_output_body_size = body_size;
+    write_output_buffer(); // Throws
+}
+
+
+void SyncConnection::write_output_buffer()
+{
+    m_is_sending = true;
+    if (!m_message_batch_ends.empty()) {
+        // The batch must go first to preserve the order of the messages
+        m_output_deferred = true;
+        flush_message_batch(); // Throws
+        return;
+    }
+
     auto handler = [this]() {
         handle_write_output_buffer();
     };
 
-    m_websocket.async_write_binary(m_output_buffer.data(), m_output_buffer.size(),
-                                   std::move(handler)); // Throws
+    if (!m_output_body) {
+        m_websocket.async_write_binary(m_output_buffer.data(), m_output_buffer.size(),
+                                       std::move(handler)); // Throws
+        return;
+    }
+    util::network::ConstBuffer pieces[] = {{m_output_buffer.data(), m_output_buffer.size()},
+                                           {m_output_body.get(), m_output_body_size}};
+    m_websocket.async_write_binary(pieces, 2, std::move(handler)); // Throws
+}
+
+
+// Copies the message in the output buffer to the message batch, if coalescing
+// is enabled and it fits. The caller then continues with the next session.
+bool SyncConnection::add_output_buffer_to_batch()
+{
+    std::size_t max_size = m_server.get_config().max_coalesced_write_size;
+    std::size_t size = m_output_buffer.size();
+    if (m_message_batch.size() + size > max_size)
+        return false;
+    m_message_batch.insert(m_message_batch.end(), m_output_buffer.data(), m_output_buffer.data() + size); // Throws
+    m_message_batch_ends.push_back(m_message_batch.size());                                           // Throws
+    return true;
+}
+
+
+void SyncConnection::flush_message_batch()
+{
+    std::vector<util::network::ConstBuffer> messages;
+    messages.reserve(m_message_batch_ends.size()); // Throws
+    std::size_t begin = 0;
+    for (std::size_t end : m_message_batch_ends) {
+        messages.push_back({m_message_batch.data() + begin, end - begin});
+        begin = end;
+    }
+
+    auto handler = [this]() {
+        handle_write_message_batch();
+    };
+    m_websocket.async_write_binary_messages(messages.data(), messages.size(), std::move(handler)); // Throws
     m_is_sending = true;
 }
 
 
+void SyncConnection::handle_write_message_batch()
+{
+    m_message_batch.clear();
+    m_message_batch_ends.clear();
+    if (m_output_deferred) {
+        m_output_deferred = false;
+        write_output_buffer(); // Throws
+        return;
+    }
+    m_is_sending = false;
+    send_next_message(); // Throws
+}
+
+
 void SyncConnection::initiate_pong_output_buffer()
 {
     auto handler = [this]() {
@@ -4921,3 +5336,9 @@ void Server::get_workunit_timers(milliseconds_type& parallel_section, millisecon
 {
     m_impl->get_workunit_timers(parallel_section, sequential_section);
 }
+
+
+std::vector<Server::WorkerQueueMetrics> Server::get_worker_queue_metrics()
+{
+    return m_impl->get_worker_queue_metrics(); // Throws
+}
@@ -6,6 +6,7 @@
 #include <string>
 #include <map>
 #include <set>
+#include <vector>
 #include <exception>
 
 #include <realm/util/network.hpp>
@@ -76,6 +77,33 @@ public:
         /// for each major thread).
         long max_open_files = 256;
 
+        /// The maximum accumulated size in bytes of the Realm files that are
+        /// kept open by each of the file caches described above. Since files
+        /// are mapped in their entirety, this bounds the mapped memory better
+        /// than `max_open_files` when file sizes vary a lot. Zero means no
+        /// limit.
+        std::size_t max_open_files_size = 0;
+
+        /// The number of threads used by each of the file caches described
+        /// above for opening and closing Realm files in the background. When
+        /// nonzero, evicted files are closed off the event loop, and a Realm
+        /// file that is not open is opened in the background as soon as a
+        /// session binds to it, while the rest of the handshake takes
+        /// place. Files being opened in the background count against the
+        /// limits of the cache, and none is opened unless there is room for
+        /// it. Zero means that files are opened and closed synchronously.
+        int num_file_io_threads = 0;
+
+        /// The number of worker threads that integrate changesets uploaded by
+        /// clients and allocate client file identifiers. Each Realm file is
+        /// assigned to one of the workers when the server first accesses it,
+        /// so work on a particular file is serialized, while work on files
+        /// that are assigned to different workers proceeds in parallel. Each
+        /// worker has its own cache of open Realm files (see
+        /// `max_open_files`). Must be greater than or equal to 1,
+        /// otherwise the server constructor throws `std::runtime_error`.
+        int num_workers = 1;
+
         /// An optional custom clock to be used for token expiration checks. If
         /// no clock is specified, the server will use the system clock.
         Clock* token_expiration_clock = nullptr;
@@ -171,6 +199,17 @@ public:
         /// message(s) used for client bootstrapping.
         bool enable_download_bootstrap_cache = false;
 
+        /// The maximum accumulated size of DOWNLOAD message bodies that are
+        /// cached per Realm file, so that sessions resuming from the same
+        /// point in the history can share them instead of scanning and
+        /// compressing the same changesets again. Only bodies that contain no
+        /// changesets uploaded by the receiving client are shared. The least
+        /// recently used bodies are discarded first. Zero disables the cache.
+        ///
+        /// If enable_download_bootstrap_cache is true, the most recent
+        /// bootstrap body is kept even if it is larger than this limit.
+        std::size_t max_download_cache_size = 0;
+
         /// The accumulated size of changesets that are included in download
         /// messages. The size of the changesets is calculated before log
         /// compaction (if enabled). A larger value leads to more efficient
@@ -179,6 +218,18 @@ public:
         /// for the need to resend the same changes after network disconnects.
         std::size_t max_download_size = 0x1000000; // 16 MiB
 
+        /// If set to true, the server accepts the permessage-deflate WebSocket
+        /// extension when clients offer it, and then compresses larger
+        /// messages that it sends.
+        bool enable_permessage_deflate = false;
+
+        /// When several sessions on the same connection have messages ready
+        /// at the same time, messages of up to this accumulated size are
+        /// coalesced into a single write to the socket, rather than one write
+        /// per message. Each message is still sent as its own WebSocket
+        /// frame. Zero disables coalescing.
+        std::size_t max_coalesced_write_size = 0;
+
         /// The maximum number of connections that can be queued up waiting to
         /// be accepted by the server. This corresponds to the `backlog`
         /// argument of the `listen()` function as described by POSIX.
@@ -236,6 +287,29 @@ public:
         /// clock.
         const Clock* history_compaction_clock = nullptr;
 
+        /// If nonzero, in-place history compaction is not done as part of the
+        /// integration of uploaded changesets. Instead, a worker thread
+        /// compacts the history of a file in passes of approximately this
+        /// duration, whenever it has no other work to do. The progress is
+        /// persisted in the file, so a pass continues where the previous one
+        /// stopped, also across server restarts.
+        ///
+        /// If zero (the default), the compactable history is compacted in full
+        /// during the integration of uploaded changesets.
+        std::chrono::milliseconds history_compaction_time_budget = std::chrono::milliseconds{0};
+
+        /// If nonzero, the changesets of the main history of a file are sealed
+        /// into compressed blocks of this many changesets once they have been
+        /// compacted (or, when in-place history compaction is disabled, once
+        /// they are followed by at least this many newer changesets). This
+        /// reduces the size of the history in the files considerably, at the
+        /// expense of having to decompress a block to read any of its
+        /// changesets, which is mostly relevant to clients downloading old
+        /// history.
+        ///
+        /// If zero (the default), changesets are never sealed.
+        std::size_t history_block_size = 0;
+
         /// An optional 64 byte key to encrypt all files with.
         util::Optional<std::array<char, 64>> encryption_key;
 
@@ -395,6 +469,26 @@ public:
     /// of the server.
     void get_workunit_timers(milliseconds_type& parallel_section, milliseconds_type& sequential_section);
 
+    /// Work queue metrics of one of the worker threads (see
+    /// Config::num_workers).
+    struct WorkerQueueMetrics {
+        /// The number of Realm files that currently have work waiting for the
+        /// worker.
+        std::size_t queue_depth = 0;
+
+        /// The largest value of `queue_depth` since the server was created.
+        std::size_t max_queue_depth = 0;
+
+        /// The number of work units that the worker has started processing.
+        std::uint_fast64_t num_work_units = 0;
+    };
+
+    /// Get the work queue metrics of each of the worker threads.
+    ///
+    /// This function is thread-safe and may be called at any time during the
+    /// life of the server object.
+    std::vector<WorkerQueueMetrics> get_worker_queue_metrics();
+
 private:
     class Implementation;
     std::unique_ptr<Implementation> m_impl;
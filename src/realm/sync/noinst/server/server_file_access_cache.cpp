@@ -4,6 +4,39 @@ using namespace realm;
 using namespace _impl;
 
 
+ServerFileAccessCache::ServerFileAccessCache(long max_open_files, util::Logger& logger,
+                                             ServerHistory::Context& history_context,
+                                             util::Optional<std::array<char, 64>> encryption_key,
+                                             std::size_t max_open_files_size, int num_io_threads)
+    : m_max_open_files{max_open_files}
+    , m_max_open_files_size{max_open_files_size}
+    , m_encryption_key{encryption_key}
+    , m_logger{logger}
+    , m_history_context{history_context}
+{
+    REALM_ASSERT(m_max_open_files >= 1);
+    REALM_ASSERT(num_io_threads >= 0);
+    try {
+        m_io_threads.reserve(num_io_threads); // Throws
+        for (int i = 0; i < num_io_threads; ++i) {
+            m_io_threads.emplace_back([this] {
+                io_thread();
+            }); // Throws
+        }
+    }
+    catch (...) {
+        {
+            std::lock_guard lock{m_io_mutex};
+            m_io_stop = true;
+        }
+        m_io_cond.notify_all();
+        for (std::thread& thread : m_io_threads)
+            thread.join();
+        throw;
+    }
+}
+
+
 void ServerFileAccessCache::proper_close_all()
 {
     while (m_first_open_file)
@@ -33,9 +66,67 @@ void ServerFileAccessCache::access(Slot& slot)
         least_recently_accessed.proper_close(); // Throws
     }
 
-    slot.open(); // Throws
+    slot.open();    // Throws
+    evict_for(slot); // Throws
+}
+
+
+// Close the least recently accessed Realm files until the open files fit in
+// the size limit, except for `slot` itself.
+void ServerFileAccessCache::evict_for(Slot& slot)
+{
+    if (m_max_open_files_size == 0)
+        return;
+    while (m_open_files_size > m_max_open_files_size) {
+        Slot& least_recently_accessed = *m_first_open_file->m_prev_open_file;
+        if (&least_recently_accessed == &slot)
+            break;
+        least_recently_accessed.proper_close(); // Throws
+    }
+}
+
+
+std::future<void> ServerFileAccessCache::add_io_job(util::UniqueFunction<void()> job)
+{
+    REALM_ASSERT(has_io_threads());
+    std::promise<void> promise;
+    std::future<void> future = promise.get_future();
+    auto wrapper = [job = std::move(job), promise = std::move(promise)]() mutable {
+        try {
+            job(); // Throws
+            promise.set_value();
+        }
+        catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    };
+    {
+        std::lock_guard lock{m_io_mutex};
+        m_io_jobs.emplace_back(std::move(wrapper)); // Throws
+    }
+    m_io_cond.notify_one();
+    return future;
+}
+
+
+void ServerFileAccessCache::io_thread() noexcept
+{
+    std::unique_lock lock{m_io_mutex};
+    for (;;) {
+        while (m_io_jobs.empty() && !m_io_stop)
+            m_io_cond.wait(lock);
+        if (m_io_jobs.empty())
+            return;
+        util::UniqueFunction<void()> job = std::move(m_io_jobs.front());
+        m_io_jobs.pop_front();
+        lock.unlock();
+        job();
+        job = nullptr;
+        lock.lock();
+    }
 }
 
+
 void ServerFileAccessCache::Slot::proper_close()
 {
     if (is_open()) {
@@ -45,15 +136,97 @@ void ServerFileAccessCache::Slot::proper_close()
 }
 
 
+void ServerFileAccessCache::Slot::prefetch()
+{
+    if (!m_cache.has_io_threads() || is_open() || m_prefetching.valid())
+        return;
+
+    // The file does not exist yet if it is being created
+    std::size_t file_size = 0;
+    if (util::File::exists(realm_path))
+        file_size = std::size_t(util::File::get_size_static(realm_path)); // Throws
+    if (!m_cache.has_room_for_prefetch(file_size)) {
+        m_cache.m_logger.trace("No room for prefetching Realm file: %1", realm_path); // Throws
+        return;
+    }
+
+    m_cache.m_logger.detail("Prefetching Realm file: %1", realm_path); // Throws
+
+    // A pending close of the same file must complete first, as it may hold
+    // the sync agent.
+    std::unique_ptr<File> file{new File{*this}}; // Throws
+    auto job = [file = file.get(), path = realm_path, options = make_shared_group_options(),
+                claim_sync_agent = m_claim_sync_agent, closing = m_closing] {
+        if (closing.valid())
+            closing.wait();
+        File::open_shared_group(*file, path, options, claim_sync_agent); // Throws
+    };
+    m_prefetching = m_cache.add_io_job(std::move(job)); // Throws
+    m_prefetched_file = std::move(file);
+    m_prefetched_file_size = file_size;
+    ++m_cache.m_num_prefetched_files;
+    m_cache.m_prefetched_files_size += file_size;
+    m_closing = {};
+}
+
+
 void ServerFileAccessCache::Slot::open()
 {
     REALM_ASSERT(!is_open());
 
-    m_cache.m_logger.detail("Opening Realm file: %1", realm_path); // Throws
-
-    m_file.reset(new File{*this}); // Throws
+    std::unique_ptr<File> file;
+    if (m_prefetching.valid()) {
+        try {
+            m_prefetching.get(); // Throws
+            file = std::move(m_prefetched_file);
+            m_cache.m_logger.detail("Using prefetched Realm file: %1", realm_path); // Throws
+        }
+        catch (const std::exception& e) {
+            m_cache.m_logger.detail("Failed to prefetch Realm file: %1: %2", realm_path, e.what()); // Throws
+        }
+        end_prefetch();
+    }
+    if (!file) {
+        if (m_closing.valid()) {
+            m_closing.wait();
+            m_closing = {};
+        }
+        m_cache.m_logger.detail("Opening Realm file: %1", realm_path); // Throws
+        file.reset(new File{*this});                                    // Throws
+        File::open_shared_group(*file, realm_path, make_shared_group_options(), m_claim_sync_agent); // Throws
+    }
+    m_file_size = std::size_t(util::File::get_size_static(realm_path)); // Throws
+    m_file = std::move(file);
 
     m_cache.insert(*this);
     m_cache.m_first_open_file = this;
     ++m_cache.m_num_open_files;
+    m_cache.m_open_files_size += m_file_size;
+}
+
+
+void ServerFileAccessCache::Slot::do_close() noexcept
+{
+    REALM_ASSERT(is_open());
+    --m_cache.m_num_open_files;
+    m_cache.m_open_files_size -= m_file_size;
+    m_cache.remove(*this);
+
+    // Closing a file can take a while, as it may involve flushing and
+    // unmapping it, so it is done in the background if possible.
+    if (m_cache.has_io_threads()) {
+        REALM_ASSERT(!m_closing.valid());
+        try {
+            auto job = [file = std::move(m_file)]() mutable {
+                file.reset();
+            };
+            m_closing = m_cache.add_io_job(std::move(job)).share(); // Throws
+        }
+        catch (...) {
+            // The file was closed when the job was destroyed
+        }
+        REALM_ASSERT(!m_file);
+        return;
+    }
+    m_file.reset();
 }
@@ -2,15 +2,22 @@
 #ifndef REALM_NOINST_SERVER_FILE_ACCESS_CACHE_HPP
 #define REALM_NOINST_SERVER_FILE_ACCESS_CACHE_HPP
 
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <memory>
 #include <string>
 #include <random>
+#include <vector>
 
 #include <realm/util/assert.hpp>
 #include <realm/util/logger.hpp>
 #include <realm/db.hpp>
 #include <realm/util/optional.hpp>
+#include <realm/util/functional.hpp>
 #include <realm/sync/noinst/server/server_history.hpp>
 
 namespace realm {
@@ -18,6 +25,10 @@ namespace _impl {
 
 /// This class maintains a list of open Realm files ordered according to the
 /// time when they were last accessed.
+///
+/// If the cache is given file I/O threads, files are closed on those threads
+/// rather than on the accessing thread, and Slot::prefetch() can be used to
+/// open a file ahead of its first access.
 class ServerFileAccessCache {
 public:
     class Slot;
@@ -26,11 +37,22 @@ public:
     /// \param max_open_files The maximum number of Realm files to keep open
     /// concurrently. Must be greater than or equal to 1.
     ///
+    /// \param max_open_files_size The maximum accumulated size of the open
+    /// Realm files, as measured when each of them was opened. Since the files
+    /// are mapped in their entirety, this limits the mapped memory. The most
+    /// recently accessed file is kept open even if it is larger. Zero means no
+    /// limit.
+    ///
+    /// \param num_io_threads The number of threads used for opening and
+    /// closing files in the background. Zero means that all files are opened
+    /// and closed synchronously, and that Slot::prefetch() does nothing.
+    ///
     /// The specified history context will not be accessed on behalf of this
-    /// cache object before the first invocation of Slot::access() on an
-    /// associated file file slot.
+    /// cache object before the first invocation of Slot::access() or
+    /// Slot::prefetch() on an associated file file slot.
     ServerFileAccessCache(long max_open_files, util::Logger&, ServerHistory::Context&,
-                          util::Optional<std::array<char, 64>> encryption_key);
+                          util::Optional<std::array<char, 64>> encryption_key, std::size_t max_open_files_size = 0,
+                          int num_io_threads = 0);
 
     ~ServerFileAccessCache() noexcept;
 
@@ -47,14 +69,35 @@ private:
     /// Current number of open Realm files.
     long m_num_open_files = 0;
 
+    /// Current accumulated size of the open Realm files.
+    std::size_t m_open_files_size = 0;
+
+    /// Number and accumulated size of the Realm files that are being
+    /// prefetched, or have been prefetched but not yet accessed.
+    long m_num_prefetched_files = 0;
+    std::size_t m_prefetched_files_size = 0;
+
     const long m_max_open_files;
+    const std::size_t m_max_open_files_size;
     const util::Optional<std::array<char, 64>> m_encryption_key;
     util::Logger& m_logger;
     ServerHistory::Context& m_history_context;
 
+    std::mutex m_io_mutex;
+    std::condition_variable m_io_cond;
+    std::deque<util::UniqueFunction<void()>> m_io_jobs;
+    bool m_io_stop = false;
+    std::vector<std::thread> m_io_threads;
+
     void access(Slot&);
+    bool has_room_for_prefetch(std::size_t file_size) const noexcept;
     void remove(Slot&) noexcept;
     void insert(Slot&) noexcept;
+    void evict_for(Slot&);
+
+    bool has_io_threads() const noexcept;
+    std::future<void> add_io_job(util::UniqueFunction<void()>);
+    void io_thread() noexcept;
 };
 
 
@@ -78,6 +121,10 @@ public:
     /// Returns true if the associated Realm file is currently open.
     bool is_open() const noexcept;
 
+    /// Returns true if the associated Realm file is being prefetched, or has
+    /// been prefetched and not yet accessed.
+    bool is_prefetching() const noexcept;
+
     /// Open the Realm file at `realm_path` if it is not already open. The
     /// returned reference is guaranteed to remain valid until access() is
     /// called again on this slot or on any other slot associated with the same
@@ -86,8 +133,19 @@ public:
     ///
     /// Calling this function may cause Realm files associated with other Slot
     /// objects of the same ServerFileAccessCache object to be closed.
+    ///
+    /// If the file is being opened by prefetch(), this function waits for
+    /// that to complete.
     File& access();
 
+    /// Start opening the Realm file on one of the I/O threads of the cache,
+    /// if it is not already open or being opened, so that a subsequent call
+    /// to access() does not have to wait for it. The prefetched file is not
+    /// subject to eviction until it is accessed, so nothing is done unless it
+    /// fits in the limits of the cache together with the open files and the
+    /// other prefetched files.
+    void prefetch();
+
     /// Same as close() but also generates a log message. This function throws
     /// if logging throws.
     void proper_close();
@@ -108,8 +166,23 @@ private:
 
     std::unique_ptr<File> m_file;
 
+    /// Size of the file when it was opened.
+    std::size_t m_file_size = 0;
+
+    /// Valid while the file is being opened or closed on an I/O thread. The
+    /// prefetched file is owned by the I/O thread until m_prefetching is
+    /// ready.
+    std::unique_ptr<File> m_prefetched_file;
+    std::future<void> m_prefetching;
+    std::shared_future<void> m_closing;
+
+    /// Size of the file when prefetching started.
+    std::size_t m_prefetched_file_size = 0;
+
     void open();
+    void end_prefetch() noexcept;
     void do_close() noexcept;
+    void wait_for_io() noexcept;
 
     friend class ServerFileAccessCache;
 };
@@ -121,28 +194,44 @@ public:
     DBRef shared_group;
 
 private:
+    /// The history is constructed on the accessing thread, because it draws
+    /// from the random number generator of the history context. The file
+    /// itself is opened by open_shared_group().
     File(const Slot&);
 
+    static void open_shared_group(File&, const std::string& realm_path, DBOptions options, bool claim_sync_agent);
+
     friend class Slot;
 };
 
 
 // Implementation
 
-inline ServerFileAccessCache::ServerFileAccessCache(long max_open_files, util::Logger& logger,
-                                                    ServerHistory::Context& history_context,
-                                                    util::Optional<std::array<char, 64>> encryption_key)
-    : m_max_open_files{max_open_files}
-    , m_encryption_key{encryption_key}
-    , m_logger{logger}
-    , m_history_context{history_context}
+inline ServerFileAccessCache::~ServerFileAccessCache() noexcept
 {
-    REALM_ASSERT(m_max_open_files >= 1);
+    REALM_ASSERT(!m_first_open_file);
+    REALM_ASSERT(m_num_prefetched_files == 0);
+    {
+        std::lock_guard lock{m_io_mutex};
+        m_io_stop = true;
+    }
+    m_io_cond.notify_all();
+    for (std::thread& thread : m_io_threads)
+        thread.join();
 }
 
-inline ServerFileAccessCache::~ServerFileAccessCache() noexcept
+inline bool ServerFileAccessCache::has_io_threads() const noexcept
 {
-    REALM_ASSERT(!m_first_open_file);
+    return !m_io_threads.empty();
+}
+
+inline bool ServerFileAccessCache::has_room_for_prefetch(std::size_t file_size) const noexcept
+{
+    if (m_num_open_files + m_num_prefetched_files >= m_max_open_files)
+        return false;
+    if (m_max_open_files_size == 0)
+        return true;
+    return m_open_files_size + m_prefetched_files_size + file_size <= m_max_open_files_size;
 }
 
 inline void ServerFileAccessCache::remove(Slot& slot) noexcept
@@ -197,10 +286,12 @@ inline ServerFileAccessCache::Slot::Slot(ServerFileAccessCache& cache, std::stri
 inline ServerFileAccessCache::Slot::~Slot() noexcept
 {
     close();
+    wait_for_io();
 }
 
 inline bool ServerFileAccessCache::Slot::is_open() const noexcept
 {
+    // A prefetched file is not open until it has been accessed
     if (m_file) {
         REALM_ASSERT(m_prev_open_file);
         REALM_ASSERT(m_next_open_file);
@@ -212,6 +303,11 @@ inline bool ServerFileAccessCache::Slot::is_open() const noexcept
     return false;
 }
 
+inline bool ServerFileAccessCache::Slot::is_prefetching() const noexcept
+{
+    return m_prefetching.valid();
+}
+
 inline auto ServerFileAccessCache::Slot::access() -> File&
 {
     m_cache.access(*this); // Throws
@@ -234,20 +330,38 @@ inline DBOptions ServerFileAccessCache::Slot::make_shared_group_options() const
     return options;
 }
 
-inline void ServerFileAccessCache::Slot::do_close() noexcept
+inline void ServerFileAccessCache::Slot::wait_for_io() noexcept
 {
-    REALM_ASSERT(is_open());
-    --m_cache.m_num_open_files;
-    m_cache.remove(*this);
-    m_file.reset();
+    if (m_prefetching.valid()) {
+        m_prefetching.wait();
+        end_prefetch();
+    }
+    if (m_closing.valid()) {
+        m_closing.wait();
+        m_closing = {};
+    }
+}
+
+inline void ServerFileAccessCache::Slot::end_prefetch() noexcept
+{
+    m_prefetching = {};
+    m_prefetched_file.reset();
+    --m_cache.m_num_prefetched_files;
+    m_cache.m_prefetched_files_size -= m_prefetched_file_size;
+    m_prefetched_file_size = 0;
 }
 
 inline ServerFileAccessCache::File::File(const Slot& slot)
-    : history{slot.m_cache.m_history_context, slot.m_compaction_control}                   // Throws
-    , shared_group{DB::create(history, slot.realm_path, slot.make_shared_group_options())} // Throws
+    : history{slot.m_cache.m_history_context, slot.m_compaction_control} // Throws
+{
+}
+
+inline void ServerFileAccessCache::File::open_shared_group(File& file, const std::string& realm_path,
+                                                           DBOptions options, bool claim_sync_agent)
 {
-    if (slot.m_claim_sync_agent) {
-        shared_group->claim_sync_agent();
+    file.shared_group = DB::create(file.history, realm_path, options); // Throws
+    if (claim_sync_agent) {
+        file.shared_group->claim_sync_agent();
     }
 }
 
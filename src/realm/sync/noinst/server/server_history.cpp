@@ -7,9 +7,11 @@
 #include <realm/sync/impl/clamped_hex_dump.hpp>
 #include <realm/sync/instruction_applier.hpp>
 #include <realm/sync/noinst/compact_changesets.hpp>
+#include <realm/sync/noinst/integer_codec.hpp>
 #include <realm/sync/noinst/server/server_history.hpp>
 #include <realm/table_view.hpp>
 #include <realm/util/hex_dump.hpp>
+#include <realm/util/compression.hpp>
 #include <realm/util/input_stream.hpp>
 #include <realm/util/value_reset_guard.hpp>
 #include <realm/version.hpp>
@@ -215,6 +217,11 @@ History representation
       4 -> int progress_reference_version_salt
     9 -> tagged_int compacted_until_version
    10 -> tagged_int last_compaction_at
+   11 -> mixed_array_ref history_blocks: (optional)
+      0 -> int_bptree_ref hb_end_versions:
+        history_block_index -> server_version (of last changeset in block)
+      1 -> binary_bptree_ref hb_blocks:
+        history_block_index -> compressed block of changesets
 
 
 History compaction
@@ -350,6 +357,16 @@ version_type ServerHistory::get_compacted_until_version() const
 }
 
 
+version_type ServerHistory::get_sealed_until_version() const
+{
+    TransactionRef rt = m_db->start_read(); // Throws
+    version_type realm_version = rt->get_version();
+    const_cast<ServerHistory*>(this)->set_group(rt.get());
+    ensure_updated(realm_version); // Throws
+    return m_sealed_until_version;
+}
+
+
 void ServerHistory::allocate_file_identifiers(FileIdentAllocSlots& slots, VersionInfo& version_info)
 {
     TransactionRef tr = m_db->start_write(); // Throws
@@ -514,8 +531,17 @@ bool ServerHistory::integrate_client_changesets(const IntegratableChangesets& in
             }
 
             if (dirty) {
-                bool force = false;
-                bool dirty_2 = do_compact_history(logger, force); // Throws
+                // When a time budget is specified, compaction is done in
+                // separate passes (compact_history_incrementally()).
+                bool dirty_2 = false;
+                if (m_compaction_time_budget.count() == 0) {
+                    bool force = false;
+                    dirty_2 = do_compact_history(logger, force); // Throws
+                }
+                if (m_history_block_size > 0 && m_compaction_time_budget.count() == 0) {
+                    if (seal_history_block(logger)) // Throws
+                        dirty_2 = true;
+                }
                 if (dirty_2)
                     backup_whole_realm_2 = true;
 
@@ -1012,6 +1038,42 @@ bool ServerHistory::fetch_download_info(file_ident_type client_file_ident, Downl
 }
 
 
+bool ServerHistory::check_shared_download(file_ident_type client_file_ident, version_type begin_version,
+                                          version_type end_version, bool& shareable,
+                                          UploadCursor& upload_progress) const
+{
+    REALM_ASSERT(client_file_ident != 0);
+    REALM_ASSERT(begin_version <= end_version);
+
+    TransactionRef tr = m_db->start_read(); // Throws
+    version_type realm_version = tr->get_version();
+    const_cast<ServerHistory*>(this)->set_group(tr.get());
+    ensure_updated(realm_version); // Throws
+
+    std::size_t client_file_index = std::size_t(client_file_ident);
+    bool expired = (m_acc->cf_last_seen_timestamps.get(client_file_index) == 0);
+    if (REALM_UNLIKELY(expired))
+        return false;
+
+    shareable = false;
+    if (begin_version < m_history_base_version || end_version > get_server_version())
+        return true;
+    for (version_type version = begin_version + 1; version <= end_version; ++version) {
+        std::size_t history_entry_ndx = to_size_t(version - m_history_base_version) - 1;
+        HistoryEntry entry;
+        entry.origin_file_ident = file_ident_type(m_acc->sh_origin_files.get(history_entry_ndx));
+        if (received_from(entry, client_file_ident))
+            return true;
+    }
+    shareable = true;
+
+    version_type upload_client_version = version_type(m_acc->cf_client_versions.get(client_file_index));
+    version_type upload_server_version = version_type(m_acc->cf_rh_base_versions.get(client_file_index));
+    upload_progress = UploadCursor{upload_client_version, upload_server_version};
+    return true;
+}
+
+
 void ServerHistory::add_upstream_sync_status()
 {
     TransactionRef tr = m_db->start_write(); // Throws
@@ -1051,6 +1113,29 @@ bool ServerHistory::compact_history(const TransactionRef& wt, Logger& logger)
 }
 
 
+bool ServerHistory::compact_history_incrementally(std::chrono::milliseconds time_budget, Logger& logger)
+{
+    REALM_ASSERT(time_budget.count() > 0);
+    TransactionRef tr = m_db->start_write(); // Throws
+    version_type realm_version = tr->get_version_of_current_transaction().version;
+    ensure_updated(realm_version); // Throws
+    prepare_for_write();           // Throws
+    bool force = false;
+    bool finished = true;
+    bool dirty = do_compact_history(logger, force, time_budget, &finished); // Throws
+    if (m_history_block_size > 0 && seal_history_block(logger)) { // Throws
+        // There may be more full blocks to seal
+        dirty = true;
+        finished = false;
+    }
+    if (dirty) {
+        auto ta = util::make_temp_assign(m_is_local_changeset, false, true);
+        tr->commit(); // Throws
+    }
+    return !finished;
+}
+
+
 std::vector<sync::Changeset> ServerHistory::get_parsed_changesets(version_type begin, version_type end) const
 {
     TransactionRef rt = m_db->start_read(); // Throws
@@ -1070,7 +1155,7 @@ std::vector<sync::Changeset> ServerHistory::get_parsed_changesets(version_type b
         std::size_t ndx = std::size_t(version - m_history_base_version - 1);
         Changeset changeset;
 
-        auto binary = ChunkedBinaryData{m_acc->sh_changesets, ndx};
+        ChunkedBinaryData binary = get_changeset(version); // Throws
         ChunkedBinaryInputStream stream{binary};
         parse_changeset(stream, changeset); // Throws
 
@@ -1085,7 +1170,8 @@ std::vector<sync::Changeset> ServerHistory::get_parsed_changesets(version_type b
 }
 
 
-bool ServerHistory::do_compact_history(Logger& logger, bool force)
+bool ServerHistory::do_compact_history(Logger& logger, bool force, std::chrono::milliseconds time_budget,
+                                       bool* finished)
 {
     // NOTE: For an overview of the in-place history compaction mechanism, see
     // `/doc/history_compaction.md` in the `realm-sync` Git repository.
@@ -1312,13 +1398,25 @@ bool ServerHistory::do_compact_history(Logger& logger, bool force)
 
     dirty = true;
 
+    // An incremental pass continues after the history entries compacted by
+    // the previous passes, and stops reading more entries when half of the
+    // time budget has been spent, leaving the other half for compacting and
+    // writing back the ones that were read.
+    bool incremental = (time_budget.count() != 0);
+    auto deadline = std::chrono::steady_clock::now() + time_budget / 2;
+    bool out_of_time = false;
+
     std::size_t num_compactable_changesets = std::size_t(can_compact_until_version - m_history_base_version);
-    version_type compaction_begin_version = m_history_base_version; // always 0 for now
+    version_type compaction_begin_version = (incremental ? compacted_until_version : m_history_base_version);
+    // Sealed history entries are not compacted again
+    compaction_begin_version = std::min(std::max(compaction_begin_version, m_sealed_until_version),
+                                        can_compact_until_version);
+    version_type first_compacted_version = compaction_begin_version;
     std::size_t before_size = 0;
     std::size_t after_size = 0;
 
     // Chunk compactions to limit memory usage.
-    while (compaction_begin_version < can_compact_until_version) {
+    while (compaction_begin_version < can_compact_until_version && !out_of_time) {
         auto num_compactable_changesets_this_iteration =
             size_t(num_compactable_changesets - (compaction_begin_version - m_history_base_version));
         std::vector<Changeset> compact_bootstrap_changesets;
@@ -1348,29 +1446,38 @@ bool ServerHistory::do_compact_history(Logger& logger, bool force)
             end_version = server_version;
             if (compaction_input_size >= compaction_input_soft_limit)
                 break;
+            if (incremental && std::chrono::steady_clock::now() >= deadline) {
+                out_of_time = true;
+                break;
+            }
         }
+        // Only the changesets that were read can be written back
+        compact_bootstrap_changesets.resize(std::size_t(end_version - begin_version));
 
         compact_changesets(compact_bootstrap_changesets.data(),
                            compact_bootstrap_changesets.size()); // Throws
 
 
         ChangesetEncoder::Buffer buffer;
-        for (std::size_t i = 0; i < num_compactable_changesets_this_iteration; ++i) {
+        for (std::size_t i = 0; i < compact_bootstrap_changesets.size(); ++i) {
             buffer.clear();
             encode_changeset(compact_bootstrap_changesets[i], buffer);
             after_size += buffer.size();
             version_type server_version = begin_version + i + 1;
-            m_acc->sh_changesets.set(size_t(server_version - 1), BinaryData{buffer.data(), buffer.size()}); // Throws
+            m_acc->sh_changesets.set(size_t(server_version - 1 - m_history_base_version),
+                                     BinaryData{buffer.data(), buffer.size()}); // Throws
         }
         compaction_begin_version = end_version;
     }
 
-    // Recalculate the cumulative byte sizes.
+    // Recalculate the cumulative byte sizes, starting at the first rewritten
+    // history entry.
     {
         size_t num_history_entries = m_acc->sh_changesets.size();
         REALM_ASSERT(m_acc->sh_cumul_byte_sizes.size() == num_history_entries);
-        size_t history_byte_size = 0;
-        for (size_t i = 0; i < num_history_entries; ++i) {
+        size_t begin = size_t(first_compacted_version - m_history_base_version);
+        size_t history_byte_size = (begin == 0 ? 0 : size_t(m_acc->sh_cumul_byte_sizes.get(begin - 1)));
+        for (size_t i = begin; i < num_history_entries; ++i) {
             size_t changeset_size = ChunkedBinaryData(m_acc->sh_changesets, i).size();
             history_byte_size += changeset_size;
             m_acc->sh_cumul_byte_sizes.set(i, history_byte_size);
@@ -1380,19 +1487,28 @@ bool ServerHistory::do_compact_history(Logger& logger, bool force)
     // Get new 'now' because compaction can potentially take a long time, and
     // if it takes longer than the server's average history compaction
     // interval, the server could end up spending all its time doing compaction.
+    //
+    // The time of the last compaction is only updated when everything that
+    // could be compacted has been, so that the passes of an unfinished
+    // incremental compaction are not subject to the compaction interval.
     auto new_now = m_context.get_compaction_clock_now();
-    auto new_now_2 = chrono::duration_cast<chrono::seconds>(new_now.time_since_epoch());
-    auto new_now_3 = std::int_fast64_t(new_now_2.count());
-    m_acc->root.set(s_last_compaction_timestamp_iip, RefOrTagged::make_tagged(new_now_3)); // Throws
+    bool finished_2 = (compaction_begin_version == can_compact_until_version);
+    if (finished_2) {
+        auto new_now_2 = chrono::duration_cast<chrono::seconds>(new_now.time_since_epoch());
+        auto new_now_3 = std::int_fast64_t(new_now_2.count());
+        m_acc->root.set(s_last_compaction_timestamp_iip, RefOrTagged::make_tagged(new_now_3)); // Throws
+    }
+    if (finished)
+        *finished = finished_2;
 
-    REALM_ASSERT(can_compact_until_version >
+    REALM_ASSERT(compaction_begin_version >
                  version_type(m_acc->root.get_as_ref_or_tagged(s_compacted_until_version_iip).get_as_int()));
     m_acc->root.set(s_compacted_until_version_iip,
-                    RefOrTagged::make_tagged(can_compact_until_version)); // Throws
+                    RefOrTagged::make_tagged(compaction_begin_version)); // Throws
 
     logger.detail("History compaction: Processed %1 changesets (saved %2 bytes in %3 "
                   "milliseconds)",
-                  num_compactable_changesets, before_size - after_size,
+                  std::size_t(compaction_begin_version - first_compacted_version), before_size - after_size,
                   chrono::duration_cast<chrono::milliseconds>(new_now - now).count()); // Throws
     return dirty;
 }
@@ -1546,13 +1662,13 @@ public:
     }
 
     version_type find_history_entry(version_type begin_version, version_type end_version,
-                                    HistoryEntry& entry) const noexcept override final
+                                    HistoryEntry& entry) const override final
     {
         return m_history.find_history_entry(m_remote_file_ident, begin_version, end_version, entry);
     }
 
     ChunkedBinaryData get_reciprocal_transform(version_type server_version,
-                                               bool& is_compressed) const noexcept override final
+                                               bool& is_compressed) const override final
     {
         is_compressed = false;
         ChunkedBinaryData transform;
@@ -1751,6 +1867,17 @@ void ServerHistory::upgrade_history_schema(int stored_schema_version)
     REALM_ASSERT(stored_schema_version >= 1);
     int orig_schema_version = stored_schema_version;
     int schema_version = orig_schema_version;
+    if (schema_version < 21) {
+        // Add the slot for the optional `history_blocks` array
+        using gf = _impl::GroupFriend;
+        Allocator& alloc = gf::get_alloc(*m_group);
+        Array root{alloc};
+        gf::set_history_parent(*m_group, root);
+        root.init_from_ref(gf::get_history_ref(*m_group));
+        REALM_ASSERT(root.size() == s_history_blocks_iip);
+        root.add(0); // Throws
+        schema_version = 21;
+    }
     // NOTE: Future migration steps go here.
 
     REALM_ASSERT(schema_version == get_server_history_schema_version());
@@ -1967,11 +2094,30 @@ void ServerHistory::verify() const
             client_file.last_integrated_client_version = client_version;
         }
 
-        std::size_t changeset_size = ChunkedBinaryData(m_acc->sh_changesets, i).size();
+        version_type server_version = m_history_base_version + i + 1;
+        if (server_version <= m_sealed_until_version)
+            REALM_ASSERT(m_acc->sh_changesets.get(i).size() == 0);
+        std::size_t changeset_size = get_changeset(server_version).size();
         accum_byte_size += changeset_size;
         REALM_ASSERT(m_acc->sh_cumul_byte_sizes.get(i) == accum_byte_size);
     }
 
+    // Check sealed history blocks
+    if (m_acc->history_blocks.is_attached()) {
+        m_acc->hb_end_versions.verify();
+        m_acc->hb_blocks.verify();
+        std::size_t num_history_blocks = m_acc->hb_end_versions.size();
+        REALM_ASSERT(m_acc->hb_blocks.size() == num_history_blocks);
+        version_type prev_end_version = m_history_base_version;
+        for (std::size_t i = 0; i < num_history_blocks; ++i) {
+            auto end_version = version_type(m_acc->hb_end_versions.get(i));
+            REALM_ASSERT(end_version > prev_end_version);
+            prev_end_version = end_version;
+        }
+        REALM_ASSERT(prev_end_version == m_sealed_until_version);
+        REALM_ASSERT(m_sealed_until_version <= get_server_version());
+    }
+
     // Check client file entries
     version_type current_server_version = m_history_base_version + m_history_size;
     REALM_ASSERT(m_num_client_files >= 2);
@@ -2081,6 +2227,7 @@ void ServerHistory::verify() const
 void ServerHistory::discard_accessors() const noexcept
 {
     m_acc = util::none;
+    m_decoded_history_blocks.clear();
 }
 
 
@@ -2117,9 +2264,11 @@ void ServerHistory::update_from_ref_and_version(ref_type ref, version_type realm
         m_server_version_salt = 0;
         m_ct_base_version = realm_version;
         m_ct_history_size = 0;
+        m_sealed_until_version = 0;
         discard_accessors();
         return;
     }
+    m_decoded_history_blocks.clear();
     if (REALM_LIKELY(m_acc)) {
         m_acc->init_from_ref(ref); // Throws
     }
@@ -2136,6 +2285,9 @@ void ServerHistory::update_from_ref_and_version(ref_type ref, version_type realm
         if (m_acc->partial_sync.is_attached()) {
             REALM_ASSERT(m_acc->partial_sync.size() == s_partial_sync_size);
         }
+        if (m_acc->history_blocks.is_attached()) {
+            REALM_ASSERT(m_acc->history_blocks.size() == s_history_blocks_size);
+        }
         dag.release();
     }
 
@@ -2164,6 +2316,11 @@ void ServerHistory::update_from_ref_and_version(ref_type ref, version_type realm
     REALM_ASSERT(m_acc->sh_timestamps.size() == m_history_size);
     REALM_ASSERT(m_acc->sh_cumul_byte_sizes.size() == m_history_size);
 
+    std::size_t num_history_blocks = (m_acc->history_blocks.is_attached() ? m_acc->hb_end_versions.size() : 0);
+    m_sealed_until_version =
+        (num_history_blocks > 0 ? version_type(m_acc->hb_end_versions.get(num_history_blocks - 1))
+                                : m_history_base_version);
+
     m_server_version_salt =
         (m_history_size > 0 ? salt_type(m_acc->sh_version_salts.get(m_history_size - 1))
                             : salt_type(m_acc->root.get_as_ref_or_tagged(s_base_version_salt_iip).get_as_int()));
@@ -2205,6 +2362,18 @@ void ServerHistory::Accessors::init_from_ref(ref_type ref)
     sh_cumul_byte_sizes.init_from_parent();       // Throws
     ct_history.init_from_parent();                // Throws
 
+    {
+        ref_type ref_2 = history_blocks.get_ref_from_parent();
+        if (ref_2 != 0) {
+            history_blocks.init_from_ref(ref_2);
+            hb_end_versions.init_from_parent(); // Throws
+            hb_blocks.init_from_parent();       // Throws
+        }
+        else {
+            history_blocks.detach();
+        }
+    }
+
     // Note: If anything throws above, then accessors will be left in an
     // undefined state. However, all IntegerBpTree accessors will still have
     // a root array, and all optional BinaryColumn accessors will still
@@ -2255,8 +2424,8 @@ void ServerHistory::Accessors::create()
     // way. This means that we need destruction guards for arrays, but not
     // BPlusTrees/BinaryColumns.
 
-    // Note: The arrays `upstream_status` and `partial_sync` are created
-    // on-demand instead of here.
+    // Note: The arrays `upstream_status`, `partial_sync`, and `history_blocks`
+    // are created on-demand instead of here.
 
     bool context_flag_no = false;
     root.create(Array::type_HasRefs, context_flag_no, s_root_size); // Throws
@@ -2400,14 +2569,173 @@ void ServerHistory::trim_cont_transact_history()
 }
 
 
-ChunkedBinaryData ServerHistory::get_changeset(version_type server_version) const noexcept
+ChunkedBinaryData ServerHistory::get_changeset(version_type server_version) const
 {
     REALM_ASSERT(server_version > m_history_base_version && server_version <= get_server_version());
+    if (server_version <= m_sealed_until_version) {
+        // Find the first block whose end version is not less than the
+        // requested version.
+        std::size_t begin = 0, end = m_acc->hb_end_versions.size();
+        while (begin < end) {
+            std::size_t mid = begin + (end - begin) / 2;
+            if (version_type(m_acc->hb_end_versions.get(mid)) < server_version) {
+                begin = mid + 1;
+            }
+            else {
+                end = mid;
+            }
+        }
+        const DecodedHistoryBlock& block = get_decoded_history_block(begin); // Throws
+        std::size_t i = to_size_t(server_version - block.begin_version) - 1;
+        const char* data = block.buffer.get() + block.offsets[i];
+        return BinaryData{data, block.offsets[i + 1] - block.offsets[i]};
+    }
     std::size_t history_entry_ndx = to_size_t(server_version - m_history_base_version) - 1;
     return ChunkedBinaryData(m_acc->sh_changesets, history_entry_ndx);
 }
 
 
+// A sealed history block is stored as the compressed form of the following:
+//
+//     num_changesets (integer)
+//     changeset_size (integer) x num_changesets
+//     changeset data (bytes), concatenated in order of server version
+//
+// where integers are encoded using `_impl::encode_int()`. The changesets are
+// stored byte for byte as they were in `sh_changesets`, so that a sealed
+// history entry is indistinguishable from an unsealed one to readers, and the
+// cumulative byte sizes of the history remain unaffected by sealing.
+auto ServerHistory::get_decoded_history_block(std::size_t block_index) const -> const DecodedHistoryBlock&
+{
+    auto i = m_decoded_history_blocks.find(block_index);
+    if (i != m_decoded_history_blocks.end())
+        return i->second;
+
+    REALM_ASSERT(block_index < m_acc->hb_blocks.size());
+    ChunkedBinaryData compressed{m_acc->hb_blocks, block_index};
+    ChunkedBinaryInputStream stream{compressed};
+    util::AppendBuffer<char> decompressed;
+    if (std::error_code ec = util::compression::decompress_nonportable(stream, decompressed)) // Throws
+        throw std::system_error(ec, "Failed to decompress sealed history block");
+
+    DecodedHistoryBlock block;
+    block.begin_version =
+        (block_index == 0 ? m_history_base_version : version_type(m_acc->hb_end_versions.get(block_index - 1)));
+    const char* begin = decompressed.data();
+    const char* end = begin + decompressed.size();
+    auto bad_block = [] {
+        throw std::runtime_error("Bad sealed history block");
+    };
+    auto read_size = [&] {
+        std::size_t value = 0;
+        std::size_t n = _impl::decode_int(begin, std::size_t(end - begin), value);
+        if (n == 0)
+            bad_block();
+        begin += n;
+        return value;
+    };
+    std::size_t num_changesets = read_size();
+    block.offsets.reserve(num_changesets + 1); // Throws
+    block.offsets.push_back(0);                // Throws
+    for (std::size_t j = 0; j < num_changesets; ++j) {
+        std::size_t size = read_size();
+        block.offsets.push_back(block.offsets.back() + size); // Throws
+    }
+    std::size_t data_size = std::size_t(end - begin);
+    if (block.offsets.back() != data_size)
+        bad_block();
+    if (version_type(m_acc->hb_end_versions.get(block_index)) != block.begin_version + num_changesets)
+        bad_block();
+    block.buffer = std::make_unique<char[]>(data_size); // Throws
+    std::copy(begin, end, block.buffer.get());
+    auto j = m_decoded_history_blocks.emplace(block_index, std::move(block)).first; // Throws
+    return j->second;
+}
+
+
+// Seals the first `m_history_block_size` unsealed history entries into a
+// compressed history block, provided that they have all been compacted, or, if
+// history compaction is disabled, that they are followed by at least a block
+// size worth of newer history entries. The most recent history entries are
+// left unsealed, as they are the ones most often read when producing DOWNLOAD
+// messages. At most one block is sealed per invocation to bound the duration
+// of the write transaction.
+//
+// Returns true if, and only if a block was sealed.
+bool ServerHistory::seal_history_block(Logger& logger)
+{
+    REALM_ASSERT(m_history_block_size > 0);
+    version_type begin_version = m_sealed_until_version;
+    version_type end_version = begin_version + m_history_block_size;
+    version_type limit_version = get_server_version();
+    if (m_enable_compaction) {
+        limit_version = version_type(m_acc->root.get_as_ref_or_tagged(s_compacted_until_version_iip).get_as_int());
+    }
+    else {
+        limit_version -= std::min<version_type>(limit_version, m_history_block_size);
+    }
+    if (end_version > limit_version)
+        return false;
+
+    if (!m_acc->history_blocks.is_attached()) {
+        bool context_flag_no = false;
+        m_acc->history_blocks.create(Array::type_HasRefs, context_flag_no, s_history_blocks_size); // Throws
+        _impl::DeepArrayDestroyGuard adg{&m_acc->history_blocks};
+        m_acc->hb_end_versions.create(); // Throws
+        m_acc->hb_blocks.create();       // Throws
+        adg.release();
+        m_acc->history_blocks.update_parent(); // Throws
+    }
+
+    std::size_t begin = std::size_t(begin_version - m_history_base_version);
+    std::size_t end = std::size_t(end_version - m_history_base_version);
+    util::AppendBuffer<char> sizes;
+    util::AppendBuffer<char> data;
+    util::AppendBuffer<char> changeset;
+    char buffer[_impl::encode_int_max_bytes<std::size_t>()];
+    sizes.append(buffer, _impl::encode_int(buffer, end - begin)); // Throws
+    for (std::size_t i = begin; i < end; ++i) {
+        ChunkedBinaryData(m_acc->sh_changesets, i).copy_to(changeset);      // Throws
+        sizes.append(buffer, _impl::encode_int(buffer, changeset.size())); // Throws
+        data.append(changeset.data(), changeset.size());                   // Throws
+    }
+    std::size_t uncompressed_size = data.size();
+    sizes.append(data.data(), data.size()); // Throws
+    data.clear();
+
+    util::AppendBuffer<char> compressed =
+        util::compression::allocate_and_compress_nonportable({sizes.data(), sizes.size()}); // Throws
+    m_acc->hb_end_versions.add(std::int64_t(end_version));                 // Throws
+    m_acc->hb_blocks.add(BinaryData{compressed.data(), compressed.size()}); // Throws
+    for (std::size_t i = begin; i < end; ++i)
+        m_acc->sh_changesets.set(i, BinaryData{"", 0}); // Throws
+    m_sealed_until_version = end_version;
+
+    logger.detail("Sealed history entries %1 to %2 into a block of %3 bytes (was %4 bytes)", begin_version + 1,
+                  end_version, compressed.size(), uncompressed_size); // Throws
+    return true;
+}
+
+
+// Writes the changesets of all sealed history entries back into
+// `sh_changesets`, and removes the sealed history blocks.
+void ServerHistory::unseal_history()
+{
+    if (!m_acc->history_blocks.is_attached())
+        return;
+    for (version_type version = m_history_base_version + 1; version <= m_sealed_until_version; ++version) {
+        util::AppendBuffer<char> changeset;
+        get_changeset(version).copy_to(changeset); // Throws
+        m_acc->sh_changesets.set(std::size_t(version - m_history_base_version - 1),
+                                 BinaryData{changeset.data(), changeset.size()}); // Throws
+    }
+    m_acc->history_blocks.destroy_deep();
+    m_acc->root.set(s_history_blocks_iip, 0); // Throws
+    m_sealed_until_version = m_history_base_version;
+    m_decoded_history_blocks.clear();
+}
+
+
 // Skips history entries with empty changesets, and history entries produced by
 // integration of changes received from the specified remote file.
 //
@@ -2418,7 +2746,7 @@ ChunkedBinaryData ServerHistory::get_changeset(version_type server_version) cons
 // produced by the changeset of the located history entry.
 auto ServerHistory::find_history_entry(file_ident_type remote_file_ident, version_type begin_version,
                                        version_type end_version, HistoryEntry& entry,
-                                       version_type& last_integrated_remote_version) const noexcept -> version_type
+                                       version_type& last_integrated_remote_version) const -> version_type
 {
     REALM_ASSERT(remote_file_ident != g_root_node_file_ident);
     REALM_ASSERT(begin_version >= m_history_base_version);
@@ -2445,19 +2773,18 @@ auto ServerHistory::find_history_entry(file_ident_type remote_file_ident, versio
 }
 
 
-auto ServerHistory::get_history_entry(version_type server_version) const noexcept -> HistoryEntry
+auto ServerHistory::get_history_entry(version_type server_version) const -> HistoryEntry
 {
     REALM_ASSERT(server_version > m_history_base_version && server_version <= get_server_version());
     std::size_t history_entry_ndx = to_size_t(server_version - m_history_base_version) - 1;
     auto origin_file = m_acc->sh_origin_files.get(history_entry_ndx);
     auto client_version = m_acc->sh_client_versions.get(history_entry_ndx);
     auto timestamp = m_acc->sh_timestamps.get(history_entry_ndx);
-    ChunkedBinaryData chunked_changeset(m_acc->sh_changesets, history_entry_ndx);
     HistoryEntry entry;
     entry.origin_file_ident = file_ident_type(origin_file);
     entry.remote_version = version_type(client_version);
     entry.origin_timestamp = timestamp_type(timestamp);
-    entry.changeset = chunked_changeset;
+    entry.changeset = get_changeset(server_version); // Throws
     return entry;
 }
 
@@ -2536,7 +2863,7 @@ auto ServerHistory::get_history_contents() const -> HistoryContents
         he.client_version = m_acc->sh_client_versions.get(i);
         he.timestamp = m_acc->sh_timestamps.get(i);
         he.cumul_byte_size = m_acc->sh_cumul_byte_sizes.get(i);
-        ChunkedBinaryData chunked_changeset(m_acc->sh_changesets, i);
+        ChunkedBinaryData chunked_changeset = get_changeset(m_history_base_version + i + 1);
         chunked_changeset.copy_to(buffer);
         he.changeset = std::string(buffer.data(), buffer.size());
         hc.sync_history.push_back(he);
@@ -2578,7 +2905,9 @@ void ServerHistory::fixup_state_and_changesets_for_assigned_file_ident(Transacti
     };
 
     // Fix up changesets in history. We know that all of these are of our own
-    // creation.
+    // creation. They are rewritten in place, so any sealed history blocks are
+    // dissolved first.
+    unseal_history(); // Throws
     for (std::size_t i = 0; i < m_acc->sh_changesets.size(); ++i) {
         ChunkedBinaryData changeset{m_acc->sh_changesets, i};
         ChunkedBinaryInputStream in{changeset};
@@ -2698,6 +3027,18 @@ Clock::time_point ServerHistory::Context::get_compaction_clock_now() const noexc
 }
 
 
+std::chrono::milliseconds ServerHistory::Context::get_compaction_time_budget() const noexcept
+{
+    return std::chrono::milliseconds{0};
+}
+
+
+std::size_t ServerHistory::Context::get_history_block_size() const noexcept
+{
+    return 0;
+}
+
+
 Transformer& ServerHistory::Context::get_transformer()
 {
     throw util::runtime_error("Not supported");
@@ -4,6 +4,8 @@
 
 #include <cstdint>
 #include <ctime>
+#include <map>
+#include <memory>
 #include <random>
 #include <string>
 #include <unordered_map>
@@ -97,10 +99,14 @@ namespace _impl {
 // 11..19 Reserved
 //
 // 20  ObjectIDHistoryState enhanced with m_table_map
+//
+// 21  Added optional subarray `ServerHistory::Accessors::history_blocks`
+//     holding compressed blocks of consecutive changesets, whose entries in
+//     `sh_changesets` have been emptied (sealed history blocks).
 
 constexpr int get_server_history_schema_version() noexcept
 {
-    return 20;
+    return 21;
 }
 
 
@@ -240,6 +246,9 @@ public:
     /// For testing purposes
     version_type get_compacted_until_version() const;
 
+    /// For testing purposes
+    version_type get_sealed_until_version() const;
+
     /// Validate the specified client file identifier, download progress, and
     /// server version as received in an IDENT message. If they are valid, fetch
     /// the upload progress representing the last integrated changeset from the
@@ -393,6 +402,22 @@ public:
                              std::uint_fast64_t& cumulative_byte_size_total, bool disable_download_compaction,
                              std::size_t accum_byte_size_soft_limit = 0x20000) const;
 
+    /// Determine whether the changesets that fetch_download_info() produced
+    /// for another client file, for the range of server versions from \a
+    /// begin_version to \a end_version, are also the ones it would produce for
+    /// the specified client file. This is the case when none of the changesets
+    /// in the range were received from the specified client file, and the last
+    /// client version integrated before the range is the same. Only the origin
+    /// of each history entry is inspected, not the changesets themselves.
+    ///
+    /// If \a shareable is set to true, \a upload_progress is set as
+    /// fetch_download_info() would have set it.
+    ///
+    /// \return False if the client file entry of the specified client file has
+    /// expired. Otherwise true.
+    bool check_shared_download(file_ident_type client_file_ident, version_type begin_version,
+                               version_type end_version, bool& shareable, UploadCursor& upload_progress) const;
+
     /// The application must call this function before using the history as an
     /// upstream client history.
     ///
@@ -405,6 +430,20 @@ public:
 
     bool compact_history(const TransactionRef&, util::Logger&);
 
+    /// Run one pass of incremental in-place history compaction in a write
+    /// transaction of its own. The pass continues from where the previous one
+    /// stopped, as recorded by the compacted-until version in the file, and
+    /// compacts as many history entries as it can within approximately \a
+    /// time_budget. At least one entry is compacted per pass.
+    ///
+    /// This is how history compaction is done when the context specifies a
+    /// time budget (Context::get_compaction_time_budget()). In that case,
+    /// integrate_client_changesets() does not compact the history.
+    ///
+    /// \return True if more passes are needed to compact all the history that
+    /// can currently be compacted.
+    bool compact_history_incrementally(std::chrono::milliseconds time_budget, util::Logger&);
+
     /// Perform a transaction on the shared group associated with this
     /// history. If the handler returns true, the transaction will be comitted,
     /// and the version info will be set accordingly. If the handler returns
@@ -502,12 +541,13 @@ private:
     // clang-format off
 
     // Sizes of fixed-size arrays
-    static constexpr int s_root_size = 11;
+    static constexpr int s_root_size = 12;
     static constexpr int s_client_files_size = 8;
     static constexpr int s_sync_history_size = 6;
     static constexpr int s_upstream_status_size = 8;
     static constexpr int s_partial_sync_size = 5;
     static constexpr int s_schema_versions_size = 4;
+    static constexpr int s_history_blocks_size = 2;
 
     // Slots in root array of history compartment
     static constexpr int s_client_files_iip = 0;              // table ref
@@ -521,6 +561,7 @@ private:
     static constexpr int s_compacted_until_version_iip = 8;   // version
     static constexpr int s_last_compaction_timestamp_iip = 9; // UNIX timestamp (in seconds)
     static constexpr int s_schema_versions_iip = 10;          // ref
+    static constexpr int s_history_blocks_iip = 11;           // optional array ref
 
     // Slots in root array of `client_files` table
     static constexpr int s_cf_ident_salts_iip = 0;            // column ref
@@ -563,6 +604,10 @@ private:
     static constexpr int s_sv_snapshot_versions_iip = 2; // integer (version_type)
     static constexpr int s_sv_timestamps_iip = 3;        // integer (seconds since epoch)
 
+    // Slots in Accessors::history_blocks
+    static constexpr int s_hb_end_versions_iip = 0; // column ref
+    static constexpr int s_hb_blocks_iip = 1;       // column ref
+
     // clang-format on
 
     struct Accessors {
@@ -572,6 +617,7 @@ private:
         Array upstream_status; // Optional
         Array partial_sync;    // Optional
         Array schema_versions;
+        Array history_blocks;  // Optional
 
         // Columns of Accessors::client_files
         BPlusTree<int64_t> cf_ident_salts;
@@ -594,6 +640,10 @@ private:
         // Continuous transactions history
         BinaryColumn ct_history;
 
+        // Columns of Accessors::history_blocks
+        BPlusTree<int64_t> hb_end_versions;
+        BinaryColumn hb_blocks;
+
         Accessors(Allocator&) noexcept;
 
         void set_parent(ArrayParent* parent, size_t ndx_in_parent) noexcept;
@@ -676,6 +726,23 @@ private:
     bool m_compaction_ignore_clients = false;
     std::chrono::seconds m_compaction_ttl;
     std::chrono::seconds m_compaction_interval;
+    std::chrono::milliseconds m_compaction_time_budget;
+    std::size_t m_history_block_size;
+
+    // Server version produced by the last changeset in the last sealed history
+    // block (Accessors::history_blocks), or `m_history_base_version` if no
+    // blocks have been sealed.
+    mutable version_type m_sealed_until_version;
+
+    // Sealed history blocks that have been decompressed during the current
+    // transaction, indexed by block. The changesets handed out by
+    // get_changeset() for sealed history entries refer into these buffers.
+    struct DecodedHistoryBlock {
+        version_type begin_version;
+        std::unique_ptr<char[]> buffer;
+        std::vector<std::size_t> offsets; // One more than the number of changesets
+    };
+    mutable std::map<std::size_t, DecodedHistoryBlock> m_decoded_history_blocks;
 
     std::vector<file_ident_type> m_client_file_order_buffer;
 
@@ -688,13 +755,16 @@ private:
     void add_core_history_entry(BinaryData);
     void add_sync_history_entry(const HistoryEntry&);
     void trim_cont_transact_history();
-    ChunkedBinaryData get_changeset(version_type server_version) const noexcept;
+    ChunkedBinaryData get_changeset(version_type server_version) const;
+    const DecodedHistoryBlock& get_decoded_history_block(std::size_t block_index) const;
+    bool seal_history_block(util::Logger&);
+    void unseal_history();
     version_type find_history_entry(file_ident_type remote_file_ident, version_type begin_version,
-                                    version_type end_version, HistoryEntry&) const noexcept;
+                                    version_type end_version, HistoryEntry&) const;
     version_type find_history_entry(file_ident_type remote_file_ident, version_type begin_version,
                                     version_type end_version, HistoryEntry&,
-                                    version_type& last_integrated_remote_version) const noexcept;
-    HistoryEntry get_history_entry(version_type server_version) const noexcept;
+                                    version_type& last_integrated_remote_version) const;
+    HistoryEntry get_history_entry(version_type server_version) const;
     bool received_from(const HistoryEntry&, file_ident_type remote_file_ident) const noexcept;
 
     SaltedFileIdent allocate_file_ident(file_ident_type proxy_file_ident, ClientType);
@@ -747,7 +817,12 @@ private:
 
     // Returns true if, and only if changes were made to the Realm file (state
     // or history compartment).
-    bool do_compact_history(util::Logger& logger, bool force);
+    //
+    // If `time_budget` is nonzero, only a part of the compactable history may
+    // be compacted, and `finished` is set to false if more remains.
+    bool do_compact_history(util::Logger& logger, bool force,
+                            std::chrono::milliseconds time_budget = std::chrono::milliseconds{0},
+                            bool* finished = nullptr);
 
     void fixup_state_and_changesets_for_assigned_file_ident(Transaction&, file_ident_type);
 
@@ -795,6 +870,25 @@ public:
     /// The default implementation returns the current time of the system clock.
     virtual sync::Clock::time_point get_compaction_clock_now() const noexcept;
 
+    /// If this returns a nonzero duration, history compaction is done in
+    /// passes of approximately that duration by
+    /// ServerHistory::compact_history_incrementally(), which the owner of the
+    /// history is then responsible for calling, rather than as part of the
+    /// integration of client changesets.
+    ///
+    /// The default implementation returns zero.
+    virtual std::chrono::milliseconds get_compaction_time_budget() const noexcept;
+
+    /// If this returns a nonzero number, the changesets of the main history
+    /// are, once that many consecutive changesets have been compacted (or have
+    /// been superseded by a block size worth of newer changesets when history
+    /// compaction is disabled), sealed into a compressed block. Sealed
+    /// changesets take up much less space in the Realm file, but must be
+    /// decompressed, a block at a time, to be read.
+    ///
+    /// The default implementation returns zero.
+    virtual std::size_t get_history_block_size() const noexcept;
+
 protected:
     Context() noexcept = default;
 };
@@ -868,6 +962,8 @@ inline ServerHistory::ServerHistory(Context& context, CompactionControl& compact
 {
     m_enable_compaction =
         context.get_compaction_params(m_compaction_ignore_clients, m_compaction_ttl, m_compaction_interval);
+    m_compaction_time_budget = context.get_compaction_time_budget();
+    m_history_block_size = context.get_history_block_size();
 
     // The synchronization protocol specification requires that server version
     // salts are nonzero positive integers that fit in 63 bits.
@@ -895,6 +991,7 @@ inline ServerHistory::Accessors::Accessors(Allocator& alloc) noexcept
     , upstream_status{alloc}
     , partial_sync{alloc}
     , schema_versions{alloc}
+    , history_blocks{alloc}
     , cf_ident_salts{alloc}
     , cf_client_versions{alloc}
     , cf_rh_base_versions{alloc}
@@ -910,12 +1007,15 @@ inline ServerHistory::Accessors::Accessors(Allocator& alloc) noexcept
     , sh_changesets{alloc}
     , sh_cumul_byte_sizes{alloc}
     , ct_history{alloc}
+    , hb_end_versions{alloc}
+    , hb_blocks{alloc}
 {
     client_files.set_parent(&root, s_client_files_iip);
     sync_history.set_parent(&root, s_sync_history_iip);
     upstream_status.set_parent(&root, s_upstream_status_iip);
     partial_sync.set_parent(&root, s_partial_sync_iip);
     schema_versions.set_parent(&root, s_schema_versions_iip);
+    history_blocks.set_parent(&root, s_history_blocks_iip);
 
     cf_ident_salts.set_parent(&client_files, s_cf_ident_salts_iip);
     cf_client_versions.set_parent(&client_files, s_cf_client_versions_iip);
@@ -934,6 +1034,9 @@ inline ServerHistory::Accessors::Accessors(Allocator& alloc) noexcept
     sh_cumul_byte_sizes.set_parent(&sync_history, s_sh_cumul_byte_sizes_iip);
 
     ct_history.set_parent(&root, s_ct_history_iip);
+
+    hb_end_versions.set_parent(&history_blocks, s_hb_end_versions_iip);
+    hb_blocks.set_parent(&history_blocks, s_hb_blocks_iip);
 }
 
 inline void ServerHistory::Accessors::set_parent(ArrayParent* parent, size_t index) noexcept
@@ -964,7 +1067,7 @@ inline auto ServerHistory::get_salted_server_version() const noexcept -> SaltedV
 }
 
 inline auto ServerHistory::find_history_entry(file_ident_type remote_file_ident, version_type begin_version,
-                                              version_type end_version, HistoryEntry& entry) const noexcept
+                                              version_type end_version, HistoryEntry& entry) const
     -> version_type
 {
     version_type last_integrated_remote_version; // Dummy
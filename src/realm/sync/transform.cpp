@@ -27,6 +27,7 @@
 #include <realm/sync/noinst/changeset_index.hpp>
 #include <realm/sync/noinst/protocol_codec.hpp>
 #include <realm/util/logger.hpp>
+#include <realm/util/parallel_for.hpp>
 
 namespace realm {
 
@@ -2530,6 +2531,18 @@ void TransformerImpl::transform_remote_changesets(TransformHistory& history, fil
     std::vector<Changeset*> our_changesets;
 
     try {
+        // All the ranges below are merged against local changesets with versions
+        // in the range (lowest base, current_local_version].
+        if (num_changesets > 0) {
+            auto lowest_base = std::min_element(parsed_changesets, parsed_changesets + num_changesets,
+                                                [](const Changeset& a, const Changeset& b) {
+                                                    return a.last_integrated_remote_version <
+                                                           b.last_integrated_remote_version;
+                                                });
+            prefetch_reciprocal_transforms(history, local_file_ident, lowest_base->last_integrated_remote_version,
+                                           current_local_version); // Throws
+        }
+
         // p points to the beginning of a range of changesets that share the same
         // "base", i.e. are based on the same local version.
         auto p = parsed_changesets;
@@ -2593,29 +2606,86 @@ Changeset& TransformerImpl::get_reciprocal_transform(TransformHistory& history,
         bool is_compressed = false;
         ChunkedBinaryData data = history.get_reciprocal_transform(version, is_compressed);
         ChunkedBinaryInputStream in{data};
-        Changeset& changeset = *i->second;
-        if (is_compressed) {
-            size_t total_size;
-            auto decompressed = util::compression::decompress_nonportable_input_stream(in, total_size);
-            REALM_ASSERT(decompressed);
-            sync::parse_changeset(*decompressed, changeset); // Throws
-        }
-        else {
-            sync::parse_changeset(in, changeset); // Throws
-        }
-
-        changeset.version = version;
-        changeset.last_integrated_remote_version = history_entry.remote_version;
-        changeset.origin_timestamp = history_entry.origin_timestamp;
-        file_ident_type origin_file_ident = history_entry.origin_file_ident;
-        if (origin_file_ident == 0)
-            origin_file_ident = local_file_ident;
-        changeset.origin_file_ident = origin_file_ident;
+        parse_reciprocal_transform(in, is_compressed, *i->second); // Throws
+        init_reciprocal_transform(*i->second, local_file_ident, version, history_entry);
     }
     return *i->second;
 }
 
 
+void TransformerImpl::prefetch_reciprocal_transforms(TransformHistory& history, file_ident_type local_file_ident,
+                                                     version_type begin_version, version_type end_version)
+{
+    // Reading from the history must happen on this thread, but decompressing
+    // and parsing the changesets is independent work that can be spread over
+    // several threads when a large number of local changesets are involved.
+    struct Entry {
+        util::AppendBuffer<char> data;
+        bool is_compressed = false;
+        Changeset* changeset = nullptr;
+    };
+    std::vector<Entry> entries;
+    std::size_t total_size = 0;
+    for (;;) {
+        HistoryEntry history_entry;
+        version_type version = history.find_history_entry(begin_version, end_version, history_entry);
+        if (version == 0)
+            break; // No more local changesets
+        begin_version = version;
+
+        auto p = m_reciprocal_transform_cache.emplace(version, nullptr); // Throws
+        if (!p.second)
+            continue;
+        p.first->second = std::make_unique<Changeset>(); // Throws
+        Changeset& changeset = *p.first->second;
+        init_reciprocal_transform(changeset, local_file_ident, version, history_entry);
+
+        Entry& entry = entries.emplace_back(); // Throws
+        entry.changeset = &changeset;
+        history.get_reciprocal_transform(version, entry.is_compressed).copy_to(entry.data); // Throws
+        total_size += entry.data.size();
+    }
+
+    // Don't bother with threads that would get less than a few hundred kilobytes each
+    constexpr std::size_t min_bytes_per_thread = 256 * 1024;
+    std::size_t num_threads = std::min(util::hardware_thread_count(), total_size / min_bytes_per_thread);
+    util::parallel_for(entries.size(), num_threads, [&](std::size_t i) {
+        Entry& entry = entries[i];
+        util::SimpleNoCopyInputStream in{entry.data};
+        parse_reciprocal_transform(in, entry.is_compressed, *entry.changeset); // Throws
+        entry.data = util::AppendBuffer<char>();
+    }); // Throws
+}
+
+
+void TransformerImpl::parse_reciprocal_transform(util::NoCopyInputStream& in, bool is_compressed,
+                                                 Changeset& changeset)
+{
+    if (is_compressed) {
+        size_t total_size;
+        auto decompressed = util::compression::decompress_nonportable_input_stream(in, total_size);
+        REALM_ASSERT(decompressed);
+        sync::parse_changeset(*decompressed, changeset); // Throws
+    }
+    else {
+        sync::parse_changeset(in, changeset); // Throws
+    }
+}
+
+
+void TransformerImpl::init_reciprocal_transform(Changeset& changeset, file_ident_type local_file_ident,
+                                                version_type version, const HistoryEntry& history_entry) noexcept
+{
+    changeset.version = version;
+    changeset.last_integrated_remote_version = history_entry.remote_version;
+    changeset.origin_timestamp = history_entry.origin_timestamp;
+    file_ident_type origin_file_ident = history_entry.origin_file_ident;
+    if (origin_file_ident == 0)
+        origin_file_ident = local_file_ident;
+    changeset.origin_file_ident = origin_file_ident;
+}
+
+
 void TransformerImpl::flush_reciprocal_transform_cache(TransformHistory& history)
 {
     try {
@@ -104,7 +104,7 @@ public:
     /// entry, or zero if no history entry exists matching the specified and
     /// implied criteria.
     virtual version_type find_history_entry(version_type begin_version, version_type end_version,
-                                            HistoryEntry& entry) const noexcept = 0;
+                                            HistoryEntry& entry) const = 0;
 
     /// Get the specified reciprocal changeset. The targeted history entry is
     /// the one whose untransformed changeset produced the specified version.
@@ -215,6 +215,13 @@ private:
 
     Changeset& get_reciprocal_transform(TransformHistory&, file_ident_type local_file_ident, version_type version,
                                         const HistoryEntry&);
+    // Load all local changesets in the specified range into the reciprocal
+    // transform cache, parsing them in parallel if there are many of them.
+    void prefetch_reciprocal_transforms(TransformHistory&, file_ident_type local_file_ident,
+                                        version_type begin_version, version_type end_version);
+    static void parse_reciprocal_transform(util::NoCopyInputStream&, bool is_compressed, Changeset&);
+    static void init_reciprocal_transform(Changeset&, file_ident_type local_file_ident, version_type version,
+                                          const HistoryEntry&) noexcept;
     void flush_reciprocal_transform_cache(TransformHistory&);
 
     struct Discriminant;
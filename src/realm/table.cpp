@@ -27,6 +27,7 @@
 #include <realm/util/miscellaneous.hpp>
 #include <realm/util/serializer.hpp>
 #include <realm/impl/destroy_guard.hpp>
+#include <realm/aggregate_view.hpp>
 #include <realm/exceptions.hpp>
 #include <realm/table.hpp>
 #include <realm/alloc_slab.hpp>
@@ -707,63 +708,13 @@ void Table::populate_search_index(ColKey col_key)
     auto col_ndx = col_key.get_index().val;
     StringIndex* index = m_index_accessors[col_ndx].get();
 
-    // Insert ref to index
+    // Collect all values and build the index from them in one go
+    std::vector<std::pair<Mixed, ObjKey>> entries;
+    entries.reserve(size());
     for (auto o : *this) {
-        ObjKey key = o.get_key();
-        DataType type = get_column_type(col_key);
-
-        if (type == type_Int) {
-            if (is_nullable(col_key)) {
-                Optional<int64_t> value = o.get<Optional<int64_t>>(col_key);
-                index->insert(key, value); // Throws
-            }
-            else {
-                int64_t value = o.get<int64_t>(col_key);
-                index->insert(key, value); // Throws
-            }
-        }
-        else if (type == type_Bool) {
-            if (is_nullable(col_key)) {
-                Optional<bool> value = o.get<Optional<bool>>(col_key);
-                index->insert(key, value); // Throws
-            }
-            else {
-                bool value = o.get<bool>(col_key);
-                index->insert(key, value); // Throws
-            }
-        }
-        else if (type == type_String) {
-            StringData value = o.get<StringData>(col_key);
-            index->insert(key, value); // Throws
-        }
-        else if (type == type_Timestamp) {
-            Timestamp value = o.get<Timestamp>(col_key);
-            index->insert(key, value); // Throws
-        }
-        else if (type == type_ObjectId) {
-            if (is_nullable(col_key)) {
-                Optional<ObjectId> value = o.get<Optional<ObjectId>>(col_key);
-                index->insert(key, value); // Throws
-            }
-            else {
-                ObjectId value = o.get<ObjectId>(col_key);
-                index->insert(key, value); // Throws
-            }
-        }
-        else if (type == type_UUID) {
-            if (is_nullable(col_key)) {
-                Optional<UUID> value = o.get<Optional<UUID>>(col_key);
-                index->insert(key, value); // Throws
-            }
-            else {
-                UUID value = o.get<UUID>(col_key);
-                index->insert(key, value); // Throws
-            }
-        }
-        else {
-            REALM_ASSERT_RELEASE(false && "Data type does not support search index");
-        }
+        entries.emplace_back(o.get_any(col_key), o.get_key());
     }
+    index->insert_bulk(entries); // Throws
 }
 
 void Table::erase_from_search_indexes(ObjKey key)
@@ -778,6 +729,37 @@ void Table::erase_from_search_indexes(ObjKey key)
     }
 }
 
+namespace {
+
+// The value to put in the search index for an object created with `init_value`
+Mixed get_index_value(ColKey col_key, Mixed init_value)
+{
+    if (!init_value.is_null())
+        return init_value;
+
+    bool nullable = col_key.get_attrs().test(col_attr_Nullable);
+    switch (col_key.get_type()) {
+        case col_type_Int:
+            return ArrayIntNull::default_value(nullable);
+        case col_type_Bool:
+            return ArrayBoolNull::default_value(nullable);
+        case col_type_String:
+            return ArrayString::default_value(nullable);
+        case col_type_Timestamp:
+            return ArrayTimestamp::default_value(nullable);
+        case col_type_ObjectId:
+            return ArrayObjectIdNull::default_value(nullable);
+        case col_type_Mixed:
+            return init_value;
+        case col_type_UUID:
+            return ArrayUUIDNull::default_value(nullable);
+        default:
+            REALM_UNREACHABLE();
+    }
+}
+
+} // anonymous namespace
+
 void Table::update_indexes(ObjKey key, const FieldValues& values)
 {
     // Tombstones do not use index - will crash if we try to insert values
@@ -799,65 +781,33 @@ void Table::update_indexes(ObjKey key, const FieldValues& values)
 
         if (auto&& index = m_index_accessors[column_ndx]) {
             // There is an index for this column
+            index->insert(key, get_index_value(m_leaf_ndx2colkey[column_ndx], init_value));
+        }
+    }
+}
+
+void Table::update_indexes(const BulkValues& values)
+{
+    // Search indexes are updated one column at a time
+    auto sz = m_index_accessors.size();
+    // values.columns are sorted by column index - there may be columns missing
+    auto column = values.columns.begin();
+    for (size_t column_ndx = 0; column_ndx < sz; column_ndx++) {
+        const std::vector<Mixed>* init_values = nullptr;
+        if (column != values.columns.end() && column->first.get_index().val == column_ndx) {
+            init_values = column->second;
+            ++column;
+        }
+
+        if (auto&& index = m_index_accessors[column_ndx]) {
             auto col_key = m_leaf_ndx2colkey[column_ndx];
-            auto type = col_key.get_type();
-            auto attr = col_key.get_attrs();
-            bool nullable = attr.test(col_attr_Nullable);
-            switch (type) {
-                case col_type_Int:
-                    if (init_value.is_null()) {
-                        index->insert(key, ArrayIntNull::default_value(nullable));
-                    }
-                    else {
-                        index->insert(key, init_value.get<int64_t>());
-                    }
-                    break;
-                case col_type_Bool:
-                    if (init_value.is_null()) {
-                        index->insert(key, ArrayBoolNull::default_value(nullable));
-                    }
-                    else {
-                        index->insert(key, init_value.get<bool>());
-                    }
-                    break;
-                case col_type_String:
-                    if (init_value.is_null()) {
-                        index->insert(key, ArrayString::default_value(nullable));
-                    }
-                    else {
-                        index->insert(key, init_value.get<String>());
-                    }
-                    break;
-                case col_type_Timestamp:
-                    if (init_value.is_null()) {
-                        index->insert(key, ArrayTimestamp::default_value(nullable));
-                    }
-                    else {
-                        index->insert(key, init_value.get<Timestamp>());
-                    }
-                    break;
-                case col_type_ObjectId:
-                    if (init_value.is_null()) {
-                        index->insert(key, ArrayObjectIdNull::default_value(nullable));
-                    }
-                    else {
-                        index->insert(key, init_value.get<ObjectId>());
-                    }
-                    break;
-                case col_type_Mixed:
-                    index->insert(key, init_value);
-                    break;
-                case col_type_UUID:
-                    if (init_value.is_null()) {
-                        index->insert(key, ArrayUUIDNull::default_value(nullable));
-                    }
-                    else {
-                        index->insert(key, init_value.get<UUID>());
-                    }
-                    break;
-                default:
-                    REALM_UNREACHABLE();
+            std::vector<std::pair<Mixed, ObjKey>> entries;
+            entries.reserve(values.keys.size());
+            for (size_t i = 0; i < values.keys.size(); ++i) {
+                Mixed init_value = (init_values ? (*init_values)[i] : Mixed{});
+                entries.emplace_back(get_index_value(col_key, init_value), values.keys[i]);
             }
+            index->insert_bulk(entries); // Throws
         }
     }
 }
@@ -871,7 +821,194 @@ void Table::clear_indexes()
     }
 }
 
-void Table::do_add_search_index(ColKey col_key)
+size_t Table::add_aggregate_view(ColKey group_col, Action action, ColKey value_col)
+{
+    check_column(group_col);
+    ColumnType group_type = group_col.get_type();
+    if (group_col.is_collection() || is_link_type(group_type) || group_type == col_type_BackLink ||
+        group_type == col_type_TypedLink || group_type == col_type_Mixed)
+        throw LogicError(LogicError::illegal_type);
+    check_file_format_version(23);
+
+    switch (action) {
+        case act_Count:
+            value_col = ColKey();
+            break;
+        case act_Sum:
+        case act_Average:
+        case act_Min:
+        case act_Max: {
+            check_column(value_col);
+            ColumnType value_type = value_col.get_type();
+            bool numeric = value_type == col_type_Int || value_type == col_type_Float ||
+                           value_type == col_type_Double || value_type == col_type_Decimal;
+            bool ordered = value_type == col_type_Timestamp && (action == act_Min || action == act_Max);
+            if (value_col.is_collection() || !(numeric || ordered))
+                throw LogicError(LogicError::illegal_type);
+            break;
+        }
+        default:
+            throw LogicError(LogicError::illegal_combination);
+    }
+
+    while (m_top.size() <= top_position_for_aggregate_views)
+        m_top.add(0);
+    Array views(m_alloc);
+    views.set_parent(&m_top, top_position_for_aggregate_views);
+    if (m_top.get_as_ref(top_position_for_aggregate_views)) {
+        views.init_from_parent();
+        for (size_t i = 0; i < views.size(); ++i) {
+            AggregateView view(*this, views, i);
+            if (view.get_group_column() == group_col && view.get_action() == action &&
+                view.get_value_column() == value_col)
+                return i;
+        }
+    }
+    else {
+        views.create(Array::type_HasRefs); // Throws
+        views.update_parent();
+    }
+
+    ref_type ref = AggregateView::create(m_alloc, group_col, action, value_col); // Throws
+    _impl::DeepArrayRefDestroyGuard dg(ref, m_alloc);
+    views.add(from_ref(ref)); // Throws
+    dg.release();
+
+    size_t view_ndx = views.size() - 1;
+    AggregateView view(*this, views, view_ndx);
+    for (auto o : *this) {
+        view.insert(o.get_any(group_col), value_col ? o.get_any(value_col) : Mixed());
+    }
+    return view_ndx;
+}
+
+void Table::remove_aggregate_view(size_t view_ndx)
+{
+    if (view_ndx >= get_aggregate_view_count())
+        throw std::out_of_range("Index out of range");
+
+    Array views(m_alloc);
+    views.set_parent(&m_top, top_position_for_aggregate_views);
+    views.init_from_parent();
+    Array::destroy_deep(views.get_as_ref(view_ndx), m_alloc);
+    views.erase(view_ndx);
+    if (views.is_empty()) {
+        views.destroy();
+        m_top.set(top_position_for_aggregate_views, 0);
+    }
+}
+
+size_t Table::get_aggregate_view_count() const noexcept
+{
+    if (!has_aggregate_views())
+        return 0;
+    Array views(m_alloc);
+    views.init_from_ref(m_top.get_as_ref(top_position_for_aggregate_views));
+    return views.size();
+}
+
+std::vector<std::pair<Mixed, Mixed>> Table::get_aggregate_view(size_t view_ndx) const
+{
+    if (view_ndx >= get_aggregate_view_count())
+        throw std::out_of_range("Index out of range");
+
+    Array views(m_alloc);
+    views.init_from_ref(m_top.get_as_ref(top_position_for_aggregate_views));
+    return AggregateView(*this, views, view_ndx).get_result();
+}
+
+void Table::update_aggregate_views(const Obj& obj, ColKey col_key, Mixed new_value)
+{
+    if (obj.get_key().is_unresolved())
+        return;
+
+    Array views(m_alloc);
+    views.set_parent(&m_top, top_position_for_aggregate_views);
+    views.init_from_parent();
+    for (size_t i = 0; i < views.size(); ++i) {
+        AggregateView view(*this, views, i);
+        if (!view.depends_on(col_key))
+            continue;
+        ColKey group_col = view.get_group_column();
+        ColKey value_col = view.get_value_column();
+        Mixed old_group = obj.get_any(group_col);
+        Mixed old_value = value_col ? obj.get_any(value_col) : Mixed();
+        Mixed group = (group_col == col_key) ? new_value : old_group;
+        Mixed value = (value_col == col_key) ? new_value : old_value;
+        if (group == old_group && value == old_value)
+            continue;
+        view.erase(obj.get_key(), old_group, old_value);
+        view.insert(group, value);
+    }
+}
+
+void Table::insert_into_aggregate_views(ObjKey key)
+{
+    // Tombstones are not part of any group
+    if (key.is_unresolved() || !has_aggregate_views())
+        return;
+
+    Obj obj = m_clusters.get(key);
+    Array views(m_alloc);
+    views.set_parent(&m_top, top_position_for_aggregate_views);
+    views.init_from_parent();
+    for (size_t i = 0; i < views.size(); ++i) {
+        AggregateView view(*this, views, i);
+        ColKey value_col = view.get_value_column();
+        view.insert(obj.get_any(view.get_group_column()), value_col ? obj.get_any(value_col) : Mixed());
+    }
+}
+
+void Table::erase_from_aggregate_views(ObjKey key)
+{
+    if (key.is_unresolved() || !has_aggregate_views())
+        return;
+
+    Obj obj = m_clusters.get(key);
+    Array views(m_alloc);
+    views.set_parent(&m_top, top_position_for_aggregate_views);
+    views.init_from_parent();
+    for (size_t i = 0; i < views.size(); ++i) {
+        AggregateView view(*this, views, i);
+        ColKey value_col = view.get_value_column();
+        view.erase(key, obj.get_any(view.get_group_column()), value_col ? obj.get_any(value_col) : Mixed());
+    }
+}
+
+void Table::clear_aggregate_views()
+{
+    if (!has_aggregate_views())
+        return;
+
+    Array views(m_alloc);
+    views.set_parent(&m_top, top_position_for_aggregate_views);
+    views.init_from_parent();
+    for (size_t i = 0; i < views.size(); ++i) {
+        AggregateView(*this, views, i).clear();
+    }
+}
+
+void Table::remove_aggregate_views(ColKey col_key)
+{
+    if (!has_aggregate_views())
+        return;
+
+    Array views(m_alloc);
+    views.set_parent(&m_top, top_position_for_aggregate_views);
+    views.init_from_parent();
+    for (size_t i = views.size(); i > 0; --i) {
+        if (AggregateView(*this, views, i - 1).depends_on(col_key)) {
+            Array::destroy_deep(views.get_as_ref(i - 1), m_alloc);
+            views.erase(i - 1);
+        }
+    }
+    if (views.is_empty()) {
+        views.destroy();
+        m_top.set(top_position_for_aggregate_views, 0);
+    }
+}
+
+void Table::do_add_search_index(ColKey col_key, IndexType type)
 {
     size_t column_ndx = col_key.get_index().val;
 
@@ -884,6 +1021,8 @@ void Table::do_add_search_index(ColKey col_key)
         // it should probably be a type mismatch exception instead.
         throw LogicError(LogicError::illegal_combination);
     }
+    if (type != IndexType::General && col_key.get_type() != col_type_String)
+        throw LogicError(LogicError::illegal_combination);
 
     // m_index_accessors always has the same number of pointers as the number of columns. Columns without search
     // index have 0-entries.
@@ -892,7 +1031,7 @@ void Table::do_add_search_index(ColKey col_key)
 
     // Create the index
     m_index_accessors[column_ndx] =
-        std::make_unique<StringIndex>(ClusterColumn(&m_clusters, col_key), get_alloc()); // Throws
+        std::make_unique<StringIndex>(ClusterColumn(&m_clusters, col_key, type), get_alloc()); // Throws
     StringIndex* index = m_index_accessors[column_ndx].get();
 
     // Insert ref to index
@@ -913,6 +1052,8 @@ void Table::add_search_index(ColKey col_key)
         REALM_ASSERT(has_search_index(col_key));
         return;
     }
+    if (attr.test(col_attr_FullText_Indexed) || attr.test(col_attr_Trigram_Indexed))
+        throw LogicError(LogicError::illegal_combination);
 
     do_add_search_index(col_key);
 
@@ -924,12 +1065,84 @@ void Table::add_search_index(ColKey col_key)
 void Table::remove_search_index(ColKey col_key)
 {
     check_column(col_key);
-    auto column_ndx = col_key.get_index();
 
     // Early-out if non-indexed
-    if (m_index_accessors[column_ndx.val] == nullptr)
+    if (!has_search_index(col_key))
         return;
 
+    do_remove_search_index(col_key, col_attr_Indexed);
+}
+
+void Table::add_fulltext_index(ColKey col_key)
+{
+    add_tokenized_index(col_key, IndexType::Fulltext, col_attr_FullText_Indexed);
+}
+
+void Table::remove_fulltext_index(ColKey col_key)
+{
+    check_column(col_key);
+
+    // Early-out if not full-text indexed
+    if (!has_fulltext_index(col_key))
+        return;
+
+    do_remove_search_index(col_key, col_attr_FullText_Indexed);
+}
+
+void Table::add_trigram_index(ColKey col_key)
+{
+    add_tokenized_index(col_key, IndexType::Trigram, col_attr_Trigram_Indexed);
+}
+
+void Table::remove_trigram_index(ColKey col_key)
+{
+    check_column(col_key);
+
+    // Early-out if not trigram indexed
+    if (!has_trigram_index(col_key))
+        return;
+
+    do_remove_search_index(col_key, col_attr_Trigram_Indexed);
+}
+
+// A group opened directly from a file keeps its file format, as it is not
+// upgraded. Features that an older library version would misread must not be
+// added to it, since it is still labelled with the old format when written.
+void Table::check_file_format_version(int required_version) const
+{
+    if (Group* group = get_parent_group()) {
+        if (_impl::GroupFriend::get_file_format_version(*group) < required_version)
+            throw LogicError(LogicError::file_format_too_old);
+    }
+}
+
+void Table::add_tokenized_index(ColKey col_key, IndexType type, ColumnAttr index_attr)
+{
+    check_column(col_key);
+    check_file_format_version(23);
+
+    // Check spec
+    auto spec_ndx = leaf_ndx2spec_ndx(col_key.get_index());
+    auto attr = m_spec.get_column_attr(spec_ndx);
+    if (attr.test(index_attr)) {
+        REALM_ASSERT(get_index_type(col_key) == type);
+        return;
+    }
+    // A column can only have one index
+    if (attr.test(col_attr_Indexed) || attr.test(col_attr_FullText_Indexed) || attr.test(col_attr_Trigram_Indexed))
+        throw LogicError(LogicError::illegal_combination);
+
+    do_add_search_index(col_key, type);
+
+    // Update spec
+    attr.set(index_attr);
+    m_spec.set_column_attr(spec_ndx, attr); // Throws
+}
+
+void Table::do_remove_search_index(ColKey col_key, ColumnAttr index_attr)
+{
+    auto column_ndx = col_key.get_index();
+
     // Destroy and remove the index column
     auto& index = m_index_accessors[column_ndx.val];
     REALM_ASSERT(index != nullptr);
@@ -941,7 +1154,7 @@ void Table::remove_search_index(ColKey col_key)
     // update spec
     auto spec_ndx = leaf_ndx2spec_ndx(column_ndx);
     auto attr = m_spec.get_column_attr(spec_ndx);
-    attr.reset(col_attr_Indexed);
+    attr.reset(index_attr);
     m_spec.set_column_attr(spec_ndx, attr); // Throws
 }
 
@@ -1048,6 +1261,7 @@ void Table::do_erase_root_column(ColKey col_key)
     m_opposite_table.set(col_ndx, TableKey().value);
     m_opposite_column.set(col_ndx, ColKey().value);
     m_index_accessors[col_ndx] = nullptr;
+    remove_aggregate_views(col_key);
     m_clusters.remove_column(col_key);
     if (m_tombstones)
         m_tombstones->remove_column(col_key);
@@ -1180,7 +1394,20 @@ Table::~Table() noexcept
 
 bool Table::has_search_index(ColKey col_key) const noexcept
 {
-    return m_index_accessors[col_key.get_index().val] != nullptr;
+    auto& index = m_index_accessors[col_key.get_index().val];
+    return index && index->get_index_type() == IndexType::General;
+}
+
+bool Table::has_fulltext_index(ColKey col_key) const noexcept
+{
+    auto& index = m_index_accessors[col_key.get_index().val];
+    return index && index->is_fulltext_index();
+}
+
+bool Table::has_trigram_index(ColKey col_key) const noexcept
+{
+    auto& index = m_index_accessors[col_key.get_index().val];
+    return index && index->is_trigram_index();
 }
 
 void Table::migrate_column_info()
@@ -1972,6 +2199,7 @@ ref_type Table::create_empty_table(Allocator& alloc, TableKey key)
     top.add(0); // pk col key
     top.add(0); // flags
     top.add(0); // tombstones
+    top.add(0); // aggregate views
 
     REALM_ASSERT(top.size() == top_array_size);
 
@@ -2859,6 +3087,16 @@ void Table::refresh_accessor_tree()
     refresh_index_accessors();
 }
 
+IndexType Table::get_index_type(ColKey col_key) const
+{
+    auto attr = m_spec.get_column_attr(leaf_ndx2spec_ndx(col_key.get_index()));
+    if (attr.test(col_attr_FullText_Indexed))
+        return IndexType::Fulltext;
+    if (attr.test(col_attr_Trigram_Indexed))
+        return IndexType::Trigram;
+    return IndexType::General;
+}
+
 void Table::refresh_index_accessors()
 {
     // Refresh search index accessors
@@ -2880,12 +3118,12 @@ void Table::refresh_index_accessors()
         }
         else if (has_old_accessor && ref != 0) { // still there, refresh:
             auto col_key = m_leaf_ndx2colkey[col_ndx];
-            ClusterColumn virtual_col(&m_clusters, col_key);
+            ClusterColumn virtual_col(&m_clusters, col_key, get_index_type(col_key));
             m_index_accessors[col_ndx]->refresh_accessor_tree(virtual_col);
         }
         else if (!has_old_accessor && ref != 0) { // new index!
             auto col_key = m_leaf_ndx2colkey[col_ndx];
-            ClusterColumn virtual_col(&m_clusters, col_key);
+            ClusterColumn virtual_col(&m_clusters, col_key, get_index_type(col_key));
             m_index_accessors[col_ndx] =
                 std::make_unique<StringIndex>(ref, &m_index_refs, col_ndx, virtual_col, get_alloc());
         }
@@ -3391,6 +3629,232 @@ void Table::create_objects(const std::vector<ObjKey>& keys)
     }
 }
 
+std::vector<ObjKey> Table::bulk_insert(const std::vector<ColKey>& cols,
+                                       const std::vector<std::vector<Mixed>>& values)
+{
+    if (is_embedded())
+        throw LogicError(LogicError::wrong_kind_of_table);
+    if (cols.size() != values.size())
+        throw LogicError(LogicError::illegal_combination);
+    size_t num_rows = values.empty() ? 0 : values[0].size();
+    auto pk_col = get_primary_key_column();
+    const std::vector<Mixed>* pk_values = nullptr;
+    Group* group = get_parent_group();
+
+    // Validate everything up front so that nothing is created if a value is rejected
+    for (size_t c = 0; c < cols.size(); ++c) {
+        ColKey col_key = cols[c];
+        check_column(col_key);
+        if (values[c].size() != num_rows)
+            throw LogicError(LogicError::illegal_combination);
+        if (col_key.is_collection() || col_key.get_type() == col_type_BackLink)
+            throw LogicError(LogicError::illegal_type);
+        for (size_t d = 0; d < c; ++d) {
+            if (cols[d] == col_key)
+                throw LogicError(LogicError::illegal_combination);
+        }
+        if (col_key == pk_col)
+            pk_values = &values[c];
+        bool is_mixed = (col_key.get_type() == col_type_Mixed);
+        bool nullable = col_key.is_nullable();
+        for (auto& value : values[c]) {
+            if (value.is_null()) {
+                if (!nullable && !is_mixed)
+                    throw LogicError(LogicError::column_not_nullable);
+                continue;
+            }
+            if (!is_mixed && value.get_type() != DataType(col_key.get_type()))
+                throw LogicError(LogicError::type_mismatch);
+            if (value.get_type() == type_Link) {
+                TableRef target_table = get_opposite_table(col_key);
+                auto target_key = value.get<ObjKey>();
+                ClusterTree* ct =
+                    target_key.is_unresolved() ? target_table->m_tombstones.get() : &target_table->m_clusters;
+                if (!ct || !ct->is_valid(target_key))
+                    throw LogicError(LogicError::target_row_index_out_of_range);
+                if (target_table->is_embedded())
+                    throw LogicError(LogicError::wrong_kind_of_table);
+            }
+            else if (value.is_type(type_TypedLink)) {
+                REALM_ASSERT(group);
+                group->validate(value.get<ObjLink>());
+            }
+        }
+    }
+
+    if (pk_col) {
+        if (!pk_values)
+            throw LogicError(LogicError::wrong_kind_of_table);
+        auto& index = m_index_accessors[pk_col.get_index().val];
+        std::vector<Mixed> sorted_pks(pk_values->begin(), pk_values->end());
+        std::sort(sorted_pks.begin(), sorted_pks.end());
+        for (size_t i = 0; i < num_rows; ++i) {
+            bool duplicate = (i > 0 && sorted_pks[i - 1] == sorted_pks[i]);
+            if (duplicate || index->find_first(sorted_pks[i])) {
+                throw std::logic_error(
+                    util::format("Attempting to create an object in '%1' with an existing primary key value '%2'.",
+                                 get_name(), sorted_pks[i]));
+            }
+        }
+    }
+
+    std::vector<ObjKey> keys;
+    keys.reserve(num_rows);
+
+    // Objects that may resurrect a tombstone, and objects in asymmetric tables,
+    // need the special handling done when creating them one by one.
+    if (is_asymmetric() || nb_unresolved() > 0) {
+        for (size_t i = 0; i < num_rows; ++i) {
+            FieldValues field_values;
+            for (size_t c = 0; c < cols.size(); ++c) {
+                if (cols[c] != pk_col)
+                    field_values.insert(cols[c], values[c][i]);
+            }
+            Obj obj = pk_col ? create_object_with_primary_key((*pk_values)[i], std::move(field_values))
+                             : create_object(ObjKey(), field_values);
+            keys.push_back(obj.get_key());
+        }
+        return keys;
+    }
+
+    std::vector<GlobalKey> object_ids;
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (pk_col) {
+            keys.push_back(get_next_valid_key());
+        }
+        else {
+            GlobalKey object_id = allocate_object_id_squeezed();
+            ObjKey key = object_id.get_local_key(get_sync_file_id());
+            // See create_object()
+            while (m_clusters.is_valid(key)) {
+                object_id = allocate_object_id_squeezed();
+                key = object_id.get_local_key(get_sync_file_id());
+            }
+            object_ids.push_back(object_id);
+            keys.push_back(key);
+        }
+    }
+
+    BulkValues bulk;
+    bulk.keys = keys;
+    for (size_t c = 0; c < cols.size(); ++c)
+        bulk.columns.emplace_back(cols[c], &values[c]);
+    std::sort(bulk.columns.begin(), bulk.columns.end(), [](auto& a, auto& b) {
+        return a.first.get_index().val < b.first.get_index().val;
+    });
+
+    m_clusters.insert_rows(bulk);
+    update_indexes(bulk);
+    if (has_aggregate_views()) {
+        for (auto key : keys)
+            insert_into_aggregate_views(key);
+    }
+
+    // Replicated exactly as if the objects had been created one by one
+    if (auto repl = get_repl()) {
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (pk_col)
+                repl->create_object_with_primary_key(this, keys[i], (*pk_values)[i]); // Throws
+            else
+                repl->create_object(this, object_ids[i]); // Throws
+            for (size_t c = 0; c < cols.size(); ++c) {
+                if (cols[c] != pk_col)
+                    repl->set(this, cols[c], keys[i], values[c][i]); // Throws
+            }
+        }
+    }
+
+    return keys;
+}
+
+std::unique_ptr<ArrayPayload> Table::make_leaf_accessor(ColKey col_key) const
+{
+    Allocator& alloc = m_alloc;
+    switch (col_key.get_type()) {
+        case col_type_Int:
+            if (col_key.is_nullable()) {
+                return std::make_unique<ArrayIntNull>(alloc);
+            }
+            return std::make_unique<ArrayInteger>(alloc);
+        case col_type_Bool:
+            return std::make_unique<ArrayBoolNull>(alloc);
+        case col_type_Float:
+            return std::make_unique<ArrayFloatNull>(alloc);
+        case col_type_Double:
+            return std::make_unique<ArrayDoubleNull>(alloc);
+        case col_type_String:
+            return std::make_unique<ArrayString>(alloc);
+        case col_type_Binary:
+            return std::make_unique<ArrayBinary>(alloc);
+        case col_type_Mixed:
+            return std::make_unique<ArrayMixed>(alloc);
+        case col_type_Timestamp:
+            return std::make_unique<ArrayTimestamp>(alloc);
+        case col_type_Decimal:
+            return std::make_unique<ArrayDecimal128>(alloc);
+        case col_type_ObjectId:
+            return std::make_unique<ArrayObjectIdNull>(alloc);
+        case col_type_UUID:
+            return std::make_unique<ArrayUUIDNull>(alloc);
+        case col_type_Link:
+            return std::make_unique<ArrayKey>(alloc);
+        default:
+            break;
+    }
+    throw LogicError(LogicError::illegal_type);
+}
+
+void Table::read_columns(const std::vector<ObjKey>& keys, const std::vector<ColKey>& cols,
+                         std::vector<std::vector<Mixed>>& values) const
+{
+    size_t num_cols = cols.size();
+    std::vector<std::unique_ptr<ArrayPayload>> leaves;
+    leaves.reserve(num_cols);
+    for (auto col_key : cols) {
+        check_column(col_key);
+        if (col_key.is_collection())
+            throw LogicError(LogicError::illegal_type);
+        leaves.push_back(make_leaf_accessor(col_key)); // Throws
+    }
+
+    values.resize(num_cols);
+    for (auto& column : values) {
+        column.clear();
+        column.reserve(keys.size());
+    }
+
+    // The leaf accessors are only reinitialized when an object is not in the
+    // same cluster as the previous one, so reading the objects of a query
+    // result, which are mostly in key order, touches each cluster once.
+    Cluster cluster(0, m_alloc, m_clusters);
+    int64_t key_offset = 0;
+    for (auto key : keys) {
+        if (!key) {
+            for (auto& column : values)
+                column.emplace_back();
+            continue;
+        }
+        size_t ndx = realm::npos;
+        if (cluster.is_attached())
+            ndx = cluster.get_ndx(ObjKey(key.value - key_offset), 0);
+        if (ndx == realm::npos) {
+            ClusterNode::State state = m_clusters.ClusterTree::get(key); // Throws
+            cluster.init(state.mem);
+            ndx = state.index;
+            key_offset = key.value - cluster.get_key_value(ndx);
+            for (size_t c = 0; c < num_cols; ++c)
+                cluster.init_leaf(cols[c], leaves[c].get());
+        }
+        for (size_t c = 0; c < num_cols; ++c) {
+            Mixed value = leaves[c]->get_any(ndx);
+            // Links to unresolved objects read as null, as with Obj::get_any()
+            if (value.is_type(type_Link) && value.get<ObjKey>().is_unresolved())
+                value = Mixed{ObjKey{}};
+            values[c].push_back(value);
+        }
+    }
+}
+
 void Table::dump_objects()
 {
     m_clusters.dump_objects();
@@ -3906,6 +4370,8 @@ ColKey Table::set_nullability(ColKey col_key, bool nullable, bool throw_on_null)
     check_column(col_key);
 
     bool si = has_search_index(col_key);
+    bool fti = has_fulltext_index(col_key);
+    bool tgi = has_trigram_index(col_key);
     std::string column_name(get_column_name(col_key));
     auto type = col_key.get_type();
     auto attr = col_key.get_attrs();
@@ -3941,6 +4407,10 @@ ColKey Table::set_nullability(ColKey col_key, bool nullable, bool throw_on_null)
 
     if (si)
         do_add_search_index(new_col);
+    if (fti)
+        add_fulltext_index(new_col);
+    if (tgi)
+        add_trigram_index(new_col);
 
     return new_col;
 }
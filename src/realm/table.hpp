@@ -76,6 +76,7 @@ namespace query_parser {
 class Arguments;
 class KeyPathMapping;
 class ParserDriver;
+class PreparedQuery;
 } // namespace query_parser
 
 enum class ExpressionComparisonType : unsigned char {
@@ -202,12 +203,63 @@ public:
     void add_search_index(ColKey col_key);
     void remove_search_index(ColKey col_key);
 
+    /// has_fulltext_index() returns true if, and only if a full-text index has
+    /// been added to the specified column.
+    ///
+    /// add_fulltext_index() adds a full-text index to the specified string
+    /// column, which makes it searchable with Query::fulltext(). A column
+    /// cannot have both a search index and a full-text index. Like
+    /// add_search_index() and remove_search_index(), add_fulltext_index() and
+    /// remove_fulltext_index() are idempotent.
+
+    bool has_fulltext_index(ColKey col_key) const noexcept;
+    void add_fulltext_index(ColKey col_key);
+    void remove_fulltext_index(ColKey col_key);
+
+    /// has_trigram_index() returns true if, and only if a trigram index has
+    /// been added to the specified column.
+    ///
+    /// add_trigram_index() adds a trigram index to the specified string
+    /// column. Query::contains() and Query::like(), case sensitive or not,
+    /// then only check the objects containing every trigram of the search
+    /// string. A column can have only one kind of index. add_trigram_index()
+    /// and remove_trigram_index() are idempotent.
+
+    bool has_trigram_index(ColKey col_key) const noexcept;
+    void add_trigram_index(ColKey col_key);
+    void remove_trigram_index(ColKey col_key);
+
     void enumerate_string_column(ColKey col_key);
     bool is_enumerated(ColKey col_key) const noexcept;
     bool contains_unique_values(ColKey col_key) const;
 
     //@}
 
+    //@{
+
+    /// add_aggregate_view() adds a materialized aggregate to the table. The
+    /// view groups the objects by the value of `group_col` and keeps
+    /// `action` of `value_col` for each group. `action` is one of act_Count,
+    /// act_Sum, act_Average, act_Min and act_Max, and `value_col` is ignored
+    /// for act_Count. The view is updated as objects are created, modified and
+    /// removed in write transactions, and it is stored in the file, so reading
+    /// it only visits the groups. A view is removed along with the columns it
+    /// uses. If an identical view exists, its index is returned.
+    ///
+    /// get_aggregate_view() returns the groups of a view in ascending order,
+    /// each with its aggregate: the number of objects for act_Count, the sum
+    /// for act_Sum, and null for an average, minimum or maximum of a group
+    /// with only null values.
+    ///
+    /// Views are not replicated.
+
+    size_t add_aggregate_view(ColKey group_col, Action action, ColKey value_col = {});
+    void remove_aggregate_view(size_t view_ndx);
+    size_t get_aggregate_view_count() const noexcept;
+    std::vector<std::pair<Mixed, Mixed>> get_aggregate_view(size_t view_ndx) const;
+
+    //@}
+
     /// If the specified column is optimized to store only unique values, then
     /// this function returns the number of unique values currently
     /// stored. Otherwise it returns zero. This function is mainly intended for
@@ -277,6 +329,30 @@ public:
     void create_objects(size_t number, std::vector<ObjKey>& keys);
     /// Create a number of objects with keys supplied
     void create_objects(const std::vector<ObjKey>& keys);
+    /// Create a number of objects with initial values given column by column:
+    /// `values[i]` holds the values of `cols[i]` for each of the new objects,
+    /// so all of them must have the same size. Columns not mentioned get their
+    /// default value. In a table with a primary key, the primary key column
+    /// must be one of `cols`, and no primary key value may already be in use,
+    /// or occur more than once. Returns the keys of the new objects.
+    ///
+    /// The result is the same as that of creating the objects one by one, but
+    /// the cluster leaves are filled one column at a time, and search indexes
+    /// are updated one column at a time afterwards, which is much faster for
+    /// large numbers of objects.
+    std::vector<ObjKey> bulk_insert(const std::vector<ColKey>& cols, const std::vector<std::vector<Mixed>>& values);
+    /// Read the values of a number of columns for a number of objects, column
+    /// by column: on return `values[i][j]` holds the value of `cols[i]` for
+    /// `keys[j]`, as returned by `Obj::get_any()`. A null key gives null
+    /// values. Throws `KeyNotFound` if a key does not refer to an object in
+    /// the table. Collection and backlink columns cannot be read this way.
+    ///
+    /// This is much faster than reading the values through `Obj` accessors,
+    /// as the objects are located and the column leaves are initialized once
+    /// per cluster rather than once per value. Strings and binaries refer to
+    /// the Realm file and stay valid only until the transaction advances.
+    void read_columns(const std::vector<ObjKey>& keys, const std::vector<ColKey>& cols,
+                      std::vector<std::vector<Mixed>>& values) const;
     /// Does the key refer to an object within the table?
     bool is_valid(ObjKey key) const noexcept
     {
@@ -412,6 +488,22 @@ public:
             return nullptr;
         return m_index_accessors[col.get_index().val].get();
     }
+    // Will return pointer to full-text index accessor. Will return nullptr if no full-text index
+    StringIndex* get_fulltext_index(ColKey col) const noexcept
+    {
+        check_column(col);
+        if (!has_fulltext_index(col))
+            return nullptr;
+        return m_index_accessors[col.get_index().val].get();
+    }
+    // Will return pointer to trigram index accessor. Will return nullptr if no trigram index
+    StringIndex* get_trigram_index(ColKey col) const noexcept
+    {
+        check_column(col);
+        if (!has_trigram_index(col))
+            return nullptr;
+        return m_index_accessors[col.get_index().val].get();
+    }
     template <class T>
     ObjKey find_first(ColKey col_key, T value) const;
 
@@ -565,6 +657,20 @@ public:
                 const query_parser::KeyPathMapping& mapping) const;
     Query query(const std::string& query_string, query_parser::Arguments& arguments,
                 const query_parser::KeyPathMapping&) const;
+    // Queries with a query string that has already been parsed (see query_parser::prepare())
+    Query query(const query_parser::PreparedQuery& query, const std::vector<Mixed>& arguments = {}) const;
+    Query query(const query_parser::PreparedQuery& query, const std::vector<Mixed>& arguments,
+                const query_parser::KeyPathMapping& mapping) const;
+    Query query(const query_parser::PreparedQuery& query, query_parser::Arguments& arguments,
+                const query_parser::KeyPathMapping&) const;
+    // Run a query string ending with a 'GROUP BY(prop, @count)' or
+    // 'GROUP BY(prop, @sum(value))' clause (also @avg, @min and @max), see
+    // Query::group_by(). Returns the groups in ascending order with their aggregate.
+    std::vector<std::pair<Mixed, Mixed>> aggregate_groups(const std::string& query_string,
+                                                          const std::vector<Mixed>& arguments = {}) const;
+    std::vector<std::pair<Mixed, Mixed>> aggregate_groups(const std::string& query_string,
+                                                          const std::vector<Mixed>& arguments,
+                                                          const query_parser::KeyPathMapping& mapping) const;
 
     //@{
     /// WARNING: The link() and backlink() methods will alter a state on the Table object and return a reference
@@ -695,10 +801,31 @@ private:
     size_t do_set_link(ColKey col_key, size_t row_ndx, size_t target_row_ndx);
 
     void populate_search_index(ColKey col_key);
+    // The search index or full-text index of the column, if any
+    StringIndex* get_index_accessor(ColKey col_key) const noexcept
+    {
+        return m_index_accessors[col_key.get_index().val].get();
+    }
     void erase_from_search_indexes(ObjKey key);
     void update_indexes(ObjKey key, const FieldValues& values);
+    void update_indexes(const BulkValues& values);
     void clear_indexes();
 
+    bool has_aggregate_views() const noexcept
+    {
+        return m_top.size() > top_position_for_aggregate_views &&
+               m_top.get_as_ref(top_position_for_aggregate_views) != 0;
+    }
+    // Called before `col_key` of `obj` is set to `new_value`
+    void update_aggregate_views(const Obj& obj, ColKey col_key, Mixed new_value);
+    void insert_into_aggregate_views(ObjKey key);
+    void erase_from_aggregate_views(ObjKey key);
+    void clear_aggregate_views();
+    void remove_aggregate_views(ColKey col_key);
+
+    // An accessor for the cluster leaves of a column, see Cluster::init_leaf()
+    std::unique_ptr<ArrayPayload> make_leaf_accessor(ColKey col_key) const;
+
     // Migration support
     void migrate_column_info();
     bool verify_column_keys();
@@ -736,7 +863,10 @@ private:
     void erase_root_column(ColKey col_key);
     ColKey do_insert_root_column(ColKey col_key, ColumnType, StringData name, DataType key_type = DataType(0));
     void do_erase_root_column(ColKey col_key);
-    void do_add_search_index(ColKey col_key);
+    void do_add_search_index(ColKey col_key, IndexType type = IndexType::General);
+    void do_remove_search_index(ColKey col_key, ColumnAttr attr);
+    void add_tokenized_index(ColKey col_key, IndexType type, ColumnAttr attr);
+    void check_file_format_version(int required_version) const;
 
     bool has_any_embedded_objects();
     void set_opposite_column(ColKey col_key, TableKey opposite_table, ColKey opposite_column);
@@ -802,6 +932,7 @@ private:
     /// table.
     void refresh_accessor_tree();
     void refresh_index_accessors();
+    IndexType get_index_type(ColKey col_key) const;
     void refresh_content_version();
     void flush_for_commit();
 
@@ -833,7 +964,9 @@ private:
     static constexpr int top_position_for_flags = 12;
     // flags contents: bit 0-1 - table type
     static constexpr int top_position_for_tombstones = 13;
-    static constexpr int top_array_size = 14;
+    // Introduced in file format 23
+    static constexpr int top_position_for_aggregate_views = 14;
+    static constexpr int top_array_size = 15;
 
     enum { s_collision_map_lo = 0, s_collision_map_hi = 1, s_collision_map_local_id = 2, s_collision_map_num_slots };
 
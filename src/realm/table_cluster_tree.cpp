@@ -26,6 +26,12 @@
 #include "realm/array_typed_link.hpp"
 #include "realm/array_string.hpp"
 #include "realm/array_mixed.hpp"
+#include "realm/array_basic.hpp"
+#include "realm/array_bool.hpp"
+#include "realm/array_binary.hpp"
+#include "realm/array_timestamp.hpp"
+#include "realm/array_decimal128.hpp"
+#include "realm/array_fixed_bytes.hpp"
 #include "realm/group.hpp"
 
 namespace realm {
@@ -77,6 +83,7 @@ void TableClusterTree::clear(CascadeState& state)
         });
     }
 
+    m_owner->clear_aggregate_views();
     ClusterTree::clear();
 }
 
@@ -132,11 +139,13 @@ void TableClusterTree::cleanup_key(ObjKey k)
 {
     m_owner->free_local_id_after_hash_collision(k);
     m_owner->erase_from_search_indexes(k);
+    m_owner->erase_from_aggregate_views(k);
 }
 
 void TableClusterTree::update_indexes(ObjKey k, const FieldValues& init_values)
 {
     m_owner->update_indexes(k, init_values);
+    m_owner->insert_into_aggregate_views(k);
 }
 
 void TableClusterTree::for_each_and_every_column(ColIterateFunction func) const
@@ -327,4 +336,109 @@ TableClusterTree::Iterator::pointer TableClusterTree::Iterator::operator->() con
     return &m_obj;
 }
 
+template <class LeafType>
+const LeafType& TableClusterTree::Iterator::get_leaf(ColKey col_key) const
+{
+    update();
+
+    size_t col_ndx = col_key.get_index().val;
+    auto& leaves = m_leaf_cache.leaves;
+    if (col_ndx >= leaves.size())
+        leaves.resize(col_ndx + 1);
+    auto& cached = leaves[col_ndx];
+    if (cached.col_key != col_key || cached.leaf_type != &typeid(LeafType)) {
+        m_table->check_column(col_key);
+        cached.leaf = std::make_unique<LeafType>(m_tree.get_alloc());
+        cached.leaf_type = &typeid(LeafType);
+        cached.col_key = col_key;
+        cached.cluster_addr = nullptr;
+    }
+    // A cluster that is not read-only may be modified in place, and so may
+    // its leaves
+    const char* cluster_addr = m_leaf.get_mem().get_addr();
+    if (cached.cluster_addr != cluster_addr || cached.storage_version != m_storage_version) {
+        m_leaf.init_leaf(col_key, cached.leaf.get());
+        if (m_tree.get_alloc().is_read_only(m_leaf.get_ref())) {
+            cached.cluster_addr = cluster_addr;
+            cached.storage_version = m_storage_version;
+        }
+        else {
+            cached.cluster_addr = nullptr;
+        }
+    }
+    return static_cast<const LeafType&>(*cached.leaf);
+}
+
+template <class T>
+T TableClusterTree::Iterator::get(ColKey col_key) const
+{
+    REALM_ASSERT(col_key.get_type() == ColumnTypeTraits<T>::column_id);
+    return get_leaf<ColumnClusterLeafType<T>>(col_key).get(m_state.m_current_index);
+}
+
+template <>
+ObjKey TableClusterTree::Iterator::get<ObjKey>(ColKey col_key) const
+{
+    REALM_ASSERT(col_key.get_type() == col_type_Link);
+    ObjKey k = get_leaf<ArrayKey>(col_key).get(m_state.m_current_index);
+    return k.is_unresolved() ? ObjKey{} : k;
+}
+
+Mixed TableClusterTree::Iterator::get_any(ColKey col_key) const
+{
+    switch (col_key.get_type()) {
+        case col_type_Int:
+            if (col_key.get_attrs().test(col_attr_Nullable)) {
+                return Mixed{get<util::Optional<int64_t>>(col_key)};
+            }
+            else {
+                return Mixed{get<int64_t>(col_key)};
+            }
+        case col_type_Bool:
+            return Mixed{get<util::Optional<bool>>(col_key)};
+        case col_type_Float:
+            return Mixed{get<util::Optional<float>>(col_key)};
+        case col_type_Double:
+            return Mixed{get<util::Optional<double>>(col_key)};
+        case col_type_String:
+            return Mixed{get<String>(col_key)};
+        case col_type_Binary:
+            return Mixed{get<Binary>(col_key)};
+        case col_type_Mixed:
+            return get<Mixed>(col_key);
+        case col_type_Timestamp:
+            return Mixed{get<Timestamp>(col_key)};
+        case col_type_Decimal:
+            return Mixed{get<Decimal128>(col_key)};
+        case col_type_ObjectId:
+            return Mixed{get<util::Optional<ObjectId>>(col_key)};
+        case col_type_UUID:
+            return Mixed{get<util::Optional<UUID>>(col_key)};
+        case col_type_Link:
+            return Mixed{get<ObjKey>(col_key)};
+        default:
+            break;
+    }
+    m_table->check_column(col_key);
+    throw LogicError(LogicError::illegal_type);
+}
+
+template int64_t TableClusterTree::Iterator::get<int64_t>(ColKey col_key) const;
+template util::Optional<int64_t> TableClusterTree::Iterator::get<util::Optional<int64_t>>(ColKey col_key) const;
+template bool TableClusterTree::Iterator::get<bool>(ColKey col_key) const;
+template util::Optional<Bool> TableClusterTree::Iterator::get<util::Optional<Bool>>(ColKey col_key) const;
+template float TableClusterTree::Iterator::get<float>(ColKey col_key) const;
+template util::Optional<float> TableClusterTree::Iterator::get<util::Optional<float>>(ColKey col_key) const;
+template double TableClusterTree::Iterator::get<double>(ColKey col_key) const;
+template util::Optional<double> TableClusterTree::Iterator::get<util::Optional<double>>(ColKey col_key) const;
+template StringData TableClusterTree::Iterator::get<StringData>(ColKey col_key) const;
+template BinaryData TableClusterTree::Iterator::get<BinaryData>(ColKey col_key) const;
+template Timestamp TableClusterTree::Iterator::get<Timestamp>(ColKey col_key) const;
+template ObjectId TableClusterTree::Iterator::get<ObjectId>(ColKey col_key) const;
+template util::Optional<ObjectId> TableClusterTree::Iterator::get<util::Optional<ObjectId>>(ColKey col_key) const;
+template Decimal128 TableClusterTree::Iterator::get<Decimal128>(ColKey col_key) const;
+template Mixed TableClusterTree::Iterator::get<Mixed>(ColKey col_key) const;
+template UUID TableClusterTree::Iterator::get<UUID>(ColKey col_key) const;
+template util::Optional<UUID> TableClusterTree::Iterator::get<util::Optional<UUID>>(ColKey col_key) const;
+
 } // namespace realm
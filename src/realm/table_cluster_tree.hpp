@@ -22,6 +22,10 @@
 #include "realm/cluster_tree.hpp"
 #include "realm/obj.hpp"
 
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
 namespace realm {
 
 class TableClusterTree : public ClusterTree {
@@ -116,11 +120,50 @@ public:
         return Iterator(m_table, m_tree, get_position() + adj);
     }
 
+    // Read a value of the object pointed to by the iterator without going
+    // through an Obj accessor. The iterator keeps an accessor for the leaf of
+    // each column read this way, which is only reinitialized when the
+    // iterator moves to another cluster, so a scan of the whole table reading
+    // a few columns of each object does not have to look them up again for
+    // every value. The result is the same as that of `Obj::get<T>()`.
+    template <class T>
+    T get(ColKey col_key) const;
+    Mixed get_any(ColKey col_key) const;
+
 protected:
     mutable Obj m_obj;
     TableRef m_table;
+
+private:
+    // Leaf accessors are not shared between copies of an iterator, as they
+    // are bound to the cluster the iterator is in
+    struct CachedLeaf {
+        std::unique_ptr<ArrayPayload> leaf;
+        const std::type_info* leaf_type = nullptr;
+        ColKey col_key;
+        const char* cluster_addr = nullptr;
+        uint64_t storage_version = uint64_t(-1);
+    };
+    struct LeafCache {
+        std::vector<CachedLeaf> leaves;
+
+        LeafCache() = default;
+        LeafCache(const LeafCache&) {}
+        LeafCache& operator=(const LeafCache&)
+        {
+            leaves.clear();
+            return *this;
+        }
+    };
+    mutable LeafCache m_leaf_cache;
+
+    template <class LeafType>
+    const LeafType& get_leaf(ColKey col_key) const;
 };
 
+template <>
+ObjKey TableClusterTree::Iterator::get<ObjKey>(ColKey col_key) const;
+
 } // namespace realm
 
 #endif /* REALM_TABLE_CLUSTER_TREE_HPP */
@@ -425,6 +425,23 @@ void TableView::to_json(std::ostream& out, size_t link_depth, const std::map<std
     out << "]";
 }
 
+void TableView::read_columns(const std::vector<ColKey>& cols, std::vector<std::vector<Mixed>>& values) const
+{
+    // Objects can only have been deleted if the table has changed since the
+    // view was last synchronized
+    bool check_keys = !is_in_sync();
+    const size_t row_count = size();
+    std::vector<ObjKey> keys;
+    keys.reserve(row_count);
+    for (size_t r = 0; r < row_count; ++r) {
+        ObjKey key = get_key(r);
+        if (check_keys && key && !m_table->is_valid(key))
+            key = ObjKey();
+        keys.push_back(key);
+    }
+    m_table->read_columns(keys, cols, values);
+}
+
 bool TableView::depends_on_deleted_object() const
 {
     if (m_collection_source) {
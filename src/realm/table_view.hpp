@@ -304,6 +304,11 @@ public:
     void to_json(std::ostream&, size_t link_depth = 0, const std::map<std::string, std::string>& renames = {},
                  JSONOutputMode mode = output_mode_json) const;
 
+    /// Read the values of a number of columns for the objects in this view,
+    /// column by column, see `Table::read_columns()`. `values[i][j]` is the
+    /// value of `cols[i]` in row `j`, or null if that object has been deleted.
+    void read_columns(const std::vector<ColKey>& cols, std::vector<std::vector<Mixed>>& values) const;
+
     // Determine if the view is 'in sync' with the underlying table
     // as well as other views used to generate the view. Note that updates
     // through views maintains synchronization between view and table.
@@ -17,6 +17,7 @@
  **************************************************************************/
 
 #include <algorithm>
+#include <cstring>
 #include <vector>
 
 #ifdef _WIN32
@@ -66,6 +67,33 @@ std::wstring utf8_to_wstring(StringData str)
 #endif
 }
 
+// clang-format off
+// The folded form of the characters U+00C0 to U+017F (Latin-1 letters and Latin Extended-A): lower case and without
+// diacritics. The two non-letters in the range map to the empty string.
+const char* const latin_folding[] = {
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",  // U+00C0
+    "d", "n", "o", "o", "o", "o", "o", "", "o", "u", "u", "u", "u", "y", "th", "ss",  // U+00D0
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",  // U+00E0
+    "d", "n", "o", "o", "o", "o", "o", "", "o", "u", "u", "u", "u", "y", "th", "y",   // U+00F0
+    "a", "a", "a", "a", "a", "a", "c", "c", "c", "c", "c", "c", "c", "c", "d", "d",   // U+0100
+    "d", "d", "e", "e", "e", "e", "e", "e", "e", "e", "e", "e", "g", "g", "g", "g",   // U+0110
+    "g", "g", "g", "g", "h", "h", "h", "h", "i", "i", "i", "i", "i", "i", "i", "i",   // U+0120
+    "i", "i", "ij", "ij", "j", "j", "k", "k", "k", "l", "l", "l", "l", "l", "l", "l", // U+0130
+    "l", "l", "l", "n", "n", "n", "n", "n", "n", "n", "n", "n", "o", "o", "o", "o",   // U+0140
+    "o", "o", "oe", "oe", "r", "r", "r", "r", "r", "r", "s", "s", "s", "s", "s", "s", // U+0150
+    "s", "s", "t", "t", "t", "t", "t", "t", "u", "u", "u", "u", "u", "u", "u", "u",   // U+0160
+    "u", "u", "u", "u", "w", "w", "y", "y", "y", "z", "z", "z", "z", "z", "z", "s",   // U+0170
+};
+// clang-format on
+
+// Non-ASCII characters that separate words: the Latin-1 controls and punctuation, general punctuation, CJK
+// punctuation and the byte order mark.
+bool is_word_separator(uint32_t cp)
+{
+    return cp < 0xC0 || cp == 0xD7 || cp == 0xF7 || (cp >= 0x2000 && cp <= 0x206F) ||
+           (cp >= 0x3000 && cp <= 0x303F) || cp == 0xFEFF;
+}
+
 } // unnamed namespace
 
 
@@ -533,6 +561,92 @@ bool string_like_ins(StringData text, StringData pattern) noexcept
     return StringData::matchlike_ins(text, lower.c_str(), upper.c_str());
 }
 
+std::set<std::string> tokenize_text(StringData text)
+{
+    std::set<std::string> words;
+    std::string word;
+    bool truncated = false;
+
+    auto append = [&](const char* data, size_t size) {
+        if (word.size() + size > max_text_token_size)
+            truncated = true;
+        if (!truncated)
+            word.append(data, size);
+    };
+    auto end_word = [&] {
+        if (!word.empty())
+            words.insert(std::move(word));
+        word.clear();
+        truncated = false;
+    };
+
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        char c = *p;
+        if (static_cast<unsigned char>(c) < 0x80) {
+            if (c >= 'A' && c <= 'Z') {
+                c = char(c - 'A' + 'a');
+                append(&c, 1);
+            }
+            else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+                append(&c, 1);
+            }
+            else {
+                end_word();
+            }
+            ++p;
+            continue;
+        }
+
+        size_t len = sequence_length(c);
+        bool valid = len >= 2 && len <= 4 && size_t(end - p) >= len;
+        for (size_t i = 1; valid && i < len; ++i)
+            valid = (static_cast<unsigned char>(p[i]) & 0xC0) == 0x80;
+        if (!valid) {
+            // Invalid UTF-8 is treated as a separator
+            end_word();
+            ++p;
+            continue;
+        }
+        uint32_t cp = utf8value(p);
+        if (is_word_separator(cp)) {
+            end_word();
+        }
+        else if (cp >= 0xC0 && cp < 0x180) {
+            const char* folded = latin_folding[cp - 0xC0];
+            if (*folded)
+                append(folded, strlen(folded));
+            else
+                end_word();
+        }
+        else {
+            append(p, len);
+        }
+        p += len;
+    }
+    end_word();
+
+    return words;
+}
+
+std::set<std::string> tokenize_trigrams(StringData text)
+{
+    std::set<std::string> trigrams;
+    if (text.size() < trigram_size)
+        return trigrams;
+
+    std::string folded(text.data(), text.size());
+    for (char& c : folded) {
+        if (c >= 'A' && c <= 'Z')
+            c = char(c - 'A' + 'a');
+    }
+    for (size_t i = 0; i + trigram_size <= folded.size(); ++i)
+        trigrams.insert(folded.substr(i, trigram_size));
+
+    return trigrams;
+}
+
 } // namespace realm
 
 
@@ -21,6 +21,7 @@
 
 #include <locale>
 #include <cstdint>
+#include <set>
 #include <string>
 
 #include <realm/string_data.hpp>
@@ -158,6 +159,21 @@ bool contains_ins(StringData haystack, const char* needle_upper, const char* nee
 bool string_like_ins(StringData text, StringData pattern) noexcept;
 bool string_like_ins(StringData text, StringData upper, StringData lower) noexcept;
 
+/// Split \a text into the words used by the full-text index. A word is a
+/// maximal run of letters and digits. Words are lower cased and stripped of
+/// diacritics ("Ærø" becomes "aero"); this folding covers Latin-1 and Latin
+/// Extended-A, other characters are kept as they are. Words longer than
+/// `max_text_token_size` bytes are truncated. Each word is returned once.
+constexpr size_t max_text_token_size = 64;
+std::set<std::string> tokenize_text(StringData text);
+
+/// Split \a text into the trigrams used by the trigram index: every run of
+/// `trigram_size` consecutive bytes, with ASCII letters lower cased. Other
+/// bytes are kept as they are, so a trigram may hold part of a multibyte
+/// character. Each trigram is returned once.
+constexpr size_t trigram_size = 3;
+std::set<std::string> tokenize_trigrams(StringData text);
+
 } // namespace realm
 
 #endif // REALM_UNICODE_HPP
@@ -27,6 +27,7 @@ public:
     void async_read(char*, std::size_t, ReadCompletionHandler) override;
     void async_read_until(char*, std::size_t, char, ReadCompletionHandler) override;
     void async_write(const char*, std::size_t, WriteCompletionHandler) override;
+    void async_write_gather(const network::ConstBuffer*, std::size_t, WriteCompletionHandler) override;
 
 private:
     using milliseconds_type = std::int_fast64_t;
@@ -39,6 +40,10 @@ private:
     {
         return m_config.random;
     }
+    bool websocket_permessage_deflate_enabled() noexcept override
+    {
+        return m_config.permessage_deflate;
+    }
 
     void websocket_handshake_completion_handler(const util::HTTPHeaders& headers) override
     {
@@ -147,6 +152,19 @@ void EZSocketImpl::async_write(const char* data, std::size_t size, WriteCompleti
 }
 
 
+void EZSocketImpl::async_write_gather(const network::ConstBuffer* buffers, std::size_t num_buffers,
+                                      WriteCompletionHandler handler)
+{
+    REALM_ASSERT(m_socket);
+    if (m_ssl_stream) {
+        m_ssl_stream->async_write_gather(buffers, num_buffers, std::move(handler)); // Throws
+    }
+    else {
+        m_socket->async_write_gather(buffers, num_buffers, std::move(handler)); // Throws
+    }
+}
+
+
 void EZSocketImpl::initiate_resolve()
 {
     const std::string& address = m_endpoint.proxy ? m_endpoint.proxy->address : m_endpoint.address;
@@ -21,6 +21,7 @@ struct EZConfig {
     std::mt19937_64& random;
     util::network::Service& service;
     std::string user_agent;
+    bool permessage_deflate = false;
 };
 
 struct EZEndpoint {
@@ -12,6 +12,7 @@
 
 #ifndef _WIN32
 #include <netinet/tcp.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <poll.h>
 #include <realm/util/to_string.hpp>
@@ -2082,6 +2083,88 @@ std::size_t Service::Descriptor::write_some(const char* data, std::size_t size,
 }
 
 
+std::size_t Service::Descriptor::write_some_gather(const ConstBuffer* buffers, std::size_t num_buffers,
+                                                  std::error_code& ec) noexcept
+{
+    REALM_ASSERT(num_buffers > 0);
+    if (REALM_UNLIKELY(assume_write_would_block())) {
+        ec = error::resource_unavailable_try_again; // Failure
+        return 0;
+    }
+    constexpr std::size_t max_buffers = 16;
+    num_buffers = std::min(num_buffers, max_buffers);
+    std::size_t size = 0;
+#ifdef _WIN32
+    WSABUF bufs[max_buffers];
+    for (std::size_t i = 0; i < num_buffers; ++i) {
+        bufs[i].buf = const_cast<char*>(buffers[i].data);
+        bufs[i].len = ULONG(buffers[i].size);
+        size += buffers[i].size;
+    }
+#else
+    struct iovec iov[max_buffers];
+    for (std::size_t i = 0; i < num_buffers; ++i) {
+        iov[i].iov_base = const_cast<char*>(buffers[i].data);
+        iov[i].iov_len = buffers[i].size;
+        size += buffers[i].size;
+    }
+    struct msghdr msg = {};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = decltype(msg.msg_iovlen)(num_buffers);
+#endif
+    for (;;) {
+#ifdef _WIN32
+        DWORD num_bytes_sent = 0;
+        int ret = ::WSASend(m_fd, bufs, DWORD(num_buffers), &num_bytes_sent, 0, nullptr, nullptr);
+        if (ret == SOCKET_ERROR) {
+            int err = WSAGetLastError();
+            // Retry on interruption by system signal
+            if (err == WSAEINTR)
+                continue;
+            set_write_ready(err != WSAEWOULDBLOCK);
+            ec = make_winsock_error_code(err); // Failure
+            return 0;
+        }
+        std::size_t n = std::size_t(num_bytes_sent);
+#else
+        int flags = 0;
+#ifdef __linux__
+        // Prevent SIGPIPE when remote peer has closed the connection.
+        flags |= MSG_NOSIGNAL;
+#endif
+        ssize_t ret = ::sendmsg(m_fd, &msg, flags);
+        if (ret == -1) {
+            int err = errno;
+            // Retry on interruption by system signal
+            if (err == EINTR)
+                continue;
+#if REALM_PLATFORM_APPLE
+            // See write_some()
+            if (REALM_UNLIKELY(err == EPROTOTYPE))
+                err = EPIPE;
+#endif
+            if (err == EWOULDBLOCK)
+                err = EAGAIN;
+            set_write_ready(err != EAGAIN);
+            ec = make_basic_system_error_code(err); // Failure
+            return 0;
+        }
+        REALM_ASSERT(ret >= 0);
+        std::size_t n = std::size_t(ret);
+#endif
+        REALM_ASSERT(n <= size);
+#if REALM_NETWORK_USE_EPOLL
+        // See write_some()
+        set_write_ready(n == size);
+#else
+        set_write_ready(true);
+#endif
+        ec = std::error_code(); // Success
+        return n;
+    }
+}
+
+
 #if REALM_NETWORK_USE_EPOLL || REALM_HAVE_KQUEUE
 
 void Service::Descriptor::deregister_for_async() noexcept
@@ -149,6 +149,15 @@ class Stream;
 } // namespace ssl
 
 
+/// \brief A contiguous range of bytes to be written.
+///
+/// See Socket::async_write_gather().
+struct ConstBuffer {
+    const char* data;
+    std::size_t size;
+};
+
+
 /// \brief An IP protocol descriptor.
 class StreamProtocol {
 public:
@@ -482,6 +491,8 @@ public:
     void accept(Descriptor&, StreamProtocol, Endpoint*, std::error_code&) noexcept;
     std::size_t read_some(char* buffer, std::size_t size, std::error_code&) noexcept;
     std::size_t write_some(const char* data, std::size_t size, std::error_code&) noexcept;
+    std::size_t write_some_gather(const ConstBuffer* buffers, std::size_t num_buffers,
+                                  std::error_code&) noexcept;
 
     /// \tparam Oper An operation type inherited from IoOper with an initate()
     /// function that initiates the operation and figures out whether it needs
@@ -1101,6 +1112,20 @@ public:
     template <class H>
     void async_write(const char* data, std::size_t size, H&& handler);
 
+    /// \brief Perform an asynchronous gather write operation.
+    ///
+    /// Same as async_write(), except that the bytes to be written are taken,
+    /// in order, from each of the specified buffers. Where the platform
+    /// allows it, as much as possible of all the buffers is passed to the
+    /// kernel in a single system call, so that a message made up of several
+    /// separately allocated pieces can be written without first being copied
+    /// into one contiguous buffer.
+    ///
+    /// Both the array of buffers, and the memory that the buffers refer to,
+    /// must remain valid until the completion handler starts to execute.
+    template <class H>
+    void async_write_gather(const ConstBuffer* buffers, std::size_t num_buffers, H&& handler);
+
     template <class H>
     void async_read_some(char* buffer, std::size_t size, H&& handler);
     template <class H>
@@ -1178,6 +1203,8 @@ private:
     std::size_t do_write_some_sync(const char* data, std::size_t size, std::error_code&) noexcept;
     std::size_t do_read_some_async(char* buffer, std::size_t size, std::error_code&, Want&) noexcept;
     std::size_t do_write_some_async(const char* data, std::size_t size, std::error_code&, Want&) noexcept;
+    std::size_t do_write_gather_some_async(const ConstBuffer* buffers, std::size_t num_buffers, std::error_code&,
+                                           Want&) noexcept;
 
     friend class Service::BasicStreamOps<Socket>;
     friend class Service::BasicStreamOps<ssl::Stream>;
@@ -2161,8 +2188,17 @@ public:
 //                                   std::error_code& ec, Want& want) noexcept;
 //    std::size_t do_write_some_async(const char* data, std::size_t size,
 //                                    std::error_code& ec, Want& want) noexcept;
+//    std::size_t do_write_gather_some_async(const ConstBuffer* buffers,
+//                                           std::size_t num_buffers,
+//                                           std::error_code& ec,
+//                                           Want& want) noexcept;
+//
+// do_write_gather_some_async() behaves like do_write_some_async(), except that
+// the bytes are taken from the specified buffers in order. It is only ever
+// passed nonempty buffers, and at least one of them. A stream that cannot write
+// from several buffers at once may write from the first buffer only.
 //
-// If an error occurs during any of these 6 functions, the `ec` argument must be
+// If an error occurs during any of these 7 functions, the `ec` argument must be
 // set accordingly. Otherwise the `ec` argument must be set to
 // `std::error_code()`.
 //
@@ -2233,11 +2269,15 @@ public:
     class ReadOper;
     template <class H>
     class WriteOper;
+    class WriteGatherOperBase;
+    template <class H>
+    class WriteGatherOper;
     template <class H>
     class BufferedReadOper;
 
     using LendersReadOperPtr = std::unique_ptr<ReadOperBase, LendersOperDeleter>;
     using LendersWriteOperPtr = std::unique_ptr<WriteOperBase, LendersOperDeleter>;
+    using LendersWriteGatherOperPtr = std::unique_ptr<WriteGatherOperBase, LendersOperDeleter>;
     using LendersBufferedReadOperPtr = std::unique_ptr<BufferedReadOperBase, LendersOperDeleter>;
 
     // Synchronous read
@@ -2350,6 +2390,14 @@ public:
         stream.lowest_layer().m_desc.initiate_oper(std::move(op));                                      // Throws
     }
 
+    template <class H>
+    static void async_write_gather(S& stream, const ConstBuffer* buffers, std::size_t num_buffers, H&& handler)
+    {
+        LendersWriteGatherOperPtr op = Service::alloc<WriteGatherOper<H>>(
+            stream.lowest_layer().m_write_oper, stream, buffers, num_buffers, std::move(handler)); // Throws
+        stream.lowest_layer().m_desc.initiate_oper(std::move(op));                                 // Throws
+    }
+
     template <class H>
     static void async_buffered_read(S& stream, char* buffer, std::size_t size, int delim, ReadAheadBuffer& rab,
                                     H&& handler)
@@ -2550,6 +2598,126 @@ protected:
     const char* m_curr = m_begin; // May be dangling after cancellation
 };
 
+template <class S>
+class Service::BasicStreamOps<S>::WriteGatherOperBase : public StreamOper {
+public:
+    WriteGatherOperBase(std::size_t size, S& stream, const ConstBuffer* buffers, std::size_t num_buffers) noexcept
+        : StreamOper{size, stream}
+        , m_buffers{buffers}
+        , m_num_buffers{num_buffers}
+    {
+        skip_empty_buffers();
+    }
+    Want initiate()
+    {
+        auto& s = *this;
+        REALM_ASSERT(this == s.m_stream->lowest_layer().m_write_oper.get());
+        REALM_ASSERT(!s.is_complete());
+        Want want = Want::nothing;
+        if (REALM_UNLIKELY(s.m_curr_buffer == s.m_num_buffers)) {
+            s.set_is_complete(true); // Success
+        }
+        else {
+            s.m_stream->lowest_layer().m_desc.ensure_nonblocking_mode(); // Throws
+            s.m_stream->do_init_write_async(s.m_error_code, want);
+            if (want == Want::nothing) {
+                if (REALM_UNLIKELY(s.m_error_code)) {
+                    s.set_is_complete(true); // Failure
+                }
+                else {
+                    want = advance();
+                }
+            }
+        }
+        return want;
+    }
+    Want advance() noexcept override final
+    {
+        auto& s = *this;
+        REALM_ASSERT(!s.is_complete());
+        REALM_ASSERT(!s.is_canceled());
+        REALM_ASSERT(!s.m_error_code);
+        REALM_ASSERT(s.m_curr_buffer < s.m_num_buffers);
+        for (;;) {
+            // Write from the remaining part of the callers buffers, at most
+            // `s_max_buffers_per_write` of them at a time
+            ConstBuffer buffers[s_max_buffers_per_write];
+            std::size_t num_buffers = 0;
+            std::size_t size = 0;
+            for (std::size_t i = s.m_curr_buffer; i < s.m_num_buffers; ++i) {
+                if (num_buffers == s_max_buffers_per_write)
+                    break;
+                ConstBuffer buffer = s.m_buffers[i];
+                if (i == s.m_curr_buffer) {
+                    buffer.data += s.m_curr_offset;
+                    buffer.size -= s.m_curr_offset;
+                }
+                if (buffer.size == 0)
+                    continue;
+                buffers[num_buffers++] = buffer;
+                size += buffer.size;
+            }
+            Want want = Want::nothing;
+            std::size_t n = s.m_stream->do_write_gather_some_async(buffers, num_buffers, s.m_error_code, want);
+            REALM_ASSERT(n > 0 || s.m_error_code || want != Want::nothing); // No busy loop, please
+            bool wrote_nothing = (n == 0);
+            if (wrote_nothing) {
+                if (REALM_UNLIKELY(s.m_error_code)) {
+                    s.set_is_complete(true); // Failure
+                    return Want::nothing;
+                }
+                // Wrote nothing, but want something written
+                return want;
+            }
+            REALM_ASSERT(!s.m_error_code);
+            // Check for completion
+            REALM_ASSERT(n <= size);
+            consume(n);
+            if (s.m_curr_buffer == s.m_num_buffers) {
+                s.set_is_complete(true); // Success
+                return Want::nothing;
+            }
+            if (want != Want::nothing)
+                return want;
+        }
+    }
+
+protected:
+    // The number of buffers passed to each invocation of
+    // do_write_gather_some_async(). Well below the smallest IOV_MAX of any
+    // supported platform.
+    static constexpr std::size_t s_max_buffers_per_write = 16;
+
+    const ConstBuffer* const m_buffers; // May be dangling after cancellation
+    const std::size_t m_num_buffers;
+    std::size_t m_curr_buffer = 0;
+    std::size_t m_curr_offset = 0;
+    std::size_t m_num_bytes_transferred = 0;
+
+    void consume(std::size_t n) noexcept
+    {
+        m_num_bytes_transferred += n;
+        while (n > 0) {
+            REALM_ASSERT(m_curr_buffer < m_num_buffers);
+            std::size_t remaining = m_buffers[m_curr_buffer].size - m_curr_offset;
+            if (n < remaining) {
+                m_curr_offset += n;
+                return;
+            }
+            n -= remaining;
+            ++m_curr_buffer;
+            m_curr_offset = 0;
+        }
+        skip_empty_buffers();
+    }
+
+    void skip_empty_buffers() noexcept
+    {
+        while (m_curr_buffer < m_num_buffers && m_buffers[m_curr_buffer].size == 0)
+            ++m_curr_buffer;
+    }
+};
+
 template <class S>
 class Service::BasicStreamOps<S>::BufferedReadOperBase : public StreamOper {
 public:
@@ -2687,6 +2855,34 @@ private:
     H m_handler;
 };
 
+template <class S>
+template <class H>
+class Service::BasicStreamOps<S>::WriteGatherOper : public WriteGatherOperBase {
+public:
+    WriteGatherOper(std::size_t size, S& stream, const ConstBuffer* buffers, std::size_t num_buffers, H&& handler)
+        : WriteGatherOperBase{size, stream, buffers, num_buffers}
+        , m_handler{std::move(handler)}
+    {
+    }
+    void recycle_and_execute() override final
+    {
+        auto& s = *this;
+        REALM_ASSERT(s.is_complete() || s.is_canceled());
+        REALM_ASSERT(s.is_complete() == (s.m_error_code || s.m_curr_buffer == s.m_num_buffers));
+        bool orphaned = !s.m_stream;
+        std::error_code ec = s.m_error_code;
+        if (s.is_canceled())
+            ec = error::operation_aborted;
+        std::size_t num_bytes_transferred = s.m_num_bytes_transferred;
+        // Note: do_recycle_and_execute() commits suicide.
+        s.template do_recycle_and_execute<H>(orphaned, s.m_handler, ec,
+                                             num_bytes_transferred); // Throws
+    }
+
+private:
+    H m_handler;
+};
+
 template <class S>
 template <class H>
 class Service::BasicStreamOps<S>::BufferedReadOper : public BufferedReadOperBase {
@@ -3322,6 +3518,12 @@ inline void Socket::async_write(const char* data, std::size_t size, H&& handler)
     StreamOps::async_write(*this, data, size, is_write_some, std::move(handler)); // Throws
 }
 
+template <class H>
+inline void Socket::async_write_gather(const ConstBuffer* buffers, std::size_t num_buffers, H&& handler)
+{
+    StreamOps::async_write_gather(*this, buffers, num_buffers, std::move(handler)); // Throws
+}
+
 template <class H>
 inline void Socket::async_read_some(char* buffer, std::size_t size, H&& handler)
 {
@@ -3413,6 +3615,22 @@ inline std::size_t Socket::do_write_some_async(const char* data, std::size_t siz
     return n;
 }
 
+inline std::size_t Socket::do_write_gather_some_async(const ConstBuffer* buffers, std::size_t num_buffers,
+                                                      std::error_code& ec, Want& want) noexcept
+{
+    std::error_code ec_2;
+    std::size_t n = m_desc.write_some_gather(buffers, num_buffers, ec_2);
+    bool success = (!ec_2 || ec_2 == error::resource_unavailable_try_again);
+    if (REALM_UNLIKELY(!success)) {
+        ec = ec_2;
+        want = Want::nothing; // Failure
+        return 0;
+    }
+    ec = std::error_code();
+    want = Want::write; // Success
+    return n;
+}
+
 // ---------------- Acceptor ----------------
 
 class Acceptor::AcceptOperBase : public Service::IoOper {
@@ -379,6 +379,12 @@ public:
     template <class H>
     void async_write(const char* data, std::size_t size, H handler);
 
+    /// See Socket::async_write_gather(). Each record is encrypted directly
+    /// from the callers buffers, but since SSL_write() takes only one buffer,
+    /// the records never span a buffer boundary.
+    template <class H>
+    void async_write_gather(const ConstBuffer* buffers, std::size_t num_buffers, H handler);
+
     template <class H>
     void async_read_some(char* buffer, std::size_t size, H handler);
 
@@ -434,6 +440,8 @@ private:
     std::size_t do_write_some_sync(const char* data, std::size_t size, std::error_code&) noexcept;
     std::size_t do_read_some_async(char* buffer, std::size_t size, std::error_code&, Want&) noexcept;
     std::size_t do_write_some_async(const char* data, std::size_t size, std::error_code&, Want&) noexcept;
+    std::size_t do_write_gather_some_async(const ConstBuffer* buffers, std::size_t num_buffers, std::error_code&,
+                                           Want&) noexcept;
 
     // The meaning of the arguments and return values of ssl_read() and
     // ssl_write() are identical to do_read_some_async() and
@@ -931,6 +939,12 @@ inline void Stream::async_write(const char* data, std::size_t size, H handler)
     StreamOps::async_write(*this, data, size, is_write_some, std::move(handler)); // Throws
 }
 
+template <class H>
+inline void Stream::async_write_gather(const ConstBuffer* buffers, std::size_t num_buffers, H handler)
+{
+    StreamOps::async_write_gather(*this, buffers, num_buffers, std::move(handler)); // Throws
+}
+
 template <class H>
 inline void Stream::async_read_some(char* buffer, std::size_t size, H handler)
 {
@@ -993,6 +1007,12 @@ inline std::size_t Stream::do_write_some_async(const char* data, std::size_t siz
     return ssl_write(data, size, ec, want);
 }
 
+inline std::size_t Stream::do_write_gather_some_async(const ConstBuffer* buffers, std::size_t, std::error_code& ec,
+                                                      Want& want) noexcept
+{
+    return ssl_write(buffers[0].data, buffers[0].size, ec, want);
+}
+
 inline Socket& Stream::lowest_layer() noexcept
 {
     return m_tcp_socket;
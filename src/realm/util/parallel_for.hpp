@@ -0,0 +1,94 @@
+/*************************************************************************
+ *
+ * Copyright 2022 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_UTIL_PARALLEL_FOR_HPP
+#define REALM_UTIL_PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace realm {
+namespace util {
+
+/// Returns std::thread::hardware_concurrency(), or 1 if that is unknown.
+inline std::size_t hardware_thread_count() noexcept
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/// Call `func(i)` for every `i` in `[0, count)`, distributing the calls over
+/// at most `num_threads` threads, one of which is the calling thread. The
+/// order in which the calls are made is unspecified.
+///
+/// If a call throws, no further calls are started, and the first exception is
+/// rethrown in the calling thread once all threads have finished.
+template <class F>
+void parallel_for(std::size_t count, std::size_t num_threads, F&& func)
+{
+    num_threads = std::min(num_threads, count);
+    if (num_threads <= 1) {
+        for (std::size_t i = 0; i < count; ++i)
+            func(i); // Throws
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto work = [&]() noexcept {
+        for (;;) {
+            std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= count)
+                return;
+            try {
+                func(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+                next.store(count, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    try {
+        for (std::size_t i = 1; i < num_threads; ++i)
+            threads.emplace_back(work); // Throws
+    }
+    catch (...) {
+        // Could not start all the threads; the ones we have will do the work
+    }
+    work();
+    for (auto& thread : threads)
+        thread.join();
+    if (error)
+        std::rethrow_exception(error);
+}
+
+} // namespace util
+} // namespace realm
+
+#endif // REALM_UTIL_PARALLEL_FOR_HPP
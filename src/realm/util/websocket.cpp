@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <cctype>
 
+#include <zlib.h>
+
 #include <realm/util/websocket.hpp>
 #include <realm/util/buffer.hpp>
 #include <realm/util/network.hpp>
@@ -173,7 +176,8 @@ void mask_payload(char* masking_key, const char* payload, size_t payload_len, ch
     }
 }
 
-// make_frame() creates a WebSocket frame according to the WebSocket standard.
+// make_frame_header() creates the header of a WebSocket frame according to
+// the WebSocket standard.
 // \param fin indicates whether the frame is the final fragment in a message.
 // Sync clients and servers will only send unfragmented messages, but they must be
 // prepared to receive fragmented messages.
@@ -186,19 +190,22 @@ void mask_payload(char* masking_key, const char* payload, size_t payload_len, ch
 // 10 = close frame.
 // Sync clients and server will only send the last four, but must be prepared to
 // receive all.
+// \param compressed sets the RSV1 bit, which marks the first frame of a message
+// compressed with the permessage-deflate extension.
 // \param mask indicates whether the payload of the frame should be masked. Frames
 // are masked if and only if they originate from the client.
-// The payload is located in the buffer \param payload, and has size \param payload_size.
-// \param output is the output buffer. It must be large enough to contain the frame.
-// The frame size can at most be payload_size + 14.
+// \param payload_size is the size of the payload that follows the header.
+// \param output is the output buffer. The header size can at most be 14.
+// \param masking_key receives the masking key that is also written to the
+// header, if \a mask is true.
 // \param random is used to create a random masking key.
-// The return value is the size of the frame.
-size_t make_frame(bool fin, int opcode, bool mask, const char* payload, size_t payload_size, char* output,
-                  std::mt19937_64& random)
+// The return value is the size of the header.
+size_t make_frame_header(bool fin, int opcode, bool compressed, bool mask, size_t payload_size, char* output,
+                         char* masking_key, std::mt19937_64& random)
 {
     int index = 0; // used to keep track of position within the header.
     using uchar = unsigned char;
-    output[0] = (fin ? char(uchar(128)) : 0) + opcode; // fin and opcode in the first byte.
+    output[0] = (fin ? char(uchar(128)) : 0) + (compressed ? 64 : 0) + opcode; // fin, rsv1, and opcode.
     output[1] = (mask ? char(uchar(128)) : 0);         // First bit of the second byte is mask.
     if (payload_size <= 125) {                         // The payload length is contained in the second byte.
         output[1] += static_cast<char>(payload_size);
@@ -227,7 +234,6 @@ size_t make_frame(bool fin, int opcode, bool mask, const char* payload, size_t p
         index = 10;
     }
     if (mask) {
-        char masking_key[4];
         std::uniform_int_distribution<> dis(0, 255);
         for (int i = 0; i < 4; ++i) {
             masking_key[i] = dis(random);
@@ -236,15 +242,244 @@ size_t make_frame(bool fin, int opcode, bool mask, const char* payload, size_t p
         output[index++] = masking_key[1];
         output[index++] = masking_key[2];
         output[index++] = masking_key[3];
-        mask_payload(masking_key, payload, payload_size, output + index);
     }
-    else {
-        std::copy(payload, payload + payload_size, output + index);
+
+    return index;
+}
+
+// make_frame() creates a WebSocket frame whose payload is the concatenation of
+// \param pieces. See make_frame_header() for the other parameters.
+// \param output is the output buffer. It must be large enough to contain the frame.
+// The frame size can at most be the payload size + 14.
+// The return value is the size of the frame.
+size_t make_frame(bool fin, int opcode, bool compressed, bool mask, const network::ConstBuffer* pieces,
+                  size_t num_pieces, char* output, std::mt19937_64& random)
+{
+    size_t payload_size = 0;
+    for (size_t i = 0; i < num_pieces; ++i)
+        payload_size += pieces[i].size;
+    char masking_key[4];
+    size_t header_size =
+        make_frame_header(fin, opcode, compressed, mask, payload_size, output, masking_key, random);
+    char* payload = output + header_size;
+    for (size_t i = 0; i < num_pieces; ++i) {
+        const network::ConstBuffer& piece = pieces[i];
+        std::copy(piece.data, piece.data + piece.size, payload);
+        payload += piece.size;
+    }
+    if (mask)
+        mask_payload(masking_key, output + header_size, payload_size, output + header_size);
+
+    return header_size + payload_size;
+}
+
+// The value of the Sec-WebSocket-Extensions header offered by clients and
+// returned by servers. Both directions compress every message independently of
+// the previous ones, so that no compression state needs to be kept between
+// messages (RFC 7692 section 7.1.1).
+const char* const permessage_deflate_extension =
+    "permessage-deflate; client_no_context_takeover; server_no_context_takeover";
+
+// Splits a Sec-WebSocket-Extensions header value into extensions, and each
+// extension into its name followed by its parameters, with whitespace removed.
+std::vector<std::vector<std::string>> parse_websocket_extensions(StringData header_value)
+{
+    std::vector<std::vector<std::string>> extensions;
+    std::vector<std::string> extension;
+    std::string token;
+    auto end_token = [&] {
+        if (!token.empty())
+            extension.push_back(std::move(token)); // Throws
+        token.clear();
+    };
+    for (char ch : std::string_view(header_value)) {
+        if (ch == ',') {
+            end_token();
+            if (!extension.empty())
+                extensions.push_back(std::move(extension)); // Throws
+            extension.clear();
+        }
+        else if (ch == ';') {
+            end_token();
+        }
+        else if (ch != ' ' && ch != '\t') {
+            token += ch; // Throws
+        }
     }
+    end_token();
+    if (!extension.empty())
+        extensions.push_back(std::move(extension)); // Throws
+    return extensions;
+}
 
-    return payload_size + index;
+// Returns the LZ77 window size, as a base 2 logarithm, that the local end
+// must compress with according to the negotiated permessage-deflate
+// parameters in \param params, or zero if the parameters are not supported.
+// \param own_prefix is "client_" or "server_".
+int permessage_deflate_window_bits(const std::vector<std::string>& params, const char* own_prefix)
+{
+    int window_bits = 15;
+    std::string own_max_window_bits = std::string(own_prefix) + "max_window_bits";
+    for (size_t i = 1; i < params.size(); ++i) {
+        const std::string& param = params[i];
+        if (param == "client_no_context_takeover" || param == "server_no_context_takeover")
+            continue;
+        if (param == "client_max_window_bits" || param == "server_max_window_bits")
+            continue; // No value means no limit
+        size_t eq = param.find('=');
+        std::string name = param.substr(0, eq);
+        if (eq == std::string::npos ||
+            (name != "client_max_window_bits" && name != "server_max_window_bits"))
+            return 0;
+        std::string value = param.substr(eq + 1);
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+            value = value.substr(1, value.size() - 2);
+        if (value.empty() || value.size() > 2 || !std::isdigit(value[0], std::locale::classic()) ||
+            !std::isdigit(value.back(), std::locale::classic()))
+            return 0;
+        int bits = std::stoi(value);
+        if (bits < 8 || bits > 15)
+            return 0;
+        if (name == own_max_window_bits) {
+            // zlib does not support a window of 256 bytes for raw deflate, and
+            // a larger window than the negotiated one must not be used
+            if (bits == 8)
+                return 0;
+            window_bits = bits;
+        }
+    }
+    return window_bits;
 }
 
+// Compresses and decompresses messages according to the permessage-deflate
+// extension (RFC 7692) without context takeover. The zlib streams are created
+// on first use, and reset before each message.
+class PerMessageDeflate {
+public:
+    ~PerMessageDeflate()
+    {
+        if (m_deflate_initialized)
+            deflateEnd(&m_deflate);
+        if (m_inflate_initialized)
+            inflateEnd(&m_inflate);
+    }
+
+    // Compresses the concatenation of \param pieces into \param out. Returns
+    // false if the result would not be smaller than the input, in which case
+    // the message should be sent uncompressed.
+    bool compress(const network::ConstBuffer* pieces, size_t num_pieces, size_t payload_size, int window_bits,
+                  std::vector<char>& out)
+    {
+        if (payload_size > std::numeric_limits<uInt>::max() - 4)
+            return false;
+        if (!m_deflate_initialized || m_deflate_window_bits != window_bits) {
+            if (m_deflate_initialized)
+                deflateEnd(&m_deflate);
+            m_deflate = z_stream{};
+            m_deflate_initialized = false;
+            int ret = deflateInit2(&m_deflate, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -window_bits, 8,
+                                   Z_DEFAULT_STRATEGY);
+            if (ret != Z_OK)
+                return false;
+            m_deflate_initialized = true;
+            m_deflate_window_bits = window_bits;
+        }
+        else {
+            deflateReset(&m_deflate);
+        }
+        // The trailing 4 octets (0x00 0x00 0xff 0xff) of the sync flush are
+        // removed from the message, so there is only a gain if the compressed
+        // size is less than payload_size + 4.
+        size_t max_size = payload_size + 4;
+        if (out.size() < max_size)
+            out.resize(max_size); // Throws
+        m_deflate.next_out = reinterpret_cast<Bytef*>(out.data());
+        m_deflate.avail_out = uInt(max_size);
+        for (size_t i = 0; i < num_pieces; ++i) {
+            if (pieces[i].size == 0 && i + 1 != num_pieces)
+                continue;
+            m_deflate.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(pieces[i].data));
+            m_deflate.avail_in = uInt(pieces[i].size);
+            int flush = (i + 1 == num_pieces ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+            int ret = deflate(&m_deflate, flush);
+            if (ret != Z_OK || m_deflate.avail_in != 0)
+                return false; // Ran out of space
+        }
+        if (m_deflate.avail_out == 0)
+            return false; // Flush might not have completed
+        size_t size = max_size - m_deflate.avail_out;
+        REALM_ASSERT(size >= 4);
+        m_compressed_size = size - 4;
+        return m_compressed_size < payload_size;
+    }
+
+    size_t compressed_size() const noexcept
+    {
+        return m_compressed_size;
+    }
+
+    enum class InflateResult { ok, bad_data, too_big };
+
+    // Decompresses a message received with the RSV1 bit set. Fails if the
+    // message is not valid raw deflate data, or if it inflates to more than
+    // \param max_size bytes.
+    InflateResult decompress(const char* data, size_t size, std::vector<char>& out, size_t& out_size,
+                             size_t max_size)
+    {
+        if (!m_inflate_initialized) {
+            m_inflate = z_stream{};
+            if (inflateInit2(&m_inflate, -15) != Z_OK)
+                return InflateResult::bad_data;
+            m_inflate_initialized = true;
+        }
+        else {
+            inflateReset(&m_inflate);
+        }
+        static const char tail[4] = {0x00, 0x00, char(0xff), char(0xff)};
+        out_size = 0;
+        // One byte more than allowed is enough to detect a message that is too big
+        size_t max_buffer_size = max_size + 1;
+        if (out.size() < 2 * size + 64)
+            out.resize(std::min(2 * size + 64, max_buffer_size)); // Throws
+        for (int i = 0; i < 2; ++i) {
+            m_inflate.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(i == 0 ? data : tail));
+            m_inflate.avail_in = uInt(i == 0 ? size : 4);
+            for (;;) {
+                if (out_size > max_size)
+                    return InflateResult::too_big;
+                if (out_size == out.size())
+                    out.resize(std::min(2 * out.size(), max_buffer_size)); // Throws
+                size_t avail_out = std::min<size_t>(out.size() - out_size, std::numeric_limits<uInt>::max());
+                m_inflate.next_out = reinterpret_cast<Bytef*>(out.data() + out_size);
+                m_inflate.avail_out = uInt(avail_out);
+                int ret = inflate(&m_inflate, Z_SYNC_FLUSH);
+                out_size += avail_out - m_inflate.avail_out;
+                if (out_size > max_size)
+                    return InflateResult::too_big;
+                if (ret == Z_STREAM_END)
+                    return InflateResult::ok; // The sender ended the message with a final block
+                if (ret != Z_OK && ret != Z_BUF_ERROR)
+                    return InflateResult::bad_data;
+                // Done with this input when all of it was consumed without
+                // filling the output buffer.
+                if (m_inflate.avail_in == 0 && m_inflate.avail_out != 0)
+                    break;
+                if (ret == Z_BUF_ERROR && m_inflate.avail_out != 0)
+                    return InflateResult::bad_data; // No progress possible
+            }
+        }
+        return InflateResult::ok;
+    }
+
+private:
+    z_stream m_deflate;
+    z_stream m_inflate;
+    bool m_deflate_initialized = false;
+    bool m_inflate_initialized = false;
+    int m_deflate_window_bits = 0;
+    size_t m_compressed_size = 0;
+};
+
 // class FrameReader takes care of parsing the incoming bytes and
 // constructing the received WebSocket messages. FrameReader manages
 // read buffers internally. FrameReader handles fragmented messages as
@@ -266,6 +501,8 @@ size_t make_frame(bool fin, int opcode, bool mask, const char* payload, size_t p
 //     // frame_reader.delivery_size
 //     // with opcode (type)
 //     // frame_reader.delivery_opcode
+//     // which must be decompressed if
+//     // frame_reader.delivery_compressed
 // }
 // else {
 //    // read frame_reader.read_size
@@ -284,11 +521,13 @@ public:
     char* read_buffer = nullptr;
     bool protocol_error = false;
     bool delivery_ready = false;
+    bool delivery_compressed = false;
     websocket::Opcode delivery_opcode = websocket::Opcode::continuation;
 
-    FrameReader(util::Logger& logger, bool& is_client)
+    FrameReader(util::Logger& logger, bool& is_client, bool& permessage_deflate)
         : logger(logger)
         , m_is_client(is_client)
+        , m_permessage_deflate(permessage_deflate)
     {
     }
 
@@ -326,6 +565,7 @@ public:
 
 private:
     bool& m_is_client;
+    bool& m_permessage_deflate;
 
     char header_buffer[14];
     char* m_masking_key;
@@ -344,6 +584,9 @@ private:
     // The opcode of the message.
     websocket::Opcode m_message_opcode = websocket::Opcode::continuation;
 
+    // Whether the RSV1 bit was set in the first frame of the message.
+    bool m_message_compressed = false;
+
     // The size of the stored Websocket message.
     // This size is not the same as the size of the buffer.
     size_t m_message_size = 0;
@@ -384,6 +627,7 @@ private:
         if (m_message_buffer.size() != s_message_buffer_min_size)
             m_message_buffer.resize(s_message_buffer_min_size);
         m_message_opcode = websocket::Opcode::continuation;
+        m_message_compressed = false;
         m_message_size = 0;
     }
 
@@ -397,6 +641,7 @@ private:
         delivery_ready = false;
         delivery_buffer = nullptr;
         delivery_size = 0;
+        delivery_compressed = false;
         delivery_opcode = websocket::Opcode::continuation;
         m_stage = Stage::header_beginning;
         reset_message_buffer();
@@ -412,8 +657,13 @@ private:
         // bit 1.
         m_fin = ((header_buffer[0] & 128) == 128);
 
-        // bit 2,3, and 4.
-        char rsv = (header_buffer[0] & 112) >> 4;
+        // bit 2, which is only used by the permessage-deflate extension.
+        bool rsv1 = ((header_buffer[0] & 64) == 64);
+        if (rsv1 && !m_permessage_deflate)
+            return set_protocol_error();
+
+        // bit 3 and 4.
+        char rsv = (header_buffer[0] & 48) >> 4;
         if (rsv != 0)
             return set_protocol_error();
 
@@ -434,7 +684,7 @@ private:
         m_short_payload_size = (header_buffer[1] & 127);
 
         if (m_opcode == websocket::Opcode::continuation) {
-            if (m_message_opcode == websocket::Opcode::continuation)
+            if (m_message_opcode == websocket::Opcode::continuation || rsv1)
                 return set_protocol_error();
         }
         else if (m_opcode == websocket::Opcode::text || m_opcode == websocket::Opcode::binary) {
@@ -442,9 +692,10 @@ private:
                 return set_protocol_error();
 
             m_message_opcode = m_opcode;
+            m_message_compressed = rsv1;
         }
         else { // close, ping, pong.
-            if (!m_fin || m_short_payload_size > 125)
+            if (!m_fin || m_short_payload_size > 125 || rsv1)
                 return set_protocol_error();
         }
 
@@ -525,6 +776,7 @@ private:
             m_opcode == websocket::Opcode::pong) {
             m_stage = Stage::delivery;
             delivery_ready = true;
+            delivery_compressed = false;
             delivery_opcode = m_opcode;
             delivery_buffer = control_buffer;
             delivery_size = m_payload_size;
@@ -534,6 +786,7 @@ private:
             if (m_fin) {
                 m_stage = Stage::delivery;
                 delivery_ready = true;
+                delivery_compressed = m_message_compressed;
                 delivery_opcode = m_message_opcode;
                 delivery_buffer = m_message_buffer.data();
                 delivery_size = m_message_size;
@@ -552,6 +805,7 @@ private:
         read_buffer = header_buffer;
         read_size = 2;
         delivery_ready = false;
+        delivery_compressed = false;
         delivery_buffer = nullptr;
         delivery_size = 0;
         delivery_opcode = websocket::Opcode::continuation;
@@ -568,7 +822,7 @@ public:
     WebSocket(websocket::Config& config)
         : m_config(config)
         , m_logger(config.websocket_get_logger())
-        , m_frame_reader(config.websocket_get_logger(), m_is_client)
+        , m_frame_reader(config.websocket_get_logger(), m_is_client, m_permessage_deflate)
     {
         m_logger.debug("WebSocket::Websocket()");
     }
@@ -580,6 +834,8 @@ public:
 
         m_stopped = false;
         m_is_client = true;
+        m_permessage_deflate = false;
+        m_permessage_deflate_offered = m_config.websocket_permessage_deflate_enabled();
 
         m_sec_websocket_key = make_random_sec_websocket_key(m_config.websocket_get_random());
 
@@ -595,6 +851,8 @@ public:
         req.headers["Sec-WebSocket-Key"] = m_sec_websocket_key;
         req.headers["Sec-WebSocket-Version"] = sec_websocket_version;
         req.headers["Sec-WebSocket-Protocol"] = sec_websocket_protocol;
+        if (m_permessage_deflate_offered)
+            req.headers["Sec-WebSocket-Extensions"] = permessage_deflate_extension;
 
         m_logger.trace("HTTP request =\n%1", req);
 
@@ -622,10 +880,12 @@ public:
         m_http_client->async_request(req, std::move(handler));
     }
 
-    void initiate_server_websocket_after_handshake()
+    void initiate_server_websocket_after_handshake(bool permessage_deflate)
     {
         m_stopped = false;
         m_is_client = false;
+        m_permessage_deflate = permessage_deflate;
+        m_deflate_window_bits = 15;
         m_frame_reader.reset();
         frame_reader_loop(); // Throws
     }
@@ -636,6 +896,8 @@ public:
 
         m_stopped = false;
         m_is_client = false;
+        m_permessage_deflate = false;
+        m_deflate_window_bits = 15;
         m_http_server.reset(new HTTPServer<websocket::Config>(m_config, m_logger));
         m_frame_reader.reset();
 
@@ -659,8 +921,11 @@ public:
         m_http_server->async_receive_request(std::move(handler));
     }
 
-    void async_write_frame(bool fin, int opcode, const char* data, size_t size,
-                           util::UniqueFunction<void()> write_completion_handler)
+    // If \a borrow_pieces is true, the pieces must stay valid until the
+    // completion handler is called. Otherwise they are copied before this
+    // function returns.
+    void async_write_frame(bool fin, int opcode, const network::ConstBuffer* pieces, size_t num_pieces,
+                           bool borrow_pieces, util::UniqueFunction<void()> write_completion_handler)
     {
         REALM_ASSERT(!m_stopped);
 
@@ -668,14 +933,87 @@ public:
 
         bool mask = m_is_client;
 
+        size_t payload_size = 0;
+        for (size_t i = 0; i < num_pieces; ++i)
+            payload_size += pieces[i].size;
+
+        network::ConstBuffer compressed_piece;
+        bool compressed = fin && try_compress(opcode, pieces, num_pieces, payload_size, compressed_piece);
+        if (compressed) {
+            pieces = &compressed_piece;
+            num_pieces = 1;
+            payload_size = compressed_piece.size;
+        }
+
+        // Unmasked frames whose payload is too large to be copied cheaply are
+        // written directly from the callers buffers, with the header in front
+        // of them, when the caller keeps them alive. Masked frames must be
+        // copied anyway.
+        if ((borrow_pieces || compressed) && !mask && payload_size > s_write_buffer_stable_size) {
+            char masking_key[4];
+            size_t header_size = make_frame_header(fin, opcode, compressed, mask, payload_size, m_frame_header,
+                                                   masking_key, m_config.websocket_get_random());
+            m_write_pieces.clear();
+            m_write_pieces.push_back({m_frame_header, header_size}); // Throws
+            m_write_pieces.insert(m_write_pieces.end(), pieces, pieces + num_pieces); // Throws
+            m_config.async_write_gather(m_write_pieces.data(), m_write_pieces.size(),
+                                        make_write_handler()); // Throws
+            return;
+        }
+
         // 14 is the maximum header length of a Websocket frame.
-        size_t required_size = size + 14;
+        size_t required_size = payload_size + 14;
         if (m_write_buffer.size() < required_size)
             m_write_buffer.resize(required_size);
 
-        size_t message_size =
-            make_frame(fin, opcode, mask, data, size, m_write_buffer.data(), m_config.websocket_get_random());
+        size_t message_size = make_frame(fin, opcode, compressed, mask, pieces, num_pieces, m_write_buffer.data(),
+                                         m_config.websocket_get_random());
+
+        m_config.async_write(m_write_buffer.data(), message_size, make_write_handler());
+    }
+
+    void async_write_messages(int opcode, const network::ConstBuffer* messages, size_t num_messages,
+                              util::UniqueFunction<void()> write_completion_handler)
+    {
+        REALM_ASSERT(!m_stopped);
 
+        m_write_completion_handler = std::move(write_completion_handler);
+
+        bool mask = m_is_client;
+        bool fin = true;
+        size_t size = 0;
+        for (size_t i = 0; i < num_messages; ++i) {
+            network::ConstBuffer piece = messages[i];
+            bool compressed = try_compress(opcode, &messages[i], 1, messages[i].size, piece);
+
+            // 14 is the maximum header length of a Websocket frame.
+            size_t required_size = size + piece.size + 14;
+            if (m_write_buffer.size() < required_size)
+                m_write_buffer.resize(std::max(required_size, 2 * m_write_buffer.size()));
+
+            size += make_frame(fin, opcode, compressed, mask, &piece, 1, m_write_buffer.data() + size,
+                               m_config.websocket_get_random());
+        }
+
+        m_config.async_write(m_write_buffer.data(), size, make_write_handler());
+    }
+
+    // Compresses a data message into m_deflate_buffer if the permessage-deflate
+    // extension is in use, and compression makes the message smaller.
+    bool try_compress(int opcode, const network::ConstBuffer* pieces, size_t num_pieces, size_t payload_size,
+                      network::ConstBuffer& compressed_piece)
+    {
+        bool is_data = (opcode == int(websocket::Opcode::text) || opcode == int(websocket::Opcode::binary));
+        if (!m_permessage_deflate || !is_data || payload_size < s_min_compress_size)
+            return false;
+        if (!m_deflate.compress(pieces, num_pieces, payload_size, m_deflate_window_bits, m_deflate_buffer))
+            return false;
+        compressed_piece = {m_deflate_buffer.data(), m_deflate.compressed_size()};
+        return true;
+    }
+
+    websocket::WriteCompletionHandler make_write_handler()
+    {
         auto handler = [this](std::error_code ec, size_t) {
             // If the operation is aborted, then the write operation was canceled and we should ignore this callback.
             if (ec == util::error::operation_aborted) {
@@ -699,8 +1037,7 @@ public:
 
             handle_write_message();
         };
-
-        m_config.async_write(m_write_buffer.data(), message_size, handler);
+        return handler;
     }
 
     void handle_write_message()
@@ -709,6 +1046,10 @@ public:
             m_write_buffer.resize(s_write_buffer_stable_size);
             m_write_buffer.shrink_to_fit();
         }
+        if (m_deflate_buffer.size() > s_write_buffer_stable_size) {
+            m_deflate_buffer.resize(s_write_buffer_stable_size);
+            m_deflate_buffer.shrink_to_fit();
+        }
 
         auto handler = std::move(m_write_completion_handler);
         m_write_completion_handler = nullptr;
@@ -729,6 +1070,21 @@ private:
     bool m_stopped = false;
     bool m_is_client;
 
+    // State of the permessage-deflate extension. The window bits apply to the
+    // messages sent by this end.
+    bool m_permessage_deflate = false;
+    bool m_permessage_deflate_offered = false;
+    int m_deflate_window_bits = 15;
+    PerMessageDeflate m_deflate;
+    std::vector<char> m_deflate_buffer;
+    std::vector<char> m_inflate_buffer;
+
+    // Smaller messages are never compressed.
+    static const size_t s_min_compress_size = 256;
+
+    // The inflate buffer is shrunk to this size after larger messages.
+    static const size_t s_inflate_buffer_stable_size = 16384;
+
     // Allocated on demand.
     std::unique_ptr<HTTPClient<websocket::Config>> m_http_client;
     std::unique_ptr<HTTPServer<websocket::Config>> m_http_server;
@@ -739,6 +1095,11 @@ private:
     std::vector<char> m_write_buffer;
     static const size_t s_write_buffer_stable_size = 2048;
 
+    // Used when the payload of a frame is written directly from the callers
+    // buffers.
+    char m_frame_header[14];
+    std::vector<network::ConstBuffer> m_write_pieces;
+
     util::UniqueFunction<void()> m_write_completion_handler;
 
     void error_client_malformed_response()
@@ -854,6 +1215,12 @@ private:
 
         bool valid = (find_sec_websocket_accept(response.headers) &&
                       m_sec_websocket_accept == make_sec_websocket_accept(m_sec_websocket_key));
+        if (valid) {
+            util::Optional<StringData> extensions =
+                find_http_header_value(response.headers, "Sec-WebSocket-Extensions");
+            if (extensions)
+                valid = accept_negotiated_extensions(*extensions); // Throws
+        }
         if (!valid) {
             error_client_response_websocket_headers_invalid(response);
             return;
@@ -867,6 +1234,26 @@ private:
         frame_reader_loop();
     }
 
+    // The server may only accept extensions that the client has offered, and
+    // only one of each. The inflater is reset before each message, so the
+    // server must also have agreed to compress without context takeover.
+    bool accept_negotiated_extensions(StringData header_value)
+    {
+        for (const std::vector<std::string>& extension : parse_websocket_extensions(header_value)) {
+            if (!m_permessage_deflate_offered || m_permessage_deflate ||
+                extension.front() != "permessage-deflate")
+                return false;
+            if (std::find(extension.begin() + 1, extension.end(), "server_no_context_takeover") == extension.end())
+                return false;
+            int window_bits = permessage_deflate_window_bits(extension, "client_");
+            if (window_bits == 0)
+                return false;
+            m_permessage_deflate = true;
+            m_deflate_window_bits = window_bits;
+        }
+        return true;
+    }
+
     void handle_http_request_received(HTTPRequest request)
     {
         m_logger.trace("WebSocket::handle_http_request_received()");
@@ -882,6 +1269,8 @@ private:
             return;
         }
         REALM_ASSERT(response);
+        if (m_config.websocket_permessage_deflate_enabled())
+            m_permessage_deflate = websocket::accept_permessage_deflate(request, *response); // Throws
 
         auto handler = [request, this](std::error_code ec) {
             // If the operation is aborted, the socket object may have been destroyed.
@@ -960,14 +1349,29 @@ private:
         if (m_frame_reader.delivery_ready) {
             bool should_continue = true;
 
+            const char* data = m_frame_reader.delivery_buffer;
+            size_t size = m_frame_reader.delivery_size;
+            if (m_frame_reader.delivery_compressed) {
+                size_t max_size = m_config.websocket_max_inflated_message_size();
+                switch (m_deflate.decompress(data, size, m_inflate_buffer, size, max_size)) { // Throws
+                    case PerMessageDeflate::InflateResult::ok:
+                        break;
+                    case PerMessageDeflate::InflateResult::bad_data:
+                        protocol_error(Error::bad_message);
+                        return;
+                    case PerMessageDeflate::InflateResult::too_big:
+                        protocol_error(Error::message_too_big);
+                        return;
+                }
+                data = m_inflate_buffer.data();
+            }
+
             switch (m_frame_reader.delivery_opcode) {
                 case websocket::Opcode::text:
-                    should_continue = m_config.websocket_text_message_received(m_frame_reader.delivery_buffer,
-                                                                               m_frame_reader.delivery_size);
+                    should_continue = m_config.websocket_text_message_received(data, size);
                     break;
                 case websocket::Opcode::binary:
-                    should_continue = m_config.websocket_binary_message_received(m_frame_reader.delivery_buffer,
-                                                                                 m_frame_reader.delivery_size);
+                    should_continue = m_config.websocket_binary_message_received(data, size);
                     break;
                 case websocket::Opcode::close: {
                     auto [error_code, error_message] =
@@ -994,6 +1398,11 @@ private:
             if (m_stopped)
                 return;
 
+            if (m_inflate_buffer.size() > s_inflate_buffer_stable_size) {
+                m_inflate_buffer.resize(s_inflate_buffer_stable_size);
+                m_inflate_buffer.shrink_to_fit();
+            }
+
             // recursion is harmless, since the depth will be at most 2.
             frame_reader_loop();
             return;
@@ -1069,6 +1478,8 @@ const char* get_error_message(Error error_code)
             return "Bad WebSocket response header protocol violation";
         case Error::bad_message:
             return "Ill-formed WebSocket message";
+        case Error::message_too_big:
+            return "WebSocket message inflates to more than the maximum message size";
     }
     return nullptr;
 }
@@ -1137,6 +1548,44 @@ class CloseStatusErrorCategory : public std::error_category {
 } // unnamed namespace
 
 
+namespace {
+
+// Write the buffers one at a time. Used when the stream offers no gather
+// write.
+void async_write_each(websocket::Config& config, const network::ConstBuffer* buffers, size_t num_buffers,
+                      size_t num_bytes_transferred, websocket::WriteCompletionHandler handler)
+{
+    REALM_ASSERT(num_buffers > 0);
+    auto handler_2 = [&config, buffers, num_buffers, num_bytes_transferred,
+                      handler = std::move(handler)](std::error_code ec, size_t n) mutable {
+        if (ec || num_buffers == 1) {
+            handler(ec, num_bytes_transferred + n); // Throws
+            return;
+        }
+        async_write_each(config, buffers + 1, num_buffers - 1, num_bytes_transferred + n,
+                         std::move(handler)); // Throws
+    };
+    config.async_write(buffers[0].data, buffers[0].size, std::move(handler_2)); // Throws
+}
+
+} // unnamed namespace
+
+void websocket::Config::async_write_gather(const network::ConstBuffer* buffers, size_t num_buffers,
+                                           WriteCompletionHandler handler)
+{
+    async_write_each(*this, buffers, num_buffers, 0, std::move(handler)); // Throws
+}
+
+bool websocket::Config::websocket_permessage_deflate_enabled() noexcept
+{
+    return false;
+}
+
+size_t websocket::Config::websocket_max_inflated_message_size() noexcept
+{
+    return 128 * 1024 * 1024;
+}
+
 bool websocket::Config::websocket_text_message_received(const char*, size_t)
 {
     return true;
@@ -1194,15 +1643,16 @@ void websocket::Socket::initiate_server_handshake()
     m_impl->initiate_server_handshake();
 }
 
-void websocket::Socket::initiate_server_websocket_after_handshake()
+void websocket::Socket::initiate_server_websocket_after_handshake(bool permessage_deflate)
 {
-    m_impl->initiate_server_websocket_after_handshake();
+    m_impl->initiate_server_websocket_after_handshake(permessage_deflate);
 }
 
 void websocket::Socket::async_write_frame(bool fin, Opcode opcode, const char* data, size_t size,
                                           util::UniqueFunction<void()> handler)
 {
-    m_impl->async_write_frame(fin, int(opcode), data, size, std::move(handler));
+    network::ConstBuffer piece{data, size};
+    m_impl->async_write_frame(fin, int(opcode), &piece, 1, false, std::move(handler));
 }
 
 void websocket::Socket::async_write_text(const char* data, size_t size, util::UniqueFunction<void()> handler)
@@ -1215,6 +1665,18 @@ void websocket::Socket::async_write_binary(const char* data, size_t size, util::
     async_write_frame(true, Opcode::binary, data, size, std::move(handler));
 }
 
+void websocket::Socket::async_write_binary(const network::ConstBuffer* pieces, size_t num_pieces,
+                                           util::UniqueFunction<void()> handler)
+{
+    m_impl->async_write_frame(true, int(Opcode::binary), pieces, num_pieces, true, std::move(handler));
+}
+
+void websocket::Socket::async_write_binary_messages(const network::ConstBuffer* messages, size_t num_messages,
+                                                    util::UniqueFunction<void()> handler)
+{
+    m_impl->async_write_messages(int(Opcode::binary), messages, num_messages, std::move(handler));
+}
+
 void websocket::Socket::async_write_close(const char* data, size_t size, util::UniqueFunction<void()> handler)
 {
     async_write_frame(true, Opcode::close, data, size, std::move(handler));
@@ -1250,6 +1712,22 @@ util::Optional<HTTPResponse> websocket::make_http_response(const HTTPRequest& re
     return do_make_http_response(request, sec_websocket_protocol, ec);
 }
 
+bool websocket::accept_permessage_deflate(const HTTPRequest& request, HTTPResponse& response)
+{
+    util::Optional<StringData> header_value = find_http_header_value(request.headers, "Sec-WebSocket-Extensions");
+    if (!header_value)
+        return false;
+    // Offers that limit the window of the server are declined. A client that
+    // supports the extension is also expected to offer it without limits.
+    for (const std::vector<std::string>& offer : parse_websocket_extensions(*header_value)) {
+        if (offer.front() == "permessage-deflate" && permessage_deflate_window_bits(offer, "server_") == 15) {
+            response.headers["Sec-WebSocket-Extensions"] = permessage_deflate_extension; // Throws
+            return true;
+        }
+    }
+    return false;
+}
+
 const std::error_category& websocket::error_category() noexcept
 {
     return g_error_category;
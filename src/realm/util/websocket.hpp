@@ -10,6 +10,10 @@
 #include <system_error>
 #include <map>
 
+namespace realm::util::network {
+struct ConstBuffer;
+} // namespace realm::util::network
+
 namespace realm::util::websocket {
 
 using WriteCompletionHandler = util::UniqueFunction<void(std::error_code, size_t num_bytes_transferred)>;
@@ -26,6 +30,18 @@ public:
     /// The caller must supply a random number generator.
     virtual std::mt19937_64& websocket_get_random() noexcept = 0;
 
+    /// Whether the permessage-deflate extension (RFC 7692) should be offered
+    /// in the client handshake, or accepted in the server handshake. When the
+    /// extension is negotiated, larger data messages are compressed. Neither
+    /// end keeps the compression context between messages. The default is
+    /// false.
+    virtual bool websocket_permessage_deflate_enabled() noexcept;
+
+    /// The maximum size of a compressed message once it is decompressed. A
+    /// peer that sends a message which inflates to more than this is
+    /// disconnected with Error::message_too_big. The default is 128 MiB.
+    virtual size_t websocket_max_inflated_message_size() noexcept;
+
     //@{
     /// The three functions below are used by the Socket to read and write to the underlying
     /// stream. The functions will typically be implemented as wrappers to a TCP/TLS stream,
@@ -42,6 +58,16 @@ public:
     virtual void async_read_until(char* buffer, size_t size, char delim, ReadCompletionHandler handler) = 0;
     //@}
 
+    /// async_write_gather() writes the specified buffers, in order, as if they
+    /// were one contiguous buffer. The array of buffers, and the memory that it
+    /// refers to, remain valid until the completion handler is called. The
+    /// default implementation writes one buffer at a time using async_write().
+    /// Implementations backed by network::Socket or network::ssl::Stream should
+    /// forward to their async_write_gather(), so that large messages can be
+    /// written without being copied.
+    virtual void async_write_gather(const network::ConstBuffer* buffers, size_t num_buffers,
+                                    WriteCompletionHandler handler);
+
     /// websocket_handshake_completion_handler() is called when the websocket is connected, .i.e.
     /// after the handshake is done. It is not allowed to send messages on the socket before the
     /// handshake is done. No message_received callbacks will be called before the handshake is done.
@@ -121,8 +147,9 @@ public:
     /// function is to perform HTTP routing externally and then start the
     /// WebSocket in case the HTTP request is an Upgrade to WebSocket.
     /// Typically, the caller will have used make_http_response() to send the
-    /// HTTP response itself.
-    void initiate_server_websocket_after_handshake();
+    /// HTTP response itself. \a permessage_deflate must be the value returned
+    /// by accept_permessage_deflate() for that response, if it was called.
+    void initiate_server_websocket_after_handshake(bool permessage_deflate = false);
 
     /// The async_write_* functions send frames. Only one frame should be sent at a time,
     /// meaning that the user must wait for the handler to be called before sending the next frame.
@@ -132,7 +159,8 @@ public:
     /// async_write_frame() sends a single frame with this content:
     /// \param fin The fin bit set to 0 or 1
     /// \param opcode Specifies the opcpde.
-    /// \param data size The frame payload is taken from this buffer.
+    /// \param data size The frame payload is taken from this buffer. It is
+    /// copied, so it may be destroyed as soon as the function returns.
     /// \param handler Called when the frame has been successfully sent. Error s are reported through
     /// websocket_write_error_handler() in Config.
     /// This function is rather low level and should only be used with knowledge of the WebSocket protocol.
@@ -148,7 +176,8 @@ public:
     /// Five utility functions used to send whole messages. These five
     /// functions are implemented in terms of async_write_frame(). These
     /// functions send whole unfragmented messages. These functions should be
-    /// preferred over async_write_frame() for most use cases.
+    /// preferred over async_write_frame() for most use cases. Like
+    /// async_write_frame(), they copy the payload before returning.
     ///
     /// FIXME: Guarantee no callback reentrance, i.e., that the completion
     /// handler, or the error handler in case an error occurs, is never called
@@ -162,6 +191,22 @@ public:
     void async_write_pong(const char* data, size_t size, util::UniqueFunction<void()> handler);
     //@}
 
+    /// Send a binary message whose payload is the concatenation of the
+    /// specified pieces. Only the array of pieces itself may be destroyed
+    /// before the handler is called. On the server side, large messages are
+    /// written directly from the pieces using Config::async_write_gather()
+    /// instead of being copied into the frame buffer first.
+    void async_write_binary(const network::ConstBuffer* pieces, size_t num_pieces,
+                            util::UniqueFunction<void()> handler);
+
+    /// Send each of the specified buffers as a separate binary message, using
+    /// a single write to the underlying stream. This saves a write, and
+    /// possibly a network packet, per message when many small messages are
+    /// ready at once. The buffers may be destroyed as soon as this function
+    /// returns.
+    void async_write_binary_messages(const network::ConstBuffer* messages, size_t num_messages,
+                                     util::UniqueFunction<void()> handler);
+
     /// stop() stops the socket. The socket will stop processing incoming data,
     /// sending data, and calling callbacks.  It is an error to attempt to send
     /// a message after stop() has been called. stop() will typically be called
@@ -188,6 +233,12 @@ util::Optional<std::string> read_sec_websocket_protocol(const HTTPRequest& reque
 util::Optional<HTTPResponse> make_http_response(const HTTPRequest& request, const std::string& sec_websocket_protocol,
                                                 std::error_code& ec);
 
+/// accept_permessage_deflate() checks whether \a request offers the
+/// permessage-deflate extension in a form that the Socket supports. If it
+/// does, the extension is accepted by adding a Sec-WebSocket-Extensions header
+/// to \a response, and true is returned.
+bool accept_permessage_deflate(const HTTPRequest& request, HTTPResponse& response);
+
 enum class Error {
     bad_request_malformed_http,
     bad_request_header_upgrade,
@@ -211,7 +262,8 @@ enum class Error {
     bad_response_504_gateway_timeout,
     bad_response_unexpected_status_code,
     bad_response_header_protocol_violation,
-    bad_message
+    bad_message,
+    message_too_big
 };
 
 const std::error_category& websocket_close_status_category() noexcept;
@@ -418,6 +418,9 @@ public:
         milliseconds_type server_connection_reaper_interval = 100000000;
 
         long server_max_open_files = 64;
+        size_t server_max_open_files_size = 0;
+        int server_num_file_io_threads = 0;
+        int server_num_workers = 1;
 
         bool enable_server_ssl = false;
 
@@ -430,9 +433,15 @@ public:
         bool disable_history_compaction = false;
         std::chrono::seconds history_ttl = std::chrono::seconds::max();
         std::chrono::seconds history_compaction_interval = std::chrono::seconds{3600};
+        std::chrono::milliseconds history_compaction_time_budget = std::chrono::milliseconds{0};
+        std::size_t history_block_size = 0;
         const Clock* history_compaction_clock = nullptr;
 
         size_t max_download_size = 0x1000000; // 16 MB as in Server::Config
+        size_t max_download_cache_size = 0;
+
+        bool enable_permessage_deflate = false;
+        size_t max_coalesced_write_size = 0;
 
         bool one_connection_per_session = false;
 
@@ -506,6 +515,9 @@ public:
                 public_key = PKey::load_public(config.server_public_key_path);
             Server::Config config_2;
             config_2.max_open_files = config.server_max_open_files;
+            config_2.max_open_files_size = config.server_max_open_files_size;
+            config_2.num_file_io_threads = config.server_num_file_io_threads;
+            config_2.num_workers = config.server_num_workers;
             config_2.logger = &*m_server_loggers[i];
             config_2.token_expiration_clock = &m_fake_token_expiration_clock;
             config_2.ssl = m_enable_server_ssl;
@@ -514,11 +526,16 @@ public:
             config_2.connection_reaper_timeout = config.server_connection_reaper_timeout;
             config_2.connection_reaper_interval = config.server_connection_reaper_interval;
             config_2.max_download_size = config.max_download_size;
+            config_2.max_download_cache_size = config.max_download_cache_size;
+            config_2.enable_permessage_deflate = config.enable_permessage_deflate;
+            config_2.max_coalesced_write_size = config.max_coalesced_write_size;
             config_2.disable_download_compaction = config.disable_download_compaction;
             config_2.disable_history_compaction = config.disable_history_compaction;
             config_2.history_compaction_clock = config.history_compaction_clock;
             config_2.history_ttl = config.history_ttl;
             config_2.history_compaction_interval = config.history_compaction_interval;
+            config_2.history_compaction_time_budget = config.history_compaction_time_budget;
+            config_2.history_block_size = config.history_block_size;
             config_2.tcp_no_delay = true;
             config_2.authorization_header_name = config.authorization_header_name;
             config_2.encryption_key = make_crypt_key(config.server_encryption_key);
@@ -539,6 +556,7 @@ public:
             config_2.ping_keepalive_period = config.client_ping_period;
             config_2.pong_keepalive_timeout = config.client_pong_timeout;
             config_2.disable_upload_compaction = config.disable_upload_compaction;
+            config_2.enable_permessage_deflate = config.enable_permessage_deflate;
             config_2.one_connection_per_session = config.one_connection_per_session;
             config_2.disable_upload_activation_delay = config.disable_upload_activation_delay;
             m_clients[i] = std::make_unique<Client>(std::move(config_2));
@@ -38,10 +38,19 @@ struct InstructionBuilder : InstructionHandler {
         return m_log.intern_string(string);
     }
 };
+// Compaction leaves tombstones in place of the discarded instructions
+const sync::Instruction& first_instruction(const Changeset& changeset)
+{
+    for (const sync::Instruction* instr : changeset) {
+        if (instr)
+            return *instr;
+    }
+    REALM_UNREACHABLE();
+}
+
 } // unnamed namespace
 
-// FIXME: Compaction is disabled since path-based instructions.
-TEST_IF(CompactChangesets_RedundantSets, false)
+TEST(CompactChangesets_RedundantSets)
 {
     using Instruction = realm::sync::Instruction;
     Changeset changeset;
@@ -70,11 +79,175 @@ TEST_IF(CompactChangesets_RedundantSets, false)
     set3.value = Instruction::Payload(int64_t(123));
     push(set3);
 
-    CHECK_EQUAL(changeset.size(), 4);
+    CHECK_EQUAL(changeset.size(), 3);
+
+    compact_changesets(&changeset, 1);
+
+    CHECK_EQUAL(changeset.size(), 1);
+    CHECK_EQUAL(first_instruction(changeset).get_as<Instruction::Update>().value.data.integer, 123);
+}
+
+TEST(CompactChangesets_RedundantSetsAcrossChangesets)
+{
+    using Instruction = realm::sync::Instruction;
+    auto make_changeset = [](Changeset& changeset, Changeset::timestamp_type timestamp,
+                             Changeset::file_ident_type origin_file_ident, int64_t value) {
+        InstructionBuilder push(changeset);
+        changeset.origin_timestamp = timestamp;
+        changeset.origin_file_ident = origin_file_ident;
+        Instruction::Update set;
+        set.table = changeset.intern_string("Test");
+        set.object = changeset.intern_string("pk");
+        set.field = changeset.intern_string("foo");
+        set.value = Instruction::Payload(value);
+        push(set);
+    };
+
+    // The later changeset has the later timestamp
+    {
+        Changeset changesets[2];
+        make_changeset(changesets[0], 1, 2, 123);
+        make_changeset(changesets[1], 2, 3, 345);
+        compact_changesets(changesets, 2);
+        CHECK_EQUAL(changesets[0].size(), 0);
+        CHECK_EQUAL(changesets[1].size(), 1);
+    }
+
+    // The earlier changeset would win over a concurrent instruction that loses
+    // against the later one, so it must be kept
+    {
+        Changeset changesets[2];
+        make_changeset(changesets[0], 2, 2, 123);
+        make_changeset(changesets[1], 1, 3, 345);
+        compact_changesets(changesets, 2);
+        CHECK_EQUAL(changesets[0].size(), 1);
+        CHECK_EQUAL(changesets[1].size(), 1);
+    }
+    {
+        Changeset changesets[2];
+        make_changeset(changesets[0], 2, 2, 123);
+        make_changeset(changesets[1], 2, 3, 345);
+        compact_changesets(changesets, 2);
+        CHECK_EQUAL(changesets[0].size(), 1);
+        CHECK_EQUAL(changesets[1].size(), 1);
+    }
 
+    // Same timestamp, same origin
+    {
+        Changeset changesets[2];
+        make_changeset(changesets[0], 2, 2, 123);
+        make_changeset(changesets[1], 2, 2, 345);
+        compact_changesets(changesets, 2);
+        CHECK_EQUAL(changesets[0].size(), 0);
+        CHECK_EQUAL(changesets[1].size(), 1);
+    }
+}
+
+TEST(CompactChangesets_KeepsSetsThatAreNotRedundant)
+{
+    using Instruction = realm::sync::Instruction;
+    Changeset changeset;
+    InstructionBuilder push(changeset);
+
+    auto table = changeset.intern_string("Test");
+    auto make_set = [&](int64_t object, StringData field, Instruction::Path path, int64_t value) {
+        Instruction::Update set;
+        set.table = table;
+        set.object = object;
+        set.field = changeset.intern_string(field);
+        set.path = std::move(path);
+        set.value = Instruction::Payload(value);
+        return set;
+    };
+
+    // Different objects, fields, and list elements
+    push(make_set(1, "foo", {}, 1));
+    push(make_set(2, "foo", {}, 2));
+    push(make_set(1, "bar", {}, 3));
+    Instruction::Path index_0;
+    index_0.push_back(uint32_t(0));
+    Instruction::Path index_1;
+    index_1.push_back(uint32_t(1));
+    push(make_set(1, "list", index_0, 4));
+    push(make_set(1, "list", index_1, 5));
+
+    // Another instruction on the field in between
+    push(make_set(1, "baz", {}, 6));
+    Instruction::AddInteger add;
+    add.table = table;
+    add.object = int64_t(1);
+    add.field = changeset.intern_string("baz");
+    add.value = 1;
+    push(add);
+    push(make_set(1, "baz", {}, 7));
+
+    // An insertion into the list shifts the element that the later set refers
+    // to
+    Instruction::ArrayInsert insert;
+    insert.table = table;
+    insert.object = int64_t(1);
+    insert.field = changeset.intern_string("list");
+    insert.path = index_0;
+    insert.value = Instruction::Payload(int64_t(8));
+    insert.prior_size = 2;
+    push(insert);
+    push(make_set(1, "list", index_1, 9));
+
+    // A default value does not override an explicitly set one
+    push(make_set(3, "foo", {}, 10));
+    auto set_default = make_set(3, "foo", {}, 11);
+    set_default.is_default = true;
+    push(set_default);
+
+    std::size_t size = changeset.size();
     compact_changesets(&changeset, 1);
+    CHECK_EQUAL(changeset.size(), size);
+
+    // But a set of the same list element does
+    push(make_set(1, "list", index_1, 12));
+    compact_changesets(&changeset, 1);
+    CHECK_EQUAL(changeset.size(), size);
+    CHECK_EQUAL(changeset.get_string(first_instruction(changeset).get_as<Instruction::Update>().field), "foo");
+}
+
+TEST(CompactChangesets_DiscardsSetsOfErasedObjects)
+{
+    using Instruction = realm::sync::Instruction;
+    Changeset changesets[2];
+
+    auto make_set = [](Changeset& changeset, StringData field) {
+        Instruction::Update set;
+        set.table = changeset.intern_string("Test");
+        set.object = ObjectId("000000000000000000000001");
+        set.field = changeset.intern_string(field);
+        set.value = Instruction::Payload(int64_t(123));
+        return set;
+    };
+    {
+        InstructionBuilder push(changesets[0]);
+        Instruction::CreateObject create_object;
+        create_object.table = changesets[0].intern_string("Test");
+        create_object.object = ObjectId("000000000000000000000001");
+        push(create_object);
+        push(make_set(changesets[0], "foo"));
+        push(make_set(changesets[0], "bar"));
+    }
+    {
+        InstructionBuilder push(changesets[1]);
+        push(make_set(changesets[1], "foo"));
+        Instruction::EraseObject erase_object;
+        erase_object.table = changesets[1].intern_string("Test");
+        erase_object.object = ObjectId("000000000000000000000001");
+        push(erase_object);
+    }
+
+    compact_changesets(changesets, 2);
 
-    CHECK_EQUAL(changeset.size(), 2);
+    // The object is created and erased, but nothing is set on it
+    CHECK_EQUAL(changesets[0].size(), 1);
+    CHECK_EQUAL(first_instruction(changesets[0]).type(), Instruction::Type::CreateObject);
+    CHECK_EQUAL(changesets[1].size(), 1);
+    CHECK_EQUAL(first_instruction(changesets[1]).type(), Instruction::Type::EraseObject);
 }
 
 // FIXME: Compaction is disabled since path-based instructions.
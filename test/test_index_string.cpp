@@ -23,6 +23,7 @@
 #include <realm/index_string.hpp>
 #include <realm/query_expression.hpp>
 #include <realm/util/to_string.hpp>
+#include <map>
 #include <set>
 #include "test.hpp"
 #include "util/misc.hpp"
@@ -1826,4 +1827,260 @@ TEST(StringIndex_MixedEqualBitPattern)
     CHECK_EQUAL(tv.get_object(1).get_any(col), val1);
 }
 
+TEST(StringIndex_BulkBuild)
+{
+    Group g;
+    auto table = g.add_table("foo");
+    auto col_str = table->add_column(type_String, "str", true);
+    auto col_int = table->add_column(type_Int, "int", true);
+    auto col_mixed = table->add_column(type_Mixed, "any");
+
+    // Enough objects to be sorted on several threads, enough distinct keys on
+    // one level to need inner nodes, long common prefixes, values that only
+    // differ beyond the maximum depth, nulls, empty strings and values with
+    // equal index data.
+    std::string long_prefix(StringIndex::s_max_offset + 10, 'x');
+    std::vector<std::string> strings;
+    for (int i = 0; i < 9000; ++i) {
+        switch (i % 5) {
+            case 0:
+                strings.push_back(util::to_string(i % 1500));
+                break;
+            case 1:
+                strings.push_back(long_prefix + util::to_string(i % 7));
+                break;
+            case 2:
+                strings.push_back("abcdefgh");
+                break;
+            case 3:
+                strings.push_back("");
+                break;
+            default:
+                strings.push_back("common prefix " + util::to_string(i % 300));
+                break;
+        }
+    }
+    for (int i = 0; i < 9000; ++i) {
+        auto obj = table->create_object();
+        obj.set(col_str, i % 11 ? StringData(strings[i]) : StringData());
+        if (i % 13)
+            obj.set(col_int, int64_t(i % 17 ? i : 0));
+        if (i % 3)
+            obj.set(col_mixed, Mixed(strings[i]));
+        else
+            obj.set(col_mixed, Mixed(int64_t(i % 2 ? 0x6867666564636261 : i)));
+    }
+
+    auto check_index = [&](ColKey col) {
+        std::map<Mixed, size_t> expected;
+        for (auto o : *table)
+            ++expected[o.get_any(col)];
+        expected[col == col_int ? Mixed(int64_t(-1)) : Mixed("not there")] = 0;
+        for (auto& [value, count] : expected) {
+            Query q = table->where();
+            if (col == col_mixed)
+                q.equal(col, value);
+            else if (value.is_null())
+                q.equal(col, null());
+            else if (col == col_str)
+                q.equal(col, value.get_string());
+            else
+                q.equal(col, value.get_int());
+            auto tv = q.find_all();
+            CHECK_EQUAL(tv.size(), count);
+            for (size_t i = 0; i < tv.size(); ++i)
+                CHECK_EQUAL(tv.get_object(i).get_any(col), value);
+        }
+    };
+
+    for (unsigned num_threads : {1, 4}) {
+        set_parallel_sort_threshold(num_threads > 1 ? 1 : 0, num_threads);
+        table->add_search_index(col_str);
+        table->add_search_index(col_int);
+        table->add_search_index(col_mixed);
+        CHECK_EQUAL(table->count_string(col_str, "abcdefgh"), 1636);
+        check_index(col_str);
+        check_index(col_int);
+        check_index(col_mixed);
+        table->verify();
+
+        // The index can be updated as usual afterwards
+        table->get_object(0).set(col_str, "abcdefgh");
+        table->get_object(2).remove();
+        CHECK_EQUAL(table->count_string(col_str, "abcdefgh"), 1636);
+        check_index(col_str);
+
+        table->remove_search_index(col_str);
+        table->remove_search_index(col_int);
+        table->remove_search_index(col_mixed);
+    }
+    set_parallel_sort_threshold(0);
+}
+
+TEST(StringIndex_FullText)
+{
+    Group g;
+    auto table = g.add_table("foo");
+    auto col = table->add_column(type_String, "text", true);
+    auto col_int = table->add_column(type_Int, "int");
+
+    // Words shorter and longer than the 4 byte keys, words sharing prefixes
+    // and words that only differ in their last key.
+    std::vector<std::string> vocabulary = {"a", "an", "and", "ant", "anteater", "antelope", "abcd", "abcde",
+                                           "abcdefgh", "abcdefgi", "x", "zzzzzzzzzzzzzzzzzzzzzzzz"};
+    auto make_text = [&](int i) {
+        std::string text;
+        for (size_t j = 0; j < vocabulary.size(); ++j) {
+            if ((i >> j) % 3 == 0)
+                text += (j % 2 ? " " : ", ") + vocabulary[j];
+        }
+        return text;
+    };
+    std::vector<ObjKey> keys;
+    for (int i = 0; i < 600; ++i) {
+        keys.push_back(table->create_object().set(col, make_text(i)).get_key());
+    }
+    // Some objects get their index entries when the index is created, some later
+    table->add_fulltext_index(col);
+    for (int i = 600; i < 1200; ++i) {
+        keys.push_back(table->create_object().set(col, make_text(i)).get_key());
+    }
+    table->create_object();
+
+    CHECK(table->has_fulltext_index(col));
+    CHECK_NOT(table->has_search_index(col));
+    CHECK_NOT(table->get_search_index(col));
+    CHECK_THROW(table->add_search_index(col), LogicError);
+    CHECK_THROW(table->add_fulltext_index(col_int), LogicError);
+
+    auto check_index = [&] {
+        auto index = table->get_fulltext_index(col);
+        CHECK(index);
+        index->verify();
+        std::map<std::string, std::vector<ObjKey>> expected;
+        for (auto obj : *table) {
+            for (auto& word : tokenize_text(obj.get<StringData>(col)))
+                expected[word].push_back(obj.get_key());
+        }
+        for (auto& word : vocabulary) {
+            std::vector<ObjKey> found;
+            index->find_all(found, StringData(word));
+            CHECK(found == expected[word]);
+            CHECK_EQUAL(index->count(StringData(word)), expected[word].size());
+        }
+        std::vector<ObjKey> found;
+        for (auto word : {"", "ante", "abcdef", "abcdefghi", "b", "zzzz"}) {
+            index->find_all(found, StringData(word));
+            CHECK(found.empty());
+        }
+    };
+    check_index();
+
+    // Updates
+    table->get_object(keys[0]).set(col, "Anteater ANTELOPE antelope");
+    table->get_object(keys[1]).set_null(col);
+    table->get_object(keys[2]).set(col, "");
+    table->get_object(keys[3]).set(col, table->get_object(keys[3]).get<String>(col));
+    for (size_t i = 4; i < 400; i += 3) {
+        table->get_object(keys[i]).remove();
+    }
+    check_index();
+
+    // The index is kept when the nullability of the column changes
+    col = table->set_nullability(col, false, false);
+    CHECK(table->has_fulltext_index(col));
+    check_index();
+
+    table->clear();
+    CHECK(table->get_fulltext_index(col)->is_empty());
+
+    table->remove_search_index(col);
+    CHECK(table->has_fulltext_index(col));
+    table->remove_fulltext_index(col);
+    CHECK_NOT(table->has_fulltext_index(col));
+    CHECK_NOT(table->get_fulltext_index(col));
+    table->add_search_index(col);
+    CHECK(table->has_search_index(col));
+}
+
+TEST(StringIndex_Trigram)
+{
+    Group g;
+    auto table = g.add_table("foo");
+    auto col = table->add_column(type_String, "text", true);
+    auto col_int = table->add_column(type_Int, "int");
+
+    std::vector<std::string> parts = {"ab", "Abc", "bcd", "ABCD", "\xC3\xA9t\xC3\xA9", "x"};
+    auto make_text = [&](int i) {
+        std::string text;
+        for (size_t j = 0; j < parts.size(); ++j) {
+            if ((i >> j) % 3 == 0)
+                text += parts[j];
+        }
+        return text;
+    };
+    std::vector<ObjKey> keys;
+    for (int i = 0; i < 300; ++i) {
+        keys.push_back(table->create_object().set(col, make_text(i)).get_key());
+    }
+    // Some objects get their index entries when the index is created, some later
+    table->add_trigram_index(col);
+    for (int i = 300; i < 600; ++i) {
+        keys.push_back(table->create_object().set(col, make_text(i)).get_key());
+    }
+    table->create_object();
+
+    CHECK(table->has_trigram_index(col));
+    CHECK_NOT(table->has_search_index(col));
+    CHECK_NOT(table->has_fulltext_index(col));
+    CHECK_NOT(table->get_search_index(col));
+    CHECK_THROW(table->add_search_index(col), LogicError);
+    CHECK_THROW(table->add_fulltext_index(col), LogicError);
+    CHECK_THROW(table->add_trigram_index(col_int), LogicError);
+
+    auto check_index = [&] {
+        auto index = table->get_trigram_index(col);
+        CHECK(index);
+        index->verify();
+        std::map<std::string, std::vector<ObjKey>> expected;
+        for (auto obj : *table) {
+            for (auto& trigram : tokenize_trigrams(obj.get<StringData>(col)))
+                expected[trigram].push_back(obj.get_key());
+        }
+        CHECK_GREATER(expected.size(), 10);
+        for (auto& entry : expected) {
+            std::vector<ObjKey> found;
+            index->find_all(found, StringData(entry.first));
+            CHECK(found == entry.second);
+            CHECK_EQUAL(index->count(StringData(entry.first)), entry.second.size());
+        }
+        std::vector<ObjKey> found;
+        for (auto trigram : {"", "ab", "Abc", "abcd", "zzz"}) {
+            index->find_all(found, StringData(trigram));
+            CHECK(found.empty());
+        }
+    };
+    check_index();
+
+    // Updates
+    table->get_object(keys[0]).set(col, "ABCABC");
+    table->get_object(keys[1]).set_null(col);
+    table->get_object(keys[2]).set(col, "ab");
+    for (size_t i = 3; i < 200; i += 3) {
+        table->get_object(keys[i]).remove();
+    }
+    check_index();
+
+    // The index is kept when the nullability of the column changes
+    col = table->set_nullability(col, false, false);
+    CHECK(table->has_trigram_index(col));
+    check_index();
+
+    table->remove_trigram_index(col);
+    CHECK_NOT(table->has_trigram_index(col));
+    CHECK_NOT(table->get_trigram_index(col));
+    table->add_fulltext_index(col);
+    CHECK(table->has_fulltext_index(col));
+}
+
 #endif // TEST_INDEX_STRING
@@ -671,3 +671,58 @@ TEST(InstructionReplication_Dictionary)
         CHECK_EQUAL(dict.get("d"), true);
     }
 }
+
+TEST(InstructionReplication_InterleavedTablesAndSchemaChanges)
+{
+    Fixture fixture{test_context};
+    {
+        WriteTransaction wt{fixture.sg_1};
+        TableRef foo = wt.get_group().add_table_with_primary_key("class_foo", type_Int, "pk");
+        TableRef bar = wt.get_group().add_table_with_primary_key("class_bar", type_String, "pk");
+        ColKey foo_i = foo->add_column(type_Int, "i");
+        ColKey foo_list = foo->add_column_list(type_Int, "list");
+        ColKey bar_link = bar->add_column(*foo, "link");
+        ColKey bar_ll = bar->add_column_list(*foo, "ll");
+
+        // Alternate between tables, objects and lists so that consecutive
+        // instructions resolve to different targets.
+        for (int i = 0; i < 20; ++i) {
+            Obj foo_obj = foo->create_object_with_primary_key(i).set(foo_i, i * 10);
+            Obj bar_obj = bar->create_object_with_primary_key(util::format("bar_%1", i % 5));
+            bar_obj.set(bar_link, foo_obj.get_key());
+            bar_obj.get_linklist(bar_ll).add(foo_obj.get_key());
+            foo_obj.get_list<Int>(foo_list).add(i);
+            foo->get_object_with_primary_key(i / 2).get_list<Int>(foo_list).add(i);
+        }
+
+        // Replace a column with a column of a different type under the same name
+        foo->remove_column(foo_i);
+        ColKey foo_s = foo->add_column(type_String, "i");
+        for (int i = 0; i < 20; ++i) {
+            foo->get_object_with_primary_key(i).set(foo_s, util::format("foo_%1", i));
+        }
+
+        // Erase and recreate a table under the same name
+        TableKey baz_key = wt.get_group().add_table_with_primary_key("class_baz", type_Int, "pk")->get_key();
+        wt.get_group().get_table(baz_key)->create_object_with_primary_key(1);
+        wt.get_group().remove_table(baz_key);
+        TableRef baz = wt.get_group().add_table_with_primary_key("class_baz", type_String, "pk");
+        baz->create_object_with_primary_key("one");
+        wt.commit();
+    }
+    fixture.replay_transactions();
+    fixture.check_equal();
+    {
+        ReadTransaction rt{fixture.sg_2};
+        ConstTableRef foo = rt.get_table("class_foo");
+        ConstTableRef baz = rt.get_table("class_baz");
+        CHECK_EQUAL(foo->size(), 20);
+        CHECK_EQUAL(rt.get_table("class_bar")->size(), 5);
+        CHECK_EQUAL(baz->size(), 1);
+        CHECK_EQUAL(baz->get_column_type(baz->get_primary_key_column()), type_String);
+        ColKey foo_s = foo->get_column_key("i");
+        CHECK_EQUAL(foo->get_column_type(foo_s), type_String);
+        CHECK_EQUAL(foo->get_object_with_primary_key(7).get<String>(foo_s), "foo_7");
+        CHECK_EQUAL(foo->get_object_with_primary_key(3).get_list<Int>(foo->get_column_key("list")).size(), 3);
+    }
+}
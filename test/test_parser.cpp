@@ -64,6 +64,7 @@
 #include "test_types_helper.hpp"
 
 #include <chrono>
+#include <map>
 #include <string>
 #include <thread>
 #include <utility>
@@ -5231,4 +5232,203 @@ TEST(Parser_Between)
     CHECK_THROW_ANY(verify_query(test_context, table, "NONE scores between {10, 12}", 1));
 }
 
+TEST(Parser_FullText)
+{
+    Group g;
+    TableRef table = g.add_table("table");
+    auto col_body = table->add_column(type_String, "body");
+    auto col_title = table->add_column(type_String, "title");
+    auto col_id = table->add_column(type_Int, "id");
+    table->create_object().set(col_body, "The quick brown fox").set(col_title, "Fox").set(col_id, 1);
+    table->create_object().set(col_body, "The lazy dog").set(col_title, "Dog").set(col_id, 2);
+    table->create_object().set(col_body, "A quick café stop").set(col_title, "Café").set(col_id, 3);
+
+    CHECK_THROW_EX(verify_query(test_context, table, "body TEXT 'quick'", 2), query_parser::InvalidQueryError,
+                   CHECK(std::string(e.what()).find("full-text index") != std::string::npos));
+    table->add_fulltext_index(col_body);
+
+    verify_query(test_context, table, "body TEXT 'quick'", 2);
+    verify_query(test_context, table, "body text 'QUICK fox'", 1);
+    verify_query(test_context, table, "body TEXT 'quick -fox'", 1);
+    verify_query(test_context, table, "body TEXT 'Cafe'", 1);
+    verify_query(test_context, table, "body TEXT '-the'", 1);
+    verify_query(test_context, table, "body TEXT 'quick' && id > 1", 1);
+    verify_query(test_context, table, "body TEXT 'dog' || body TEXT 'fox'", 2);
+    verify_query(test_context, table, "NOT body TEXT 'the'", 1);
+    verify_query(test_context, table, "body TEXT 'unicorn'", 0);
+
+    CHECK_THROW(verify_query(test_context, table, "body FOO 'quick'", 0), query_parser::SyntaxError);
+    CHECK_THROW(verify_query(test_context, table, "title TEXT 'fox'", 0), query_parser::InvalidQueryError);
+    CHECK_THROW_ANY(verify_query(test_context, table, "id TEXT 'fox'", 0));
+    CHECK_THROW(verify_query(test_context, table, "body TEXT title", 0), query_parser::InvalidQueryError);
+}
+
+TEST(Parser_PreparedQuery)
+{
+    Group g;
+    auto items = g.add_table("class_Item");
+    auto col_item_name = items->add_column(type_String, "name");
+    auto col_price = items->add_column(type_Double, "price");
+    auto people = g.add_table("class_Person");
+    auto col_age = people->add_column(type_Int, "age");
+    auto col_name = people->add_column(type_String, "name");
+    auto col_items = people->add_column_list(*items, "items");
+    auto col_scores = people->add_column_dictionary(type_Int, "scores");
+    auto col_nicknames = people->add_column_list(type_String, "nicknames");
+
+    std::vector<ObjKey> item_keys;
+    for (int i = 0; i < 4; ++i) {
+        auto item = items->create_object().set(col_item_name, "item" + util::to_string(i)).set(col_price, 2.5 * i);
+        item_keys.push_back(item.get_key());
+    }
+    for (int i = 0; i < 10; ++i) {
+        auto obj = people->create_object().set(col_age, i).set(col_name, "person" + util::to_string(i));
+        auto list = obj.get_linklist(col_items);
+        for (int j = 0; j < i % 5; ++j)
+            list.add(item_keys[j]);
+        auto scores = obj.get_dictionary(col_scores);
+        scores.insert("a", i);
+        scores.insert("b", 10 - i);
+        auto nicknames = obj.get_list<String>(col_nicknames);
+        for (int j = 0; j < i % 3; ++j)
+            nicknames.add("nick");
+    }
+    auto count_people = [&](util::FunctionRef<bool(int)> pred) {
+        size_t count = 0;
+        for (int i = 0; i < 10; ++i)
+            count += pred(i);
+        return count;
+    };
+
+    // Only the arguments change between uses of a prepared query
+    auto prepared = query_parser::prepare("age >= $0 && name BEGINSWITH $1");
+    CHECK_EQUAL(prepared.get_query_string(), "age >= $0 && name BEGINSWITH $1");
+    for (int64_t min_age : {0, 1, 3, 10}) {
+        for (std::string prefix : {"person", "person1", "nobody"}) {
+            size_t expected = count_people([&](int i) {
+                return i >= min_age && StringData("person" + util::to_string(i)).begins_with(prefix);
+            });
+            CHECK_EQUAL(people->query(prepared, {min_age, StringData(prefix)}).count(), expected);
+        }
+    }
+
+    // Queries whose parsed form used to be changed when turned into a Query
+    for (int64_t value : {0, 4, 8}) {
+        auto q = query_parser::prepare("scores.@values > $0");
+        CHECK_EQUAL(people->query(q, {value}).count(), count_people([&](int i) {
+            return i > value || 10 - i > value;
+        }));
+        q = query_parser::prepare("SUBQUERY(items, $x, $x.price > $0).@count > 0");
+        CHECK_EQUAL(people->query(q, {2.5 * value / 4}).count(), count_people([&](int i) {
+            return 2.5 * (i % 5 - 1) > 2.5 * value / 4;
+        }));
+        q = query_parser::prepare("scores.@keys == 'a' && nicknames.length == $0");
+        CHECK_EQUAL(people->query(q, {value}).count(), count_people([&](int i) {
+            return value == 4 && i % 3 != 0;
+        }));
+    }
+
+    // The same prepared query on other tables and with other key path mappings
+    auto by_name = query_parser::prepare("name == $0");
+    CHECK_EQUAL(people->query(by_name, {"person3"}).count(), 1);
+    CHECK_EQUAL(items->query(by_name, {"item2"}).count(), 1);
+    auto by_alias = query_parser::prepare("years > $0 && items.@max.cost > $1");
+    CHECK_THROW(people->query(by_alias, {3, 2.0}), query_parser::InvalidQueryError);
+    query_parser::KeyPathMapping mapping;
+    mapping.add_mapping(people, "years", "age");
+    mapping.add_mapping(items, "cost", "price");
+    for (int i = 0; i < 2; ++i) {
+        CHECK_EQUAL(people->query(by_alias, {3, 2.0}, mapping).count(), count_people([&](int j) {
+            return j > 3 && j % 5 >= 2;
+        }));
+    }
+
+    // Sorting and limits are part of the prepared query
+    auto sorted = query_parser::prepare("age < $0 SORT(age DESC) LIMIT(2)");
+    auto tv = people->query(sorted, {5}).find_all();
+    CHECK_EQUAL(tv.size(), 2);
+    CHECK_EQUAL(tv.get_object(0).get<Int>(col_age), 4);
+    CHECK_EQUAL(tv.get_object(1).get<Int>(col_age), 3);
+
+    CHECK_THROW(query_parser::prepare("age >"), query_parser::SyntaxError);
+    CHECK_THROW(query_parser::prepare("age >"), query_parser::SyntaxError);
+
+    // Queries can still be prepared and run without the cache
+    query_parser::set_prepared_query_cache_size(0);
+    CHECK_EQUAL(people->query("age > 4").count(), 5);
+    CHECK_EQUAL(people->query(query_parser::prepare("age > 4")).count(), 5);
+    query_parser::set_prepared_query_cache_size(256);
+}
+
+
+TEST(Parser_GroupBy)
+{
+    Group g;
+    TableRef table = g.add_table("class_Sale");
+    auto col_region = table->add_column(type_String, "region");
+    auto col_amount = table->add_column(type_Int, "amount");
+    auto col_price = table->add_column(type_Double, "price");
+    table->add_column_list(type_String, "tags");
+    for (int i = 0; i < 100; ++i) {
+        table->create_object()
+            .set(col_region, i % 3 ? "north" : "south")
+            .set(col_amount, i)
+            .set(col_price, 0.5 * (i % 10));
+    }
+    auto expected = [&](util::FunctionRef<Mixed(int, Mixed)> fold, bool (*pred)(int)) {
+        std::map<StringData, Mixed> groups;
+        for (int i = 0; i < 100; ++i) {
+            if (pred(i)) {
+                auto& group = groups[i % 3 ? "north" : "south"];
+                group = fold(i, group);
+            }
+        }
+        std::vector<std::pair<Mixed, Mixed>> result;
+        for (auto& [region, aggregate] : groups)
+            result.emplace_back(region, aggregate);
+        return result;
+    };
+    auto check = [&](const std::string& query_string, std::vector<std::pair<Mixed, Mixed>> expect) {
+        auto actual = table->aggregate_groups(query_string);
+        CHECK_EQUAL(actual.size(), expect.size());
+        for (size_t i = 0; i < std::min(actual.size(), expect.size()); ++i) {
+            CHECK_EQUAL(actual[i].first, expect[i].first);
+            CHECK_EQUAL(actual[i].second, expect[i].second);
+        }
+    };
+    auto all = [](int) {
+        return true;
+    };
+    auto small = [](int i) {
+        return i < 50;
+    };
+
+    check("TRUEPREDICATE GROUP BY(region, @count)", expected([](int, Mixed n) {
+              return Mixed(n.is_null() ? 1 : n.get_int() + 1);
+          }, all));
+    check("amount < 50 group by(region, @sum(amount))", expected([](int i, Mixed sum) {
+              return Mixed((sum.is_null() ? 0 : sum.get_int()) + i);
+          }, small));
+    check("amount < 50 GROUP BY(region, @max(amount))", expected([](int i, Mixed) {
+              return Mixed(int64_t(i));
+          }, small));
+    check("amount < 9 GROUP BY(region, @max(price))", {{"north", 4.0}, {"south", 3.0}});
+    check("amount > 0 GROUP BY(region, @min(price))", {{"north", 0.0}, {"south", 0.0}});
+    check("amount == 0 || amount == 3 GROUP BY(region, @avg(price))", {{"south", 0.75}});
+    check("amount > 1000 GROUP BY(region, @count)", {});
+
+    CHECK_THROW(table->aggregate_groups("TRUEPREDICATE"), query_parser::InvalidQueryError);
+    CHECK_THROW(table->query("TRUEPREDICATE GROUP BY(region, @count)"), query_parser::InvalidQueryError);
+    CHECK_THROW(table->aggregate_groups("TRUEPREDICATE SORT(amount ASC) GROUP BY(region, @count)"),
+                query_parser::InvalidQueryError);
+    CHECK_THROW(table->aggregate_groups("TRUEPREDICATE GROUP BY(nothing, @count)"),
+                query_parser::InvalidQueryError);
+    CHECK_THROW(table->aggregate_groups("TRUEPREDICATE GROUP BY(tags, @count)"), query_parser::InvalidQueryError);
+    CHECK_THROW(table->aggregate_groups("TRUEPREDICATE GROUP BY(region, @sum(region))"),
+                query_parser::InvalidQueryError);
+    CHECK_THROW(table->aggregate_groups("TRUEPREDICATE GROUP BY(region, @size)"), query_parser::SyntaxError);
+    CHECK_THROW(table->aggregate_groups("TRUEPREDICATE GROUP(region, @count)"), query_parser::SyntaxError);
+    CHECK_THROW(table->aggregate_groups("TRUEPREDICATE ORDER BY(region, @count)"), query_parser::SyntaxError);
+}
+
 #endif // TEST_PARSER
@@ -0,0 +1,69 @@
+#include "realm/sync/noinst/client_history_impl.hpp"
+#include "realm/sync/noinst/pending_bootstrap_store.hpp"
+
+#include "test.hpp"
+#include "util/test_path.hpp"
+
+namespace realm::sync {
+
+TEST(Sync_PendingBootstrapStoreBatching)
+{
+    SHARED_GROUP_TEST_PATH(db_path);
+    auto db = DB::create(make_client_replication(), db_path);
+    PendingBootstrapStore store(db, &test_context.logger);
+
+    SyncProgress progress;
+    progress.download.server_version = 10;
+    progress.latest_server_version.version = 10;
+
+    std::vector<std::string> payloads;
+    std::vector<Transformer::RemoteChangeset> changesets;
+    for (size_t i = 0; i < 5; ++i) {
+        payloads.emplace_back(100, char('a' + i));
+    }
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        Transformer::RemoteChangeset changeset;
+        changeset.remote_version = i + 1;
+        changeset.original_changeset_size = payloads[i].size();
+        changeset.data = BinaryData(payloads[i].data(), payloads[i].size());
+        changesets.push_back(changeset);
+    }
+    store.add_batch(1, util::none, {changesets[0], changesets[1]});
+    store.add_batch(1, progress, {changesets[2], changesets[3], changesets[4]});
+    CHECK(store.has_pending());
+
+    // Batches are cut once the limit has been reached, but always contain at least one changeset.
+    auto batch = store.peek_pending(150);
+    CHECK_EQUAL(batch.query_version, 1);
+    CHECK(batch.progress);
+    CHECK_EQUAL(batch.changesets.size(), 2);
+    CHECK_EQUAL(batch.remaining, 3);
+    CHECK_EQUAL(batch.changesets[0].remote_version, 1);
+    CHECK_EQUAL(batch.changesets[1].data.get_first_chunk(), BinaryData(payloads[1].data(), payloads[1].size()));
+
+    {
+        auto tr = db->start_write();
+        store.pop_front_pending(tr, batch.changesets.size());
+        tr->commit();
+    }
+    CHECK(store.has_pending());
+
+    batch = store.peek_pending(1);
+    CHECK_EQUAL(batch.changesets.size(), 1);
+    CHECK_EQUAL(batch.remaining, 2);
+    CHECK_EQUAL(batch.changesets[0].remote_version, 3);
+
+    batch = store.peek_pending(1024 * 1024);
+    CHECK_EQUAL(batch.changesets.size(), 3);
+    CHECK_EQUAL(batch.remaining, 0);
+    CHECK_EQUAL(batch.changesets[2].data.get_first_chunk(), BinaryData(payloads[4].data(), payloads[4].size()));
+
+    {
+        auto tr = db->start_write();
+        store.pop_front_pending(tr, batch.changesets.size());
+        tr->commit();
+    }
+    CHECK_NOT(store.has_pending());
+}
+
+} // namespace realm::sync
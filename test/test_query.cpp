@@ -5605,4 +5605,174 @@ TEST(Query_AsymmetricObjects)
                       LogicError::wrong_kind_of_table);
 }
 
+TEST(Query_FullText)
+{
+    Group g;
+    TableRef table = g.add_table("table");
+    auto col_text = table->add_column(type_String, "text", true);
+    auto col_int = table->add_column(type_Int, "int");
+
+    std::vector<std::string> words = {"alpha", "beta", "gamma", "delta", "Épsilon", "zeta"};
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    for (int i = 0; i < 3000; ++i) {
+        std::string text;
+        for (int j = 0; j < 3; ++j) {
+            text += words[random.draw_int_mod(words.size())] + (j % 2 ? ". " : " ");
+        }
+        auto obj = table->create_object().set(col_int, i % 10);
+        if (i % 100 != 0)
+            obj.set(col_text, text);
+    }
+
+    CHECK_LOGIC_ERROR(table->where().fulltext(col_text, "alpha"), LogicError::no_search_index);
+    table->add_fulltext_index(col_text);
+
+    // Checks the query against the expected matches found by looking at every object
+    auto check = [&](Query q, const std::vector<std::string>& required, const std::vector<std::string>& excluded,
+                     int int_value = -1) {
+        std::vector<ObjKey> expected;
+        for (auto obj : *table) {
+            auto text = tokenize_text(obj.get<StringData>(col_text));
+            bool match = int_value < 0 || obj.get<Int>(col_int) == int_value;
+            for (auto& word : required)
+                match = match && text.count(word);
+            for (auto& word : excluded)
+                match = match && !text.count(word);
+            if (match)
+                expected.push_back(obj.get_key());
+        }
+        CHECK_EQUAL(q.count(), expected.size());
+        auto tv = q.find_all();
+        CHECK_EQUAL(tv.size(), expected.size());
+        for (size_t i = 0; i < tv.size() && i < expected.size(); ++i)
+            CHECK_EQUAL(tv.get_key(i), expected[i]);
+        CHECK_EQUAL(q.sum_int(col_int), [&] {
+            int64_t sum = 0;
+            for (auto key : expected)
+                sum += table->get_object(key).get<Int>(col_int);
+            return sum;
+        }());
+    };
+
+    check(table->where().fulltext(col_text, "alpha"), {"alpha"}, {});
+    check(table->where().fulltext(col_text, "ALPHA beta"), {"alpha", "beta"}, {});
+    check(table->where().fulltext(col_text, "alpha beta epsilon"), {"alpha", "beta", "epsilon"}, {});
+    check(table->where().fulltext(col_text, "alpha -beta"), {"alpha"}, {"beta"});
+    check(table->where().fulltext(col_text, "-gamma -épsilon"), {}, {"gamma", "epsilon"});
+    check(table->where().fulltext(col_text, "alpha omega"), {"alpha", "omega"}, {});
+    check(table->where().fulltext(col_text, "delta").equal(col_int, 3), {"delta"}, {}, 3);
+    check(table->where().equal(col_int, 3).fulltext(col_text, "delta -zeta"), {"delta"}, {"zeta"}, 3);
+
+    // Combined with other conditions in groups
+    auto q = table->where().group().fulltext(col_text, "zeta").Or().fulltext(col_text, "beta").end_group();
+    CHECK_EQUAL(q.count(), table->where().fulltext(col_text, "zeta").count() +
+                               table->where().fulltext(col_text, "beta -zeta").count());
+    CHECK_EQUAL(table->where().Not().fulltext(col_text, "zeta").count(),
+                table->size() - table->where().fulltext(col_text, "zeta").count());
+    CHECK_EQUAL(table->where().fulltext(col_text, "zeta").get_description(), "text TEXT \"zeta\"");
+
+    // The index follows changes to the objects
+    for (auto obj : *table) {
+        if (obj.get<Int>(col_int) == 5)
+            obj.set(col_text, "alpha and omega");
+    }
+    table->where().equal(col_int, 6).find_all().clear();
+    check(table->where().fulltext(col_text, "alpha"), {"alpha"}, {});
+    check(table->where().fulltext(col_text, "omega -beta"), {"omega"}, {"beta"});
+}
+
+TEST(Query_Trigram)
+{
+    Group g;
+    TableRef table = g.add_table("table");
+    auto col_plain = table->add_column(type_String, "plain", true);
+    auto col_text = table->add_column(type_String, "text", true);
+    auto col_int = table->add_column(type_Int, "int");
+
+    std::vector<std::string> parts = {"Foo", "bar", "BAZ", "quux", "Ærø", "straße", "ÉCOLE", "日本語", "-", " "};
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    auto set_random_text = [&](Obj obj) {
+        std::string text;
+        for (size_t n = random.draw_int_mod(6); n > 0; --n)
+            text += parts[random.draw_int_mod(parts.size())];
+        obj.set(col_plain, text).set(col_text, text);
+    };
+    for (int i = 0; i < 2000; ++i) {
+        auto obj = table->create_object().set(col_int, i % 10);
+        if (i % 100 != 0)
+            set_random_text(obj);
+    }
+    table->add_trigram_index(col_text);
+
+    // The text column has the same values as the plain one, so the queries must
+    // give the same results with and without the index
+    auto check = [&](util::FunctionRef<Query(ColKey)> make_query) {
+        Query expected = make_query(col_plain);
+        Query q = make_query(col_text);
+        CHECK_EQUAL(q.count(), expected.count());
+        auto tv = q.find_all();
+        auto expected_tv = expected.find_all();
+        CHECK_EQUAL(tv.size(), expected_tv.size());
+        for (size_t i = 0; i < tv.size() && i < expected_tv.size(); ++i)
+            CHECK_EQUAL(tv.get_key(i), expected_tv.get_key(i));
+        CHECK_EQUAL(q.sum_int(col_int), expected.sum_int(col_int));
+    };
+    auto check_all = [&] {
+        for (const char* needle : {"foo", "Foo", "FOO", "oobar", "rba", "ba", "z", "", "quuxquux", "ærø", "ÆRØ",
+                                   "aße", "AßE", "cole", "Écol", "本語", "語Foo", "o-b", "nothing"}) {
+            StringData str(needle);
+            check([&](ColKey col) {
+                return table->where().contains(col, str);
+            });
+            check([&](ColKey col) {
+                return table->where().contains(col, str, false);
+            });
+        }
+        for (const char* pattern : {"*foo*", "Foo*", "*bar?baz*", "*BAR?BAZ*", "*quux", "*ÆRØ*", "?oo*ba*", "*",
+                                    "*日本*Foo*", "foo", "*ß*", "***"}) {
+            StringData str(pattern);
+            check([&](ColKey col) {
+                return table->where().like(col, str);
+            });
+            check([&](ColKey col) {
+                return table->where().like(col, str, false);
+            });
+        }
+
+        // Combined with other conditions
+        check([&](ColKey col) {
+            return table->where().contains(col, StringData("bar")).equal(col_int, 3);
+        });
+        check([&](ColKey col) {
+            return table->where().equal(col_int, 3).contains(col, StringData("Bar"), false);
+        });
+        check([&](ColKey col) {
+            return table->where().Not().contains(col, StringData("bar"));
+        });
+        check([&](ColKey col) {
+            return table->where()
+                .group()
+                .contains(col, StringData("foo"))
+                .Or()
+                .like(col, StringData("*quux*"), false)
+                .end_group();
+        });
+        check([&](ColKey col) {
+            return table->where().contains(col, StringData("foo")).contains(col, StringData("baz"), false);
+        });
+    };
+    check_all();
+
+    // The index follows changes to the objects
+    for (auto obj : *table) {
+        if (obj.get<Int>(col_int) == 5)
+            set_random_text(obj);
+    }
+    table->where().equal(col_int, 6).find_all().clear();
+    check_all();
+
+    table->remove_trigram_index(col_text);
+    check_all();
+}
+
 #endif // TEST_QUERY
@@ -22,6 +22,7 @@
 #include <cstdlib> // itoa()
 #include <initializer_list>
 #include <limits>
+#include <map>
 #include <vector>
 #include <chrono>
 
@@ -5905,4 +5906,307 @@ TEST(Query_links_to_with_bpnode_split)
     }
 }
 
+TEST(Query_LinkSemiJoin)
+{
+    Group g;
+    auto a = g.add_table("class_A");
+    auto b = g.add_table("class_B");
+    auto c = g.add_table("class_C");
+    auto col_a = a->add_column(type_Int, "a");
+    auto col_bs = a->add_column_list(*b, "bs");
+    auto col_name = b->add_column(type_String, "name");
+    auto col_c = b->add_column(*c, "c");
+    auto col_value = c->add_column(type_Int, "value", true);
+    auto col_s = c->add_column(type_String, "s");
+
+    std::vector<ObjKey> a_keys, b_keys, c_keys;
+    c->create_objects(100, c_keys);
+    b->create_objects(300, b_keys);
+    a->create_objects(500, a_keys);
+    for (int i = 0; i < 100; i++) {
+        auto obj = c->get_object(c_keys[i]);
+        if (i % 10)
+            obj.set(col_value, i);
+        obj.set(col_s, "s" + util::to_string(i));
+    }
+    for (int i = 0; i < 300; i++) {
+        auto obj = b->get_object(b_keys[i]);
+        obj.set(col_name, "b" + util::to_string(i % 20));
+        if (i % 7)
+            obj.set(col_c, c_keys[(i * 13) % 100]);
+    }
+    for (int i = 0; i < 500; i++) {
+        auto obj = a->get_object(a_keys[i]);
+        obj.set(col_a, i % 10);
+        auto bs = obj.get_linklist(col_bs);
+        for (int j = 0; j < i % 4; j++)
+            bs.add(b_keys[(i * 7 + j * 31) % 300]);
+    }
+
+    // Brute force evaluation of conditions on the C objects reachable from an A or B object
+    using Condition = util::FunctionRef<bool(const Obj&)>;
+    auto b_matches = [&](ObjKey key, Condition cond) {
+        ObjKey c_key = b->get_object(key).get<ObjKey>(col_c);
+        return c_key && cond(c->get_object(c_key));
+    };
+    auto count_a = [&](Condition cond) {
+        size_t n = 0;
+        for (auto& obj : *a) {
+            auto bs = obj.get_linklist(col_bs);
+            bool match = false;
+            for (size_t i = 0; i < bs.size() && !match; i++)
+                match = b_matches(bs.get(i), cond);
+            n += match;
+        }
+        return n;
+    };
+    auto count_b = [&](Condition cond) {
+        size_t n = 0;
+        for (auto& obj : *b)
+            n += b_matches(obj.get_key(), cond);
+        return n;
+    };
+    auto value_above_50 = [&](const Obj& obj) {
+        auto value = obj.get<util::Optional<Int>>(col_value);
+        return value && *value > 50;
+    };
+
+    Query q = a->link(col_bs).link(col_c).column<Int>(col_value) > 50;
+    size_t expected = count_a(value_above_50);
+    CHECK_NOT_EQUAL(expected, 0);
+    CHECK_EQUAL(q.count(), expected);
+    CHECK_EQUAL(q.find_all().size(), expected);
+    CHECK_EQUAL((!q).count(), a->size() - expected);
+    CHECK_EQUAL(a->query("bs.c.value > 50").count(), expected);
+    size_t expected_and = 0;
+    TableView tv = q.find_all();
+    for (size_t i = 0; i < tv.size(); i++)
+        expected_and += (tv.get_object(i).get<Int>(col_a) == 3);
+    CHECK_EQUAL((a->where().equal(col_a, 3).and_query(q)).count(), expected_and);
+
+    // The result follows changes to any of the tables
+    c->get_object(c_keys[11]).set(col_value, 99);
+    b->get_object(b_keys[5]).set(col_c, c_keys[99]);
+    a->get_object(a_keys[0]).get_linklist(col_bs).add(b_keys[5]);
+    expected = count_a(value_above_50);
+    CHECK_EQUAL(q.count(), expected);
+    CHECK_EQUAL(q.find_all().find_by_source_ndx(a_keys[0]), 0);
+
+    // Writing only to the target or to an intermediate table
+    c->get_object(c_keys[21]).set(col_value, 98);
+    CHECK_NOT_EQUAL(count_a(value_above_50), expected);
+    expected = count_a(value_above_50);
+    CHECK_EQUAL(q.count(), expected);
+    b->get_object(b_keys[1]).set(col_c, c_keys[99]);
+    CHECK_NOT_EQUAL(count_a(value_above_50), expected);
+    expected = count_a(value_above_50);
+    CHECK_EQUAL(q.count(), expected);
+
+    Query q_str = a->link(col_bs).link(col_c).column<String>(col_s).contains("7");
+    CHECK_EQUAL(q_str.count(), count_a([&](const Obj& obj) {
+                    return obj.get<String>(col_s).contains("7");
+                }));
+
+    // Single links: a broken link compares as null
+    CHECK_EQUAL((b->link(col_c).column<Int>(col_value) < 10).count(), count_b([&](const Obj& obj) {
+                    auto value = obj.get<util::Optional<Int>>(col_value);
+                    return value && *value < 10;
+                }));
+    CHECK_EQUAL((b->link(col_c).column<Int>(col_value) != 5).count(), b->size() - count_b([&](const Obj& obj) {
+                                                                          return obj.get_any(col_value) == Mixed(5);
+                                                                      }));
+    CHECK_EQUAL(b->query("c.value == NULL").count(), b->size() - count_b([&](const Obj& obj) {
+                                                          return !obj.is_null(col_value);
+                                                      }));
+
+    // Backlinks, across three tables
+    Query q_back = c->backlink(*b, col_c).backlink(*a, col_bs).column<Int>(col_a) == 7;
+    size_t expected_back = 0;
+    for (auto& obj : *c) {
+        bool match = false;
+        for (size_t i = 0; i < obj.get_backlink_count(*b, col_c); i++) {
+            Obj b_obj = b->get_object(obj.get_backlink(*b, col_c, i));
+            for (size_t j = 0; j < b_obj.get_backlink_count(*a, col_bs); j++) {
+                if (a->get_object(b_obj.get_backlink(*a, col_bs, j)).get<Int>(col_a) == 7)
+                    match = true;
+            }
+        }
+        expected_back += match;
+    }
+    CHECK_NOT_EQUAL(expected_back, 0);
+    CHECK_EQUAL(q_back.count(), expected_back);
+    CHECK_EQUAL(c->query("@links.class_B.c.@links.class_A.bs.a == 7").count(), expected_back);
+
+    // In a subquery
+    size_t expected_sub = 0;
+    for (auto& obj : *a) {
+        auto bs = obj.get_linklist(col_bs);
+        size_t n = 0;
+        for (size_t i = 0; i < bs.size(); i++) {
+            n += b_matches(bs.get(i), [&](const Obj& obj) {
+                auto value = obj.get<util::Optional<Int>>(col_value);
+                return value && *value >= 90;
+            });
+        }
+        expected_sub += (n >= 2);
+    }
+    CHECK_EQUAL(a->query("SUBQUERY(bs, $x, $x.c.value >= 90).@count >= 2").count(), expected_sub);
+}
+
+
+TEST(Query_GroupBy)
+{
+    Table table;
+    auto col_kind = table.add_column(type_Int, "kind");
+    auto col_category = table.add_column(type_String, "category", true);
+    auto col_value = table.add_column(type_Int, "value", true);
+    auto col_price = table.add_column(type_Double, "price");
+    auto col_created = table.add_column(type_Timestamp, "created");
+    table.add_search_index(col_kind);
+
+    for (int i = 0; i < 3000; i++) {
+        auto obj = table.create_object().set(col_kind, i % 7).set(col_price, (i % 101) * 0.25);
+        if (i % 13)
+            obj.set(col_category, "cat" + util::to_string(i % 11));
+        if (i % 5)
+            obj.set(col_value, i % 37 - 10);
+        obj.set(col_created, Timestamp(i % 97, 0));
+    }
+
+    // The aggregate of each group computed object by object
+    auto expected = [&](util::FunctionRef<bool(const Obj&)> pred, ColKey group_col, Action action,
+                        ColKey value_col) {
+        std::map<Mixed, std::vector<Mixed>> groups;
+        for (auto obj : table) {
+            if (pred(obj))
+                groups[obj.get_any(group_col)].push_back(value_col ? obj.get_any(value_col) : Mixed());
+        }
+        std::vector<std::pair<Mixed, Mixed>> result;
+        for (auto& [group, values] : groups) {
+            Mixed aggregate;
+            std::vector<Mixed> non_null;
+            for (auto& value : values) {
+                if (!value.is_null())
+                    non_null.push_back(value);
+            }
+            if (action == act_Count) {
+                aggregate = Mixed(int64_t(values.size()));
+            }
+            else if (action == act_Sum || action == act_Average) {
+                int64_t int_sum = 0;
+                double double_sum = 0;
+                for (auto& value : non_null) {
+                    if (value.is_type(type_Int))
+                        int_sum += value.get_int();
+                    else
+                        double_sum += value.get_double();
+                }
+                bool is_int = value_col.get_type() == col_type_Int;
+                if (action == act_Sum)
+                    aggregate = is_int ? Mixed(int_sum) : Mixed(double_sum);
+                else if (!non_null.empty())
+                    aggregate = Mixed((is_int ? double(int_sum) : double_sum) / non_null.size());
+            }
+            else if (!non_null.empty()) {
+                aggregate = action == act_Min ? *std::min_element(non_null.begin(), non_null.end())
+                                              : *std::max_element(non_null.begin(), non_null.end());
+            }
+            result.emplace_back(group, aggregate);
+        }
+        return result;
+    };
+    auto check = [&](const std::vector<std::pair<Mixed, Mixed>>& actual,
+                     const std::vector<std::pair<Mixed, Mixed>>& expect) {
+        CHECK_EQUAL(actual.size(), expect.size());
+        for (size_t i = 0; i < std::min(actual.size(), expect.size()); i++) {
+            CHECK_EQUAL(actual[i].first, expect[i].first);
+            if (expect[i].second.is_type(type_Double))
+                CHECK_APPROXIMATELY_EQUAL(actual[i].second.get_double(), expect[i].second.get_double(), 1e-9);
+            else
+                CHECK_EQUAL(actual[i].second, expect[i].second);
+        }
+    };
+
+    struct Case {
+        Action action;
+        ColKey value_col;
+    };
+    std::vector<Case> cases = {{act_Count, {}},          {act_Sum, col_value},     {act_Sum, col_price},
+                               {act_Average, col_value}, {act_Average, col_price}, {act_Min, col_value},
+                               {act_Max, col_price},     {act_Min, col_created},   {act_Max, col_category}};
+    for (auto& c : cases) {
+        // No conditions, a condition scanned in the clusters, one found through the search index, and a view
+        check(table.where().group_by(col_category).aggregate(c.action, c.value_col),
+              expected([](const Obj&) { return true; }, col_category, c.action, c.value_col));
+        check(table.where().greater(col_price, 10.0).group_by(col_category).aggregate(c.action, c.value_col),
+              expected([&](const Obj& obj) { return obj.get<double>(col_price) > 10.0; }, col_category, c.action,
+                       c.value_col));
+        check(table.where().equal(col_kind, 3).less(col_price, 20.0).group_by(col_value).aggregate(c.action,
+                                                                                                  c.value_col),
+              expected([&](const Obj& obj) { return obj.get<Int>(col_kind) == 3 && obj.get<double>(col_price) < 20.0; },
+                       col_value, c.action, c.value_col));
+        auto tv = table.where().less(col_kind, 2).find_all();
+        check(table.where(&tv).group_by(col_kind).aggregate(c.action, c.value_col),
+              expected([&](const Obj& obj) { return obj.get<Int>(col_kind) < 2; }, col_kind, c.action, c.value_col));
+        check(table.where(&tv).greater(col_price, 10.0).group_by(col_kind).aggregate(c.action, c.value_col),
+              expected([&](const Obj& obj) { return obj.get<Int>(col_kind) < 2 && obj.get<double>(col_price) > 10.0; },
+                       col_kind, c.action, c.value_col));
+    }
+
+    // Groups with no matching objects are not reported
+    CHECK(table.where().equal(col_kind, 100).group_by(col_category).aggregate(act_Count).empty());
+
+    CHECK_THROW(table.where().group_by(col_category).aggregate(act_Sum, col_category), LogicError);
+    CHECK_THROW(table.where().group_by(col_category).aggregate(act_Sum), LogicError);
+    CHECK_THROW(table.where().group_by(ColKey()), LogicError);
+}
+
+TEST(Query_GroupBy_Types)
+{
+    Group g;
+    auto target = g.add_table_with_primary_key("class_Target", type_Int, "id");
+    auto origin = g.add_table("class_Origin");
+    auto col_decimal = origin->add_column(type_Decimal, "decimal");
+    auto col_link = origin->add_column(*target, "link");
+    auto col_mixed = origin->add_column(type_Mixed, "mixed", true);
+    auto col_value = origin->add_column(type_Int, "value");
+
+    auto t0 = target->create_object_with_primary_key(0).get_key();
+    auto t1 = target->create_object_with_primary_key(1).get_key();
+    std::vector<Mixed> mixed_values = {Mixed(1), Mixed(1.0), Mixed("a"), Mixed(Decimal128(1)), Mixed(), Mixed(2.5f)};
+    for (int i = 0; i < 12; i++) {
+        auto obj = origin->create_object().set(col_decimal, Decimal128(i % 3)).set(col_value, i);
+        obj.set(col_mixed, mixed_values[i % mixed_values.size()]);
+        if (i % 4)
+            obj.set(col_link, i % 2 ? t0 : t1);
+    }
+
+    // Both when reading the groups from the leaves and from the objects of a view
+    auto check = [&](ColKey group_col, Action action, const std::vector<std::pair<Mixed, Mixed>>& expected) {
+        auto tv = origin->where().find_all();
+        for (auto& actual : {origin->where().group_by(group_col).aggregate(action, col_value),
+                             origin->where(&tv).group_by(group_col).aggregate(action, col_value)}) {
+            CHECK_EQUAL(actual.size(), expected.size());
+            for (size_t i = 0; i < std::min(actual.size(), expected.size()); i++) {
+                CHECK_EQUAL(actual[i].first, expected[i].first);
+                CHECK_EQUAL(actual[i].second, expected[i].second);
+            }
+        }
+    };
+
+    check(col_decimal, act_Count, {{Decimal128(0), 4}, {Decimal128(1), 4}, {Decimal128(2), 4}});
+    std::vector<std::pair<Mixed, Mixed>> link_groups = {{Mixed(), 3}, {t0, 6}, {t1, 3}};
+    std::sort(link_groups.begin(), link_groups.end());
+    check(col_link, act_Count, link_groups);
+    // Values that compare equal form one group
+    check(col_mixed, act_Count, {{Mixed(), 2}, {1, 6}, {2.5f, 2}, {"a", 2}});
+    check(col_mixed, act_Sum, {{Mixed(), 4 + 10}, {1, 0 + 1 + 3 + 6 + 7 + 9}, {2.5f, 5 + 11}, {"a", 2 + 8}});
+
+    // A link to a deleted object is null
+    target->invalidate_object(t1);
+    check(col_link, act_Count, {{Mixed(), 6}, {t0, 6}});
+
+    CHECK_THROW(target->where().group_by(target->get_opposite_column(col_link)), LogicError);
+}
+
 #endif // TEST_QUERY
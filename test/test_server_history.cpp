@@ -1,4 +1,7 @@
 #include <realm/sync/noinst/server/server_history.hpp>
+#include <realm/sync/noinst/server/server_file_access_cache.hpp>
+
+#include <numeric>
 
 #include "test.hpp"
 
@@ -51,6 +54,39 @@ private:
 };
 
 
+class CompactingHistoryContext : public HistoryContext {
+public:
+    CompactingHistoryContext(std::chrono::milliseconds time_budget, std::size_t history_block_size = 0)
+        : m_time_budget{time_budget}
+        , m_history_block_size{history_block_size}
+    {
+    }
+
+    bool get_compaction_params(bool& ignore_clients, std::chrono::seconds& time_to_live,
+                               std::chrono::seconds& compaction_interval) noexcept override final
+    {
+        ignore_clients = false;
+        time_to_live = std::chrono::seconds::max();
+        compaction_interval = std::chrono::seconds{0};
+        return true;
+    }
+
+    std::chrono::milliseconds get_compaction_time_budget() const noexcept override final
+    {
+        return m_time_budget;
+    }
+
+    std::size_t get_history_block_size() const noexcept override final
+    {
+        return m_history_block_size;
+    }
+
+private:
+    const std::chrono::milliseconds m_time_budget;
+    const std::size_t m_history_block_size;
+};
+
+
 TEST(ServerHistory_Verify)
 {
     SHARED_GROUP_TEST_PATH(path);
@@ -82,4 +118,222 @@ TEST(ServerHistory_Verify)
     }
 }
 
+
+TEST(ServerFileAccessCache_SizeLimitAndPrefetch)
+{
+    SHARED_GROUP_TEST_PATH(path_1);
+    SHARED_GROUP_TEST_PATH(path_2);
+    SHARED_GROUP_TEST_PATH(path_3);
+    std::string paths[] = {path_1, path_2, path_3};
+    HistoryContext context;
+    ServerHistory::DummyCompactionControl compaction_control;
+    std::size_t file_size = 0;
+    for (const std::string& path : paths) {
+        ServerHistory history{context, compaction_control};
+        DBRef sg = DB::create(history, path);
+        WriteTransaction wt{sg};
+        TableRef table = wt.add_table("class_table");
+        ColKey col = table->add_column(type_String, "str");
+        for (int i = 0; i < 1000; ++i)
+            table->create_object().set(col, StringData(std::string(100, 'x')));
+        wt.commit();
+        sg->close();
+        file_size = std::max(file_size, std::size_t(util::File::get_size_static(path)));
+    }
+
+    // Room for two files
+    ServerFileAccessCache cache{10, test_context.logger, context, util::none, file_size * 5 / 2, 2};
+    {
+        std::vector<std::unique_ptr<ServerFileAccessCache::Slot>> slots;
+        for (const std::string& path : paths) {
+            slots.push_back(std::make_unique<ServerFileAccessCache::Slot>(cache, path, path, compaction_control,
+                                                                          true, false));
+        }
+        auto check_file = [&](int i) {
+            ReadTransaction rt{slots[i]->access().shared_group};
+            CHECK_EQUAL(rt.get_table("class_table")->size(), 1000);
+        };
+
+        check_file(0);
+        check_file(1);
+        CHECK(slots[0]->is_open());
+        CHECK(slots[1]->is_open());
+        check_file(2);
+        CHECK_NOT(slots[0]->is_open());
+        CHECK(slots[1]->is_open());
+        CHECK(slots[2]->is_open());
+
+        // A prefetched file counts against the limits, so there is no room
+        // for prefetching the first file until another one is closed
+        slots[0]->prefetch();
+        CHECK_NOT(slots[0]->is_prefetching());
+        slots[1]->close();
+
+        // The first file is being closed in the background, and must be
+        // closed before it can be opened again, as it holds the sync agent.
+        slots[0]->prefetch();
+        CHECK(slots[0]->is_prefetching());
+        CHECK_NOT(slots[0]->is_open());
+        check_file(0);
+        CHECK(slots[0]->is_open());
+        CHECK_NOT(slots[0]->is_prefetching());
+        CHECK(slots[2]->is_open());
+
+        // Prefetching a file that is open has no effect, and a prefetched
+        // file that is never accessed is closed with its slot
+        slots[2]->prefetch();
+        CHECK_NOT(slots[2]->is_prefetching());
+        slots[2]->close();
+        slots[1]->prefetch();
+        CHECK(slots[1]->is_prefetching());
+        check_file(0);
+        CHECK_NOT(slots[1]->is_open());
+    }
+}
+
+
+TEST(ServerHistory_IncrementalCompaction)
+{
+    SHARED_GROUP_TEST_PATH(path_1);
+    SHARED_GROUP_TEST_PATH(path_2);
+    util::Logger& logger = test_context.logger;
+
+    auto test = [&](const std::string& path, std::chrono::milliseconds time_budget) {
+        CompactingHistoryContext context{time_budget};
+        ServerHistory::DummyCompactionControl compaction_control;
+        ServerHistory history{context, compaction_control};
+        DBRef sg = DB::create(history, path);
+        {
+            WriteTransaction wt{sg};
+            TableRef table = wt.get_group().add_table_with_primary_key("class_table", type_Int, "pk");
+            table->add_column(type_Int, "value");
+            wt.commit();
+        }
+        const int num_objects = 100;
+        for (int i = 0; i < num_objects; ++i) {
+            WriteTransaction wt{sg};
+            TableRef table = wt.get_table("class_table");
+            if (i > 0)
+                table->get_object_with_primary_key(i - 1).remove();
+            table->create_object_with_primary_key(i).set("value", i);
+            wt.commit();
+        }
+        CHECK_EQUAL(history.get_compacted_until_version(), 0);
+
+        // Each pass continues from where the previous one stopped
+        sync::version_type prev_compacted_until_version = 0;
+        std::size_t num_passes = 0;
+        bool more = true;
+        while (more) {
+            more = history.compact_history_incrementally(time_budget, logger);
+            sync::version_type compacted_until_version = history.get_compacted_until_version();
+            CHECK_GREATER(compacted_until_version, prev_compacted_until_version);
+            prev_compacted_until_version = compacted_until_version;
+            ++num_passes;
+        }
+        ServerHistory::HistoryContents contents = history.get_history_contents();
+        CHECK_EQUAL(prev_compacted_until_version, contents.sync_history.size());
+        CHECK_EQUAL(contents.sync_history.back().cumul_byte_size,
+                    std::accumulate(contents.sync_history.begin(), contents.sync_history.end(), std::uint_fast64_t(0),
+                                    [](std::uint_fast64_t size, const ServerHistory::HistoryContents::HistoryEntry& e) {
+                                        return size + e.changeset.size();
+                                    }));
+
+        // Nothing more to compact
+        CHECK_NOT(history.compact_history_incrementally(time_budget, logger));
+        CHECK_EQUAL(history.get_compacted_until_version(), prev_compacted_until_version);
+        {
+            ReadTransaction rt{sg};
+            rt.get_group().verify();
+            ConstTableRef table = rt.get_table("class_table");
+            CHECK_EQUAL(table->size(), 1);
+            CHECK_EQUAL(table->get_object_with_primary_key(num_objects - 1).get<Int>("value"), num_objects - 1);
+        }
+        return num_passes;
+    };
+
+    // A pass with a tiny budget may compact as little as a single history
+    // entry, but with a generous budget, a single pass does it all
+    test(path_1, std::chrono::milliseconds{1});
+    CHECK_EQUAL(test(path_2, std::chrono::hours{1}), 1);
+}
+
+
+TEST(ServerHistory_SealedHistoryBlocks)
+{
+    SHARED_GROUP_TEST_PATH(path_1);
+    SHARED_GROUP_TEST_PATH(path_2);
+    util::Logger& logger = test_context.logger;
+    const std::chrono::milliseconds time_budget = std::chrono::hours{1};
+    const std::size_t history_block_size = 10;
+
+    auto populate_and_compact = [&](DBRef sg, ServerHistory& history) {
+        {
+            WriteTransaction wt{sg};
+            TableRef table = wt.get_group().add_table_with_primary_key("class_table", type_Int, "pk");
+            table->add_column(type_String, "value");
+            wt.commit();
+        }
+        for (int i = 0; i < 100; ++i) {
+            WriteTransaction wt{sg};
+            TableRef table = wt.get_table("class_table");
+            table->create_object_with_primary_key(i).set("value", "Value number " + std::to_string(i));
+            wt.commit();
+        }
+        while (history.compact_history_incrementally(time_budget, logger)) {
+        }
+    };
+
+    // Reference history without sealed blocks
+    ServerHistory::HistoryContents expected;
+    {
+        CompactingHistoryContext context{time_budget};
+        ServerHistory::DummyCompactionControl compaction_control;
+        ServerHistory history{context, compaction_control};
+        DBRef sg = DB::create(history, path_1);
+        populate_and_compact(sg, history);
+        CHECK_EQUAL(history.get_sealed_until_version(), 0);
+        expected = history.get_history_contents();
+    }
+    CHECK_EQUAL(expected.sync_history.size(), 101);
+
+    auto check_history = [&](const ServerHistory::HistoryContents& contents) {
+        CHECK_EQUAL(contents.sync_history.size(), expected.sync_history.size());
+        for (std::size_t i = 0; i < contents.sync_history.size(); ++i) {
+            CHECK_EQUAL(contents.sync_history[i].changeset, expected.sync_history[i].changeset);
+            CHECK_EQUAL(contents.sync_history[i].cumul_byte_size, expected.sync_history[i].cumul_byte_size);
+        }
+    };
+
+    // All full blocks of compacted history entries get sealed, and the sealed
+    // history entries read back exactly as before.
+    {
+        CompactingHistoryContext context{time_budget, history_block_size};
+        ServerHistory::DummyCompactionControl compaction_control;
+        ServerHistory history{context, compaction_control};
+        DBRef sg = DB::create(history, path_2);
+        populate_and_compact(sg, history);
+        CHECK_EQUAL(history.get_compacted_until_version(), 101);
+        CHECK_EQUAL(history.get_sealed_until_version(), 100);
+        check_history(history.get_history_contents());
+        ReadTransaction rt{sg};
+        rt.get_group().verify();
+    }
+
+    // Sealed history blocks can be read without a block size being configured
+    {
+        HistoryContext context;
+        ServerHistory::DummyCompactionControl compaction_control;
+        ServerHistory history{context, compaction_control};
+        DBRef sg = DB::create(history, path_2);
+        CHECK_EQUAL(history.get_sealed_until_version(), 100);
+        check_history(history.get_history_contents());
+        std::vector<sync::Changeset> changesets = history.get_parsed_changesets(95, 101);
+        CHECK_EQUAL(changesets.size(), 6);
+        CHECK_EQUAL(changesets.front().version, 95);
+        ReadTransaction rt{sg};
+        rt.get_group().verify();
+    }
+}
+
 } // unnamed namespace
@@ -271,6 +271,255 @@ TEST(Sync_AsyncWaitForDownloadCompletion)
 }
 
 
+TEST(Sync_SharedDownloadCache)
+{
+    TEST_DIR(dir);
+    TEST_CLIENT_DB(db_1);
+    TEST_CLIENT_DB(db_2);
+    TEST_CLIENT_DB(db_3);
+    ClientServerFixture::Config config;
+    config.max_download_cache_size = 1024 * 1024;
+    ClientServerFixture fixture(dir, test_context, std::move(config));
+    fixture.start();
+
+    Session session_1 = fixture.make_bound_session(db_1);
+    auto upload = [&](int first, int count) {
+        for (int i = first; i < first + count; ++i) {
+            write_transaction_notifying_session(db_1, session_1, [&](WriteTransaction& wt) {
+                TableRef table = wt.get_table("class_foo");
+                std::string str(100, char('a' + i % 26));
+                table->create_object_with_primary_key(i).set(table->get_column_key("str"), StringData(str));
+            });
+        }
+        session_1.wait_for_upload_complete_or_client_stopped();
+    };
+    write_transaction_notifying_session(db_1, session_1, [](WriteTransaction& wt) {
+        TableRef table = wt.get_group().add_table_with_primary_key("class_foo", type_Int, "pk");
+        table->add_column(type_String, "str");
+    });
+    upload(0, 20);
+
+    // Sessions that start from the same point in the history share the DOWNLOAD
+    // bodies, both when bootstrapping and when resuming.
+    auto download_all = [&] {
+        for (auto db : {db_2, db_3}) {
+            Session session = fixture.make_bound_session(db);
+            session.wait_for_download_complete_or_client_stopped();
+            ReadTransaction rt_1(db_1);
+            ReadTransaction rt_2(db);
+            CHECK(compare_groups(rt_1, rt_2));
+        }
+    };
+    download_all();
+    upload(20, 20);
+    download_all();
+
+    // Clients that have uploaded changes since then must not be served the
+    // shared bodies.
+    {
+        Session session_2 = fixture.make_bound_session(db_2);
+        write_transaction_notifying_session(db_2, session_2, [](WriteTransaction& wt) {
+            wt.get_table("class_foo")->create_object_with_primary_key(1000);
+        });
+        session_2.wait_for_upload_complete_or_client_stopped();
+    }
+    upload(40, 20);
+    download_all();
+    session_1.wait_for_download_complete_or_client_stopped();
+    ReadTransaction rt_1(db_1);
+    ReadTransaction rt_2(db_2);
+    CHECK(compare_groups(rt_1, rt_2));
+    CHECK_EQUAL(rt_1.get_table("class_foo")->size(), 61);
+}
+
+
+TEST(Sync_PermessageDeflateAndCoalescedWrites)
+{
+    TEST_DIR(dir);
+    TEST_CLIENT_DB(db_1);
+    TEST_CLIENT_DB(db_2);
+    TEST_CLIENT_DB(db_3);
+    TEST_CLIENT_DB(db_4);
+    TEST_CLIENT_DB(db_5);
+    TEST_CLIENT_DB(db_6);
+    ClientServerFixture::Config config;
+    config.enable_permessage_deflate = true;
+    config.max_coalesced_write_size = 16 * 1024;
+    ClientServerFixture fixture(dir, test_context, std::move(config));
+    fixture.start();
+
+    const char* paths[] = {"/a", "/b", "/c"};
+    DBRef sources[] = {db_1, db_2, db_3};
+    DBRef targets[] = {db_4, db_5, db_6};
+    for (int i = 0; i < 3; ++i) {
+        Session session = fixture.make_bound_session(sources[i], paths[i]);
+        write_transaction_notifying_session(sources[i], session, [&](WriteTransaction& wt) {
+            TableRef table = wt.get_group().add_table_with_primary_key("class_foo", type_Int, "pk");
+            ColKey col = table->add_column(type_String, "str");
+            for (int j = 0; j < 100 * (i + 1); ++j)
+                table->create_object_with_primary_key(j).set(col, StringData(std::string(200, char('a' + j % 3))));
+        });
+        session.wait_for_upload_complete_or_client_stopped();
+    }
+
+    // The sessions share a connection, so their messages can be coalesced
+    std::vector<Session> sessions;
+    for (int i = 0; i < 3; ++i)
+        sessions.push_back(fixture.make_bound_session(targets[i], paths[i]));
+    for (int i = 0; i < 3; ++i) {
+        sessions[i].wait_for_download_complete_or_client_stopped();
+        ReadTransaction rt_1(sources[i]);
+        ReadTransaction rt_2(targets[i]);
+        CHECK(compare_groups(rt_1, rt_2));
+    }
+}
+
+
+TEST(Sync_ServerFileIoThreads)
+{
+    TEST_DIR(dir);
+    TEST_CLIENT_DB(db_1);
+    TEST_CLIENT_DB(db_2);
+    TEST_CLIENT_DB(db_3);
+    TEST_CLIENT_DB(db_4);
+    ClientServerFixture::Config config;
+    config.server_max_open_files = 1;
+    config.server_num_file_io_threads = 2;
+    ClientServerFixture fixture(dir, test_context, std::move(config));
+    fixture.start();
+
+    // Only one file can be open at a time, so the files are repeatedly closed
+    // in the background, and prefetched when the sessions bind again.
+    const char* paths[] = {"/a", "/b"};
+    DBRef sources[] = {db_1, db_2};
+    DBRef targets[] = {db_3, db_4};
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 2; ++i) {
+            Session session = fixture.make_bound_session(sources[i], paths[i]);
+            write_transaction_notifying_session(sources[i], session, [&](WriteTransaction& wt) {
+                TableRef table = wt.get_table("class_foo");
+                if (!table)
+                    table = wt.get_group().add_table_with_primary_key("class_foo", type_Int, "pk");
+                table->create_object_with_primary_key(round);
+            });
+            session.wait_for_upload_complete_or_client_stopped();
+        }
+        for (int i = 0; i < 2; ++i) {
+            Session session = fixture.make_bound_session(targets[i], paths[i]);
+            session.wait_for_download_complete_or_client_stopped();
+            ReadTransaction rt_1(sources[i]);
+            ReadTransaction rt_2(targets[i]);
+            CHECK(compare_groups(rt_1, rt_2));
+        }
+    }
+}
+
+
+TEST(Sync_ServerWorkerPool)
+{
+    TEST_DIR(dir);
+    TEST_CLIENT_DB(db_1);
+    TEST_CLIENT_DB(db_2);
+    TEST_CLIENT_DB(db_3);
+    TEST_CLIENT_DB(db_4);
+    TEST_CLIENT_DB(db_5);
+    TEST_CLIENT_DB(db_6);
+    TEST_CLIENT_DB(db_7);
+    TEST_CLIENT_DB(db_8);
+    ClientServerFixture::Config config;
+    config.server_num_workers = 4;
+    ClientServerFixture fixture(dir, test_context, std::move(config));
+    fixture.start();
+
+    // Each file is assigned to its own worker, and the files are written to
+    // by two clients each
+    const char* paths[] = {"/a", "/b", "/c", "/d"};
+    DBRef dbs[] = {db_1, db_2, db_3, db_4, db_5, db_6, db_7, db_8};
+    std::vector<Session> sessions;
+    for (int i = 0; i < 8; ++i)
+        sessions.push_back(fixture.make_bound_session(dbs[i], paths[i % 4]));
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            write_transaction_notifying_session(dbs[i], sessions[i], [&](WriteTransaction& wt) {
+                TableRef table = wt.get_group().get_or_add_table_with_primary_key("class_foo", type_Int, "pk");
+                table->create_object_with_primary_key(round * 8 + i);
+            });
+        }
+    }
+    for (Session& session : sessions)
+        session.wait_for_upload_complete_or_client_stopped();
+    for (Session& session : sessions)
+        session.wait_for_download_complete_or_client_stopped();
+    for (int i = 0; i < 4; ++i) {
+        ReadTransaction rt_1(dbs[i]);
+        ReadTransaction rt_2(dbs[i + 4]);
+        CHECK(compare_groups(rt_1, rt_2));
+        CHECK_EQUAL(rt_1.get_table("class_foo")->size(), 10);
+    }
+
+    std::vector<Server::WorkerQueueMetrics> metrics = fixture.get_server().get_worker_queue_metrics();
+    CHECK_EQUAL(metrics.size(), 4);
+    for (const Server::WorkerQueueMetrics& worker_metrics : metrics) {
+        CHECK_GREATER(worker_metrics.num_work_units, 0);
+        CHECK_GREATER_EQUAL(worker_metrics.max_queue_depth, 1);
+    }
+}
+
+
+TEST(Sync_ServerIncrementalHistoryCompaction)
+{
+    TEST_DIR(dir);
+    TEST_CLIENT_DB(db_1);
+    TEST_CLIENT_DB(db_2);
+    ClientServerFixture::Config config;
+    config.history_compaction_interval = std::chrono::seconds{0};
+    config.history_compaction_time_budget = std::chrono::milliseconds{1};
+    ClientServerFixture fixture(dir, test_context, std::move(config));
+    fixture.start();
+
+    Session session_1 = fixture.make_bound_session(db_1);
+    Session session_2 = fixture.make_bound_session(db_2);
+    write_transaction_notifying_session(db_1, session_1, [](WriteTransaction& wt) {
+        TableRef table = wt.get_group().add_table_with_primary_key("class_foo", type_Int, "pk");
+        table->add_column(type_Int, "value");
+        table->create_object_with_primary_key(1);
+    });
+    session_1.wait_for_upload_complete_or_client_stopped();
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 10; ++i) {
+            DBRef db = (i % 2 == 0 ? db_1 : db_2);
+            Session& session = (i % 2 == 0 ? session_1 : session_2);
+            session.wait_for_download_complete_or_client_stopped();
+            write_transaction_notifying_session(db, session, [&](WriteTransaction& wt) {
+                TableRef table = wt.get_table("class_foo");
+                table->get_object_with_primary_key(1).set("value", round * 10 + i);
+            });
+        }
+        session_1.wait_for_upload_complete_or_client_stopped();
+        session_2.wait_for_upload_complete_or_client_stopped();
+    }
+    session_1.wait_for_download_complete_or_client_stopped();
+    session_2.wait_for_download_complete_or_client_stopped();
+    {
+        ReadTransaction rt_1(db_1);
+        ReadTransaction rt_2(db_2);
+        CHECK(compare_groups(rt_1, rt_2));
+        CHECK_EQUAL(rt_1.get_table("class_foo")->get_object_with_primary_key(1).get<Int>("value"), 99);
+    }
+
+    // A client that bootstraps from the compacted history ends up in the
+    // same state
+    TEST_CLIENT_DB(db_3);
+    Session session_3 = fixture.make_bound_session(db_3);
+    session_3.wait_for_download_complete_or_client_stopped();
+    {
+        ReadTransaction rt_1(db_1);
+        ReadTransaction rt_3(db_3);
+        CHECK(compare_groups(rt_1, rt_3));
+    }
+}
+
+
 TEST(Sync_AsyncWaitForSyncCompletion)
 {
     TEST_DIR(dir);
@@ -1787,6 +2036,21 @@ TEST(Sync_ErrorAfterServerRestore_BadClientFileIdent)
 }
 
 
+TEST(Sync_ServerRejectsZeroWorkers)
+{
+    TEST_DIR(server_dir);
+
+    Server::Config server_config;
+    server_config.logger = &test_context.logger;
+    server_config.listen_address = "localhost";
+    server_config.listen_port = "";
+    server_config.num_workers = 0;
+
+    util::Optional<PKey> public_key = PKey::load_public(g_test_server_key_path);
+    CHECK_THROW(Server(server_dir, std::move(public_key), server_config), std::runtime_error);
+}
+
+
 TEST(Sync_HTTP404NotFound)
 {
     TEST_DIR(server_dir);
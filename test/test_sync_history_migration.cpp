@@ -68,7 +68,7 @@ TEST(Sync_HistoryMigration)
     // `resources/history_migration/`. See the `produce_new_files` above for an
     // easy way to generate new files.
     std::vector<int> client_schema_versions = {11, 12};
-    std::vector<int> server_schema_versions = {20};
+    std::vector<int> server_schema_versions = {20, 21};
 
     // Before bootstrapping, there can be no client or server files. After
     // bootstrapping, there must be at least one client, and one server file.
@@ -24,6 +24,7 @@
 #include <limits>
 #include <string>
 #include <fstream>
+#include <map>
 #include <ostream>
 #include <set>
 #include <chrono>
@@ -5363,6 +5364,121 @@ TEST(Table_IteratorRandomAccess)
     CHECK_EQUAL(keys[200], iter200->get_key());
 }
 
+TEST(Table_IteratorCachedLeaves)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    DBRef db = DB::create(make_in_realm_history(), path);
+
+    const int num_rows = 2000;
+    ColKey col_int, col_int_null, col_bool, col_float, col_dbl, col_str, col_enum, col_ts, col_oid, col_uuid,
+        col_mixed, col_link;
+    {
+        auto wt = db->start_write();
+        auto target = wt->add_table("target");
+        auto table = wt->add_table("table");
+        col_int = table->add_column(type_Int, "int");
+        col_int_null = table->add_column(type_Int, "int_null", true);
+        col_bool = table->add_column(type_Bool, "bool");
+        col_float = table->add_column(type_Float, "float", true);
+        col_dbl = table->add_column(type_Double, "double");
+        col_str = table->add_column(type_String, "str", true);
+        col_enum = table->add_column(type_String, "enum");
+        col_ts = table->add_column(type_Timestamp, "ts");
+        col_oid = table->add_column(type_ObjectId, "oid", true);
+        col_uuid = table->add_column(type_UUID, "uuid");
+        col_mixed = table->add_column(type_Mixed, "mixed");
+        col_link = table->add_column(*target, "link");
+        std::vector<ObjKey> target_keys;
+        target->create_objects(5, target_keys);
+        for (int i = 0; i < num_rows; ++i) {
+            Obj obj = table->create_object();
+            obj.set(col_int, i);
+            if (i % 3)
+                obj.set(col_int_null, i * 2);
+            obj.set(col_bool, i % 2 == 0);
+            if (i % 4)
+                obj.set(col_float, float(i));
+            obj.set(col_dbl, i / 2.);
+            if (i % 5)
+                obj.set(col_str, "str " + util::to_string(i));
+            obj.set(col_enum, i % 2 ? "odd" : "even");
+            obj.set(col_ts, Timestamp(i, 0));
+            if (i % 6)
+                obj.set(col_oid, ObjectId::gen());
+            obj.set(col_uuid, UUID());
+            obj.set_any(col_mixed, i % 2 ? Mixed(i) : Mixed("mixed"));
+            obj.set(col_link, target_keys[i % 5]);
+        }
+        table->enumerate_string_column(col_enum);
+        target->invalidate_object(target_keys[2]);
+        wt->commit();
+    }
+
+    std::vector<ColKey> cols = {col_int,  col_int_null, col_bool, col_float, col_dbl,   col_str,
+                                col_enum, col_ts,       col_oid,  col_uuid,  col_mixed, col_link};
+    auto check_all = [&](ConstTableRef table) {
+        int i = 0;
+        for (auto it = table->begin(); it != table->end(); ++it, ++i) {
+            for (auto col : cols)
+                CHECK_EQUAL(it.get_any(col), it->get_any(col));
+            CHECK_EQUAL(it.get<Int>(col_int), i);
+            CHECK_EQUAL(it.get<util::Optional<Int>>(col_int_null), it->get<util::Optional<Int>>(col_int_null));
+            CHECK_EQUAL(it.get<Bool>(col_bool), i % 2 == 0);
+            CHECK_EQUAL(it.get<util::Optional<float>>(col_float), it->get<util::Optional<float>>(col_float));
+            CHECK_EQUAL(it.get<Double>(col_dbl), i / 2.);
+            CHECK_EQUAL(it.get<String>(col_str), it->get<String>(col_str));
+            CHECK_EQUAL(it.get<String>(col_enum), i % 2 ? "odd" : "even");
+            CHECK_EQUAL(it.get<Timestamp>(col_ts), Timestamp(i, 0));
+            CHECK_EQUAL(it.get<util::Optional<ObjectId>>(col_oid), it->get<util::Optional<ObjectId>>(col_oid));
+            CHECK_EQUAL(it.get<ObjKey>(col_link), it->get<ObjKey>(col_link));
+        }
+        CHECK_EQUAL(i, num_rows);
+    };
+
+    {
+        auto rt = db->start_read();
+        auto table = rt->get_table("table");
+        check_all(table);
+
+        // Copies do not share leaf accessors with the original
+        auto it = table->begin();
+        it += 1500;
+        auto it2 = it;
+        CHECK_EQUAL(it.get<Int>(col_int), 1500);
+        ++it2;
+        CHECK_EQUAL(it2.get<Int>(col_int), 1501);
+        CHECK_EQUAL(it.get<Int>(col_int), 1500);
+        it2.go(11);
+        CHECK_EQUAL(it2.get<Int>(col_int), 11);
+        CHECK_EQUAL(it2.get<String>(col_str), "str 11");
+    }
+
+    {
+        // Values written while iterating are read back, also when the
+        // cluster has already been modified
+        auto wt = db->start_write();
+        auto table = wt->get_table("table");
+        int i = 0;
+        for (auto it = table->begin(); it != table->end(); ++it, ++i) {
+            CHECK_EQUAL(it.get<Int>(col_int), i);
+            it->set(col_int, i + 1);
+            CHECK_EQUAL(it.get<Int>(col_int), i + 1);
+            it->set(col_str, "modified");
+            CHECK_EQUAL(it.get<String>(col_str), "modified");
+        }
+        for (auto it = table->begin(); it != table->end(); ++it) {
+            int64_t n = it.get<Int>(col_int) - 1;
+            it->set(col_int, n);
+            if (n % 5)
+                it->set(col_str, "str " + util::to_string(n));
+            else
+                it->set(col_str, StringData());
+        }
+        check_all(table);
+        wt->commit();
+    }
+}
+
 TEST(Table_EmbeddedObjects)
 {
     SHARED_GROUP_TEST_PATH(path);
@@ -5896,4 +6012,416 @@ TEST(Table_AsymmetricObjects)
     tr->commit();
 }
 
+TEST(Table_BulkInsert)
+{
+    Group g;
+    auto origin = g.add_table("origin");
+    auto target = g.add_table("target");
+    auto col_int = origin->add_column(type_Int, "int");
+    auto col_str = origin->add_column(type_String, "str", true);
+    auto col_link = origin->add_column(*target, "link");
+    auto col_mixed = origin->add_column(type_Mixed, "mixed");
+    auto col_dbl = origin->add_column(type_Double, "dbl");
+    origin->add_search_index(col_str);
+    origin->add_search_index(col_int);
+
+    std::vector<ObjKey> target_keys;
+    target->create_objects(10, target_keys);
+
+    // Spans several cluster leaves
+    const size_t num_rows = 1000;
+    std::vector<std::string> strings;
+    std::vector<Mixed> ints, strs, links, mixeds;
+    for (size_t i = 0; i < num_rows; ++i)
+        strings.push_back("str " + util::to_string(i % 100));
+    for (size_t i = 0; i < num_rows; ++i) {
+        ints.emplace_back(int64_t(i));
+        strs.push_back(i % 7 ? Mixed(strings[i]) : Mixed());
+        links.push_back(i % 3 ? Mixed(target_keys[i % 10]) : Mixed());
+        mixeds.push_back(i % 2 ? Mixed(double(i)) : Mixed(strings[i]));
+    }
+    auto keys = origin->bulk_insert({col_mixed, col_int, col_link, col_str}, {mixeds, ints, links, strs});
+    CHECK_EQUAL(keys.size(), num_rows);
+    CHECK_EQUAL(origin->size(), num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        Obj obj = origin->get_object(keys[i]);
+        CHECK_EQUAL(obj.get<Int>(col_int), int64_t(i));
+        CHECK_EQUAL(Mixed(obj.get<String>(col_str)), strs[i]);
+        CHECK_EQUAL(Mixed(obj.get<ObjKey>(col_link)), links[i]);
+        CHECK_EQUAL(obj.get_any(col_mixed), mixeds[i]);
+        CHECK_EQUAL(obj.get<Double>(col_dbl), 0.);
+    }
+    CHECK_EQUAL(target->get_object(target_keys[1]).get_backlink_count(), 67);
+    CHECK_EQUAL(origin->count_string(col_str, "str 42"), 8);
+    CHECK_EQUAL(origin->where().equal(col_str, StringData()).count(), 143);
+    CHECK_EQUAL(origin->find_first_int(col_int, 567), keys[567]);
+
+    // Later objects are appended after the existing ones
+    origin->create_object().set(col_int, 5000);
+    keys = origin->bulk_insert({col_int}, {{Mixed(6000), Mixed(6001)}});
+    CHECK_EQUAL(origin->size(), num_rows + 3);
+    CHECK_EQUAL(origin->find_first_int(col_int, 6001), keys[1]);
+    CHECK(origin->get_object(keys[1]).get<String>(col_str).is_null());
+
+    // Nothing is created if a value is rejected
+    CHECK_THROW(origin->bulk_insert({col_int}, {{Mixed(1), Mixed()}}), LogicError);
+    CHECK_THROW(origin->bulk_insert({col_int}, {{Mixed(1), Mixed("a")}}), LogicError);
+    CHECK_THROW(origin->bulk_insert({col_int, col_int}, {{Mixed(1)}, {Mixed(1)}}), LogicError);
+    CHECK_THROW(origin->bulk_insert({col_int, col_str}, {{Mixed(1)}, {}}), LogicError);
+    CHECK_THROW(origin->bulk_insert({col_link}, {{Mixed(ObjKey(4711))}}), LogicError);
+    CHECK_EQUAL(origin->size(), num_rows + 3);
+
+    g.verify();
+}
+
+TEST(Table_BulkInsertPrimaryKey)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history());
+    DBRef db = DB::create(*hist, path);
+
+    std::vector<ObjKey> keys;
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table_with_primary_key("class_Person", type_String, "name");
+        auto col_name = table->get_primary_key_column();
+        auto col_age = table->add_column(type_Int, "age");
+        table->create_object_with_primary_key("Adam").set(col_age, 30);
+
+        std::vector<std::string> names;
+        for (int i = 0; i < 500; ++i)
+            names.push_back("Person " + util::to_string(i));
+        std::vector<Mixed> pks, ages;
+        for (int i = 0; i < 500; ++i) {
+            pks.emplace_back(names[i]);
+            ages.emplace_back(i);
+        }
+        keys = table->bulk_insert({col_age, col_name}, {ages, pks});
+        CHECK_EQUAL(table->size(), 501);
+
+        // Primary keys must be given, and must be unique
+        CHECK_THROW(table->bulk_insert({col_age}, {{Mixed(1)}}), LogicError);
+        CHECK_THROW_ANY(table->bulk_insert({col_name}, {{Mixed("Eve"), Mixed("Adam")}}));
+        CHECK_THROW_ANY(table->bulk_insert({col_name}, {{Mixed("Eve"), Mixed("Eve")}}));
+        CHECK_EQUAL(table->size(), 501);
+        wt->commit();
+    }
+
+    auto rt = db->start_read();
+    auto table = rt->get_table("class_Person");
+    auto col_age = table->get_column_key("age");
+    for (int i = 0; i < 500; ++i) {
+        auto key = table->find_primary_key(Mixed("Person " + util::to_string(i)));
+        CHECK_EQUAL(key, keys[i]);
+        CHECK_EQUAL(table->get_object(key).get<Int>(col_age), i);
+    }
+    rt->verify();
+}
+
+TEST(Table_ReadColumns)
+{
+    Group g;
+    auto table = g.add_table("table");
+    auto target = g.add_table("target");
+    std::vector<ColKey> cols = {table->add_column(type_Int, "int"),
+                                table->add_column(type_Int, "int_null", true),
+                                table->add_column(type_Bool, "bool", true),
+                                table->add_column(type_Float, "float"),
+                                table->add_column(type_Double, "double", true),
+                                table->add_column(type_String, "str", true),
+                                table->add_column(type_Binary, "bin", true),
+                                table->add_column(type_Timestamp, "ts"),
+                                table->add_column(type_Decimal, "dec", true),
+                                table->add_column(type_ObjectId, "oid", true),
+                                table->add_column(type_UUID, "uuid"),
+                                table->add_column(type_Mixed, "mixed"),
+                                table->add_column(*target, "link")};
+    auto col_list = table->add_column_list(type_Int, "list");
+    table->add_search_index(cols[5]);
+
+    std::vector<ObjKey> target_keys;
+    target->create_objects(10, target_keys);
+
+    // Spans several cluster leaves
+    const size_t num_rows = 1500;
+    std::vector<ObjKey> keys;
+    for (size_t i = 0; i < num_rows; ++i) {
+        int64_t n = int64_t(i);
+        std::string str = "str " + util::to_string(i % 50);
+        Obj obj = table->create_object();
+        obj.set(cols[0], n);
+        if (i % 3)
+            obj.set(cols[1], n * 2);
+        if (i % 4)
+            obj.set(cols[2], i % 2 == 0);
+        obj.set(cols[3], float(i) / 2);
+        if (i % 5)
+            obj.set(cols[4], double(i) / 4);
+        if (i % 6)
+            obj.set(cols[5], str);
+        if (i % 7)
+            obj.set(cols[6], BinaryData(str));
+        obj.set(cols[7], Timestamp(n, 0));
+        if (i % 8)
+            obj.set(cols[8], Decimal128(n));
+        if (i % 9)
+            obj.set(cols[9], ObjectId::gen());
+        obj.set(cols[10], UUID());
+        obj.set_any(cols[11], i % 2 ? Mixed(n) : Mixed(str));
+        if (i % 10)
+            obj.set(cols[12], target_keys[i % 10]);
+        keys.push_back(obj.get_key());
+    }
+    // A link to an unresolved object reads as null
+    target->invalidate_object(target_keys[3]);
+
+    auto check_values = [&](const std::vector<ObjKey>& keys, const std::vector<std::vector<Mixed>>& values) {
+        CHECK_EQUAL(values.size(), cols.size());
+        for (size_t c = 0; c < cols.size(); ++c) {
+            CHECK_EQUAL(values[c].size(), keys.size());
+            for (size_t j = 0; j < keys.size(); ++j) {
+                Mixed expected = keys[j] ? table->get_object(keys[j]).get_any(cols[c]) : Mixed();
+                CHECK_EQUAL(values[c][j], expected);
+            }
+        }
+    };
+
+    std::vector<std::vector<Mixed>> values;
+    table->read_columns(keys, cols, values);
+    check_values(keys, values);
+    CHECK_EQUAL(values[0][1234], 1234);
+    CHECK(values[12][13].is_null());
+
+    // Keys in any order, null keys, the same key more than once
+    std::vector<ObjKey> shuffled = {keys[1000], ObjKey(), keys[3], keys[1499], keys[3], keys[0], keys[700]};
+    table->read_columns(shuffled, {cols[5], cols[0]}, values);
+    CHECK_EQUAL(values.size(), 2);
+    CHECK_EQUAL(values[1][0], 1000);
+    CHECK(values[0][1].is_null());
+    CHECK(values[1][1].is_null());
+    CHECK_EQUAL(values[0][2], "str 3");
+    CHECK_EQUAL(values[1][3], 1499);
+    CHECK_EQUAL(values[1][4], 3);
+    CHECK_EQUAL(values[1][6], 700);
+
+    table->read_columns({}, cols, values);
+    CHECK_EQUAL(values.size(), cols.size());
+    CHECK(values[0].empty());
+
+    CHECK_THROW(table->read_columns({ObjKey(4711)}, {cols[0]}, values), KeyNotFound);
+    CHECK_THROW(table->read_columns(keys, {col_list}, values), LogicError);
+
+    // Views give one value per row, and null for objects deleted since the view was synchronized
+    TableView tv = table->where().equal(cols[5], "str 7").find_all();
+    tv.sort(cols[0], false);
+    CHECK_EQUAL(tv.size(), 30);
+    tv.read_columns(cols, values);
+    std::vector<ObjKey> tv_keys;
+    for (size_t r = 0; r < tv.size(); ++r)
+        tv_keys.push_back(tv.get_key(r));
+    check_values(tv_keys, values);
+    CHECK_EQUAL(values[0][0], 1457);
+
+    table->remove_object(tv.get_key(1));
+    tv.read_columns({cols[0]}, values);
+    CHECK_EQUAL(values[0].size(), 30);
+    CHECK_EQUAL(values[0][0], 1457);
+    CHECK(values[0][1].is_null());
+    CHECK_EQUAL(values[0][2], 1357);
+}
+
+TEST(Table_AggregateViews)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history());
+    DBRef db = DB::create(*hist, path, DBOptions(crypt_key()));
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+
+    ColKey col_cat, col_price, col_weight, col_when;
+    const char* categories[] = {"apple", "banana", "cherry", "date", "elder"};
+    auto set_random_values = [&](Obj obj) {
+        auto n = random.draw_int_mod(6);
+        if (n == 5)
+            obj.set_null(col_cat);
+        else
+            obj.set(col_cat, categories[n]);
+        if (random.draw_int_mod(5) == 0)
+            obj.set_null(col_price);
+        else
+            obj.set(col_price, random.draw_int<int64_t>(-100, 100));
+        // Halves are added and subtracted exactly
+        obj.set(col_weight, random.draw_int_mod(200) / 2.0);
+        obj.set(col_when, Timestamp(random.draw_int_mod(1000), 0));
+    };
+
+    // Compare a view with the aggregates computed from scratch
+    auto check_view = [&](ConstTableRef table, size_t view_ndx, Action action, ColKey group_col, ColKey value_col) {
+        std::map<Mixed, std::vector<Mixed>> groups;
+        for (auto o : *table)
+            groups[o.get_any(group_col)].push_back(value_col ? o.get_any(value_col) : Mixed());
+        auto result = table->get_aggregate_view(view_ndx);
+        if (!CHECK_EQUAL(result.size(), groups.size()))
+            return;
+        size_t i = 0;
+        for (auto& [group, values] : groups) {
+            Mixed sum = (value_col.get_type() == col_type_Int) ? Mixed(int64_t(0)) : Mixed(0.0);
+            Mixed extreme;
+            size_t value_count = 0;
+            for (auto& value : values) {
+                if (value.is_null())
+                    continue;
+                ++value_count;
+                if (action == act_Sum || action == act_Average)
+                    sum = sum + value;
+                if (extreme.is_null() || (action == act_Min ? value < extreme : value > extreme))
+                    extreme = value;
+            }
+            Mixed expected;
+            switch (action) {
+                case act_Count:
+                    expected = int64_t(values.size());
+                    break;
+                case act_Sum:
+                    expected = sum;
+                    break;
+                case act_Average:
+                    if (value_count)
+                        expected = sum.export_to_type<double>() / value_count;
+                    break;
+                default:
+                    expected = extreme;
+                    break;
+            }
+            CHECK_EQUAL(result[i].first, group);
+            CHECK_EQUAL(result[i].second, expected);
+            ++i;
+        }
+    };
+    struct ViewDef {
+        Action action;
+        ColKey group_col;
+        ColKey value_col;
+    };
+    std::vector<ViewDef> defs;
+    auto check_views = [&](ConstTableRef table) {
+        CHECK_EQUAL(table->get_aggregate_view_count(), defs.size());
+        for (size_t i = 0; i < defs.size(); ++i)
+            check_view(table, i, defs[i].action, defs[i].group_col, defs[i].value_col);
+    };
+
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("class_Item");
+        col_cat = table->add_column(type_String, "category", true);
+        col_price = table->add_column(type_Int, "price", true);
+        col_weight = table->add_column(type_Double, "weight");
+        col_when = table->add_column(type_Timestamp, "when");
+        // Groups of an indexed column are looked up in the index when a minimum or maximum is recomputed
+        table->add_search_index(col_cat);
+        for (int i = 0; i < 300; ++i)
+            set_random_values(table->create_object());
+
+        defs = {{act_Count, col_cat, {}},      {act_Sum, col_cat, col_price}, {act_Average, col_cat, col_weight},
+                {act_Min, col_cat, col_price}, {act_Max, col_cat, col_price}, {act_Max, col_cat, col_when},
+                {act_Count, col_price, {}},    {act_Sum, col_price, col_price}, {act_Min, col_price, col_weight}};
+        for (size_t i = 0; i < defs.size(); ++i)
+            CHECK_EQUAL(table->add_aggregate_view(defs[i].group_col, defs[i].action, defs[i].value_col), i);
+        // Identical definitions share the view
+        CHECK_EQUAL(table->add_aggregate_view(col_cat, act_Sum, col_price), 1);
+        CHECK_THROW(table->add_aggregate_view(col_cat, act_Sum, col_cat), LogicError);
+        CHECK_THROW(table->add_aggregate_view(col_cat, act_Average, col_when), LogicError);
+        CHECK_THROW(table->add_aggregate_view(col_cat, act_FindAll, col_price), LogicError);
+        CHECK_THROW(table->get_aggregate_view(defs.size()), std::out_of_range);
+        check_views(table);
+
+        // Objects created later are included
+        for (int i = 0; i < 50; ++i)
+            table->create_object();
+        check_views(table);
+        wt->commit();
+    }
+
+    auto modify = [&](TableRef table) {
+        std::vector<ObjKey> keys;
+        for (auto o : *table)
+            keys.push_back(o.get_key());
+        for (int i = 0; i < 200; ++i) {
+            Obj obj = table->get_object(keys[random.draw_int_mod(keys.size())]);
+            switch (random.draw_int_mod(4)) {
+                case 0:
+                    set_random_values(obj);
+                    break;
+                case 1:
+                    if (!obj.is_null(col_price))
+                        obj.add_int(col_price, random.draw_int<int64_t>(-5, 5));
+                    break;
+                case 2:
+                    obj.set_null(col_price);
+                    break;
+                case 3:
+                    obj.set(col_cat, "fig");
+                    break;
+            }
+        }
+        for (int i = 0; i < 40; ++i) {
+            size_t ndx = random.draw_int_mod(keys.size());
+            table->remove_object(keys[ndx]);
+            keys.erase(keys.begin() + ndx);
+        }
+        std::vector<std::vector<Mixed>> values = {{"apple", "grape", Mixed()}, {7, Mixed(), -7}};
+        table->bulk_insert({col_cat, col_price}, values);
+    };
+
+    {
+        auto wt = db->start_write();
+        auto table = wt->get_table("class_Item");
+        modify(table);
+        check_views(table);
+        wt->commit();
+    }
+
+    // Views are read back from the file in read transactions
+    auto rt = db->start_read();
+    check_views(rt->get_table("class_Item"));
+
+    {
+        // Changes are rolled back with the transaction
+        auto wt = db->start_write();
+        auto table = wt->get_table("class_Item");
+        modify(table);
+        table->remove_aggregate_view(0);
+        wt->rollback();
+    }
+    rt->advance_read();
+    check_views(rt->get_table("class_Item"));
+
+    {
+        auto wt = db->start_write();
+        auto table = wt->get_table("class_Item");
+        table->clear();
+        check_views(table);
+        CHECK(table->get_aggregate_view(0).empty());
+        for (int i = 0; i < 20; ++i)
+            set_random_values(table->create_object());
+        check_views(table);
+
+        // Removing a column removes the views using it
+        table->remove_column(col_when);
+        defs.erase(defs.begin() + 5);
+        check_views(table);
+        table->remove_aggregate_view(0);
+        defs.erase(defs.begin());
+        check_views(table);
+
+        table->remove_column(col_price);
+        table->remove_aggregate_view(0);
+        CHECK_EQUAL(table->get_aggregate_view_count(), 0);
+        table->create_object();
+        wt->commit();
+    }
+    rt->advance_read();
+    CHECK_EQUAL(rt->get_table("class_Item")->get_aggregate_view_count(), 0);
+    rt->verify();
+}
+
 #endif // TEST_TABLE
@@ -862,6 +862,97 @@ TEST(TableView_MultiColSort)
     CHECK_EQUAL(tv[2].get<float>(col_float), 1.f);
 }
 
+TEST(TableView_SortWithLimit)
+{
+    Group g;
+    TableRef origin = g.add_table("origin");
+    TableRef target = g.add_table("target");
+    auto col_int = origin->add_column(type_Int, "int");
+    auto col_str = origin->add_column(type_String, "str", true);
+    auto col_link = origin->add_column(*target, "link");
+    auto col_target = target->add_column(type_Int, "value");
+
+    for (int i = 0; i < 10; ++i)
+        target->create_object().set(col_target, 10 - i);
+    for (int i = 0; i < 1000; ++i) {
+        Obj obj = origin->create_object().set(col_int, (i * 7) % 13);
+        if (i % 5)
+            obj.set(col_str, std::to_string(i % 11));
+        if (i % 3)
+            obj.set(col_link, target->get_object(i % 10).get_key());
+    }
+
+    std::vector<std::vector<std::vector<ColKey>>> sort_columns = {
+        {{col_int}}, {{col_int}, {col_str}}, {{col_link, col_target}, {col_int}}, {{col_str}, {col_link, col_target}}};
+    for (auto& columns : sort_columns) {
+        for (bool ascending : {true, false}) {
+            std::vector<bool> order(columns.size(), ascending);
+            order[0] = !ascending;
+
+            DescriptorOrdering full;
+            full.append_sort(SortDescriptor(columns, order));
+            TableView expected = origin->where().find_all(full);
+
+            for (size_t limit : {0, 1, 10, 999, 1000, 2000}) {
+                DescriptorOrdering ordering;
+                ordering.append_sort(SortDescriptor(columns, order));
+                ordering.append_limit(LimitDescriptor(limit));
+                TableView tv = origin->where().find_all(ordering);
+                CHECK_EQUAL(tv.size(), std::min(limit, expected.size()));
+                for (size_t i = 0; i < tv.size(); ++i) {
+                    CHECK_EQUAL(tv.get_key(i), expected.get_key(i));
+                }
+            }
+        }
+    }
+}
+
+TEST(TableView_ParallelSortAndDistinct)
+{
+    Group g;
+    TableRef origin = g.add_table("origin");
+    TableRef target = g.add_table("target");
+    auto col_int = origin->add_column(type_Int, "int");
+    auto col_str = origin->add_column(type_String, "str", true);
+    auto col_double = origin->add_column(type_Double, "double");
+    auto col_link = origin->add_column(*target, "link");
+    auto col_target = target->add_column(type_Int, "value");
+
+    for (int i = 0; i < 10; ++i)
+        target->create_object().set(col_target, i % 4);
+    for (int i = 0; i < 20000; ++i) {
+        Obj obj = origin->create_object().set(col_int, (i * 7) % 1301).set(col_double, (i % 17) / 4.0);
+        if (i % 5)
+            obj.set(col_str, std::to_string(i % 111));
+        if (i % 3)
+            obj.set(col_link, target->get_object(i % 10).get_key());
+    }
+
+    std::vector<DescriptorOrdering> orderings(6);
+    orderings[0].append_sort(SortDescriptor({{col_str}, {col_int}}, {false, true}));
+    orderings[1].append_distinct(DistinctDescriptor({{col_int}}));
+    orderings[2].append_distinct(DistinctDescriptor({{col_str}, {col_link, col_target}}));
+    orderings[3].append_distinct(DistinctDescriptor({{col_double}, {col_str}}));
+    orderings[4].append_sort(SortDescriptor({{col_double}}, {false}));
+    orderings[4].append_distinct(DistinctDescriptor({{col_str}}));
+    orderings[4].append_limit(LimitDescriptor(50));
+    orderings[5].append_distinct(DistinctDescriptor({{col_int}}));
+    orderings[5].append_sort(SortDescriptor({{col_link, col_target}, {col_str}}));
+    orderings[5].append_limit(LimitDescriptor(1000));
+
+    for (auto& ordering : orderings) {
+        TableView expected = origin->where().find_all(ordering);
+        set_parallel_sort_threshold(1000, 4);
+        TableView tv = origin->where().find_all(ordering);
+        set_parallel_sort_threshold(0);
+
+        CHECK_EQUAL(tv.size(), expected.size());
+        for (size_t i = 0; i < tv.size(); ++i) {
+            CHECK_EQUAL(tv.get_key(i), expected.get_key(i));
+        }
+    }
+}
+
 TEST(TableView_QueryCopy)
 {
     Table table;
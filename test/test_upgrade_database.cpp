@@ -1821,6 +1821,75 @@ TEST_IF(Upgrade_Database_20, REALM_MAX_BPNODE_SIZE == 1000)
     }
 }
 
+NONCONCURRENT_TEST(Upgrade_Database_22_23)
+{
+    SHARED_GROUP_TEST_PATH(path_1);
+    SHARED_GROUP_TEST_PATH(path_2);
+    SHARED_GROUP_TEST_PATH(path_3);
+    std::string prefix_1 = realm::BackupHandler::get_prefix_from_path(path_1);
+    std::string prefix_2 = realm::BackupHandler::get_prefix_from_path(path_2);
+    File::try_remove(prefix_1 + "v22.backup.realm");
+    File::try_remove(prefix_2 + "v22.backup.realm");
+
+    // Build realm files with format 22, with and without history
+    auto fill = [](DBRef db) {
+        auto tr = db->start_write();
+        auto table = tr->add_table("MyTable");
+        auto col = table->add_column(type_String, "text");
+        auto col_name = table->add_column(type_String, "name");
+        table->create_object().set(col, "the quick brown fox").set(col_name, "Reynard");
+        tr->commit();
+    };
+    _impl::GroupFriend::fake_target_file_format(22);
+    {
+        auto hist = make_in_realm_history();
+        fill(DB::create(*hist, path_1));
+        fill(DB::create(path_2));
+    }
+    _impl::GroupFriend::fake_target_file_format({});
+    File::copy(path_2, path_3);
+
+    // Both kinds of session upgrade the file before it can be written
+    auto check_upgraded = [&](DBRef db) {
+        auto tr = db->start_write();
+        CHECK_EQUAL(_impl::GroupFriend::get_file_format_version(*tr), 23);
+        auto table = tr->get_table("MyTable");
+        auto col = table->get_column_key("text");
+        table->add_fulltext_index(col);
+        CHECK(table->has_fulltext_index(col));
+        CHECK_EQUAL(table->where().fulltext(col, "fox").count(), 1);
+        auto col_name = table->get_column_key("name");
+        table->add_trigram_index(col_name);
+        CHECK(table->has_trigram_index(col_name));
+        CHECK_EQUAL(table->where().contains(col_name, StringData("nar")).count(), 1);
+        auto view_ndx = table->add_aggregate_view(col_name, act_Count);
+        table->create_object().set(col_name, "Reynard");
+        auto groups = table->get_aggregate_view(view_ndx);
+        CHECK_EQUAL(groups.size(), 1);
+        CHECK_EQUAL(groups[0].second, Mixed(2));
+        tr->commit();
+    };
+    {
+        auto hist = make_in_realm_history();
+        check_upgraded(DB::create(*hist, path_1));
+        check_upgraded(DB::create(path_2));
+    }
+
+    // A group opened directly from the file keeps format 22, so the features
+    // of format 23 cannot be added to it
+    {
+        Group group(path_3);
+        CHECK_EQUAL(_impl::GroupFriend::get_file_format_version(group), 22);
+        auto table = group.get_table("MyTable");
+        CHECK_THROW(table->add_fulltext_index(table->get_column_key("text")), LogicError);
+        CHECK_THROW(table->add_trigram_index(table->get_column_key("name")), LogicError);
+        CHECK_THROW(table->add_aggregate_view(table->get_column_key("name"), act_Count), LogicError);
+    }
+
+    File::try_remove(prefix_1 + "v22.backup.realm");
+    File::try_remove(prefix_2 + "v22.backup.realm");
+}
+
 TEST(Upgrade_progress)
 {
     SHARED_GROUP_TEST_PATH(temp_copy);
@@ -24,6 +24,7 @@
 #include <stdexcept>
 #include <string>
 #include <iostream>
+#include <set>
 
 #include <realm/util/assert.hpp>
 #include <memory>
@@ -501,6 +502,47 @@ size_t find_buf_size_utf16_to_utf8(const String16& s)
 
 // FIXME: For some reason, these tests do not compile under VisualStudio
 
+TEST(UTF8_TokenizeText)
+{
+    using Words = std::set<std::string>;
+    CHECK(tokenize_text(StringData()) == Words{});
+    CHECK(tokenize_text("") == Words{});
+    CHECK(tokenize_text(" ,.- ") == Words{});
+    CHECK(tokenize_text("The quick brown fox, the QUICK dog.") == Words({"brown", "dog", "fox", "quick", "the"}));
+    CHECK(tokenize_text("R2-D2 isn't 42") == Words({"42", "d2", "isn", "r2", "t"}));
+
+    // Case and diacritics are folded for Latin-1 and Latin Extended-A
+    CHECK(tokenize_text("Café CAFÉ cafe") == Words({"cafe"}));
+    CHECK(tokenize_text("Ærøskøbing Straße Łódź ŒUVRE") == Words({"aeroskobing", "lodz", "oeuvre", "strasse"}));
+    // Other letters are kept as they are, non-ASCII punctuation separates words
+    CHECK(tokenize_text("Привет\xE2\x80\x94мир 東京") == Words({"Привет", "мир", "東京"}));
+    CHECK(tokenize_text("a\xC3\x97" "b \xC2\xAB" "c\xC2\xBB") == Words({"a", "b", "c"}));
+
+    // Invalid UTF-8 separates words
+    CHECK(tokenize_text("ab\xC3" "cd\xE2\x80") == Words({"ab", "cd"}));
+    CHECK(tokenize_text(StringData("ab\0cd", 5)) == Words({"ab", "cd"}));
+
+    // Long words are truncated on a character boundary
+    std::string long_word(max_text_token_size - 1, 'a');
+    CHECK(tokenize_text(long_word + "bcd") == Words({long_word + "b"}));
+    CHECK(tokenize_text(long_word + "\xC3\x9F" + "cd") == Words({long_word}));
+}
+
+TEST(UTF8_TokenizeTrigrams)
+{
+    using Trigrams = std::set<std::string>;
+    CHECK(tokenize_trigrams(StringData()) == Trigrams{});
+    CHECK(tokenize_trigrams("ab") == Trigrams{});
+    CHECK(tokenize_trigrams("abc") == Trigrams({"abc"}));
+    CHECK(tokenize_trigrams("Banana") == Trigrams({"ana", "ban", "nan"}));
+    CHECK(tokenize_trigrams("a B-c") == Trigrams({"a b", " b-", "b-c"}));
+
+    // Only ASCII letters are folded, and trigrams may split a character
+    CHECK(tokenize_trigrams("\xC3\x89t\xC3\xA9") == Trigrams({"\xC3\x89t", "\x89t\xC3", "t\xC3\xA9"}));
+    CHECK(tokenize_trigrams(StringData("A\0BC", 4)) == Trigrams({std::string("a\0b", 3), std::string("\0bc", 3)}));
+}
+
+
 #ifndef _WIN32
 
 TEST(UTF8_TranscodeUtf16)
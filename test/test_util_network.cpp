@@ -494,6 +494,65 @@ TEST(Network_AsyncReadWriteLargeAmount)
 }
 
 
+TEST(Network_AsyncWriteGather)
+{
+    network::Service service_1;
+    network::Acceptor acceptor{service_1};
+    network::Endpoint listening_endpoint = bind_acceptor(acceptor);
+
+    // More buffers than are passed to the kernel at a time, some of them
+    // empty, and large enough to cause partial writes.
+    std::vector<std::string> pieces;
+    for (size_t i = 0; i < 40; ++i) {
+        size_t size = (i % 5 == 3 ? 0 : (i * 37199) % 262147);
+        std::string piece(size, '\0');
+        for (size_t j = 0; j < size; ++j)
+            piece[j] = char((i + j) % 128);
+        pieces.push_back(std::move(piece));
+    }
+    std::string expected;
+    std::vector<network::ConstBuffer> buffers;
+    for (const std::string& piece : pieces) {
+        expected += piece;
+        buffers.push_back({piece.data(), piece.size()});
+    }
+
+    std::string received;
+    auto reader = [&] {
+        network::Socket socket_1{service_1};
+        acceptor.accept(socket_1);
+        char buffer[8191]; // Prime
+        for (;;) {
+            std::error_code ec;
+            size_t n = socket_1.read_some(buffer, sizeof buffer, ec);
+            received.append(buffer, n);
+            if (ec == MiscExtErrors::end_of_input)
+                break;
+            CHECK_NOT(ec);
+        }
+    };
+    ThreadWrapper thread;
+    thread.start(reader);
+
+    network::Service service_2;
+    network::Socket socket_2{service_2};
+    socket_2.connect(listening_endpoint);
+    bool complete = false;
+    auto handler = [&](std::error_code ec, size_t n) {
+        CHECK_NOT(ec);
+        CHECK_EQUAL(expected.size(), n);
+        complete = true;
+    };
+    socket_2.async_write_gather(buffers.data(), buffers.size(), handler);
+    service_2.run();
+    socket_2.close();
+
+    CHECK_NOT(thread.join());
+    CHECK(complete);
+    CHECK(received == expected);
+}
+
+
 TEST(Network_SocketAndAcceptorOpen)
 {
     network::Service service_1;
@@ -379,6 +379,47 @@ TEST(Util_Network_SSL_AsyncReadWriteShutdown)
 }
 
 
+TEST(Util_Network_SSL_AsyncWriteGather)
+{
+    network::Service service;
+    network::Socket socket_1{service}, socket_2{service};
+    network::ssl::Context ssl_context_1;
+    network::ssl::Context ssl_context_2;
+    configure_server_ssl_context_for_test(ssl_context_1);
+    network::ssl::Stream ssl_stream_1{socket_1, ssl_context_1, network::ssl::Stream::server};
+    network::ssl::Stream ssl_stream_2{socket_2, ssl_context_2, network::ssl::Stream::client};
+    ssl_stream_1.set_logger(&test_context.logger);
+    ssl_stream_2.set_logger(&test_context.logger);
+    connect_ssl_streams(ssl_stream_1, ssl_stream_2);
+
+    std::string header = "header\n";
+    std::string body(100000, 'x');
+    network::ConstBuffer buffers[] = {{header.data(), header.size()}, {nullptr, 0}, {body.data(), body.size()}};
+    std::string expected = header + body;
+    std::unique_ptr<char[]> buffer(new char[expected.size()]);
+
+    bool write_completed = false;
+    auto write_handler = [&](std::error_code ec, std::size_t n) {
+        CHECK_EQUAL(std::error_code(), ec);
+        CHECK_EQUAL(expected.size(), n);
+        write_completed = true;
+    };
+    bool read_completed = false;
+    auto read_handler = [&](std::error_code ec, std::size_t n) {
+        CHECK_EQUAL(std::error_code(), ec);
+        if (CHECK_EQUAL(expected.size(), n))
+            CHECK(std::equal(buffer.get(), buffer.get() + n, expected.data()));
+        read_completed = true;
+    };
+
+    ssl_stream_1.async_write_gather(buffers, 3, std::move(write_handler));
+    ssl_stream_2.async_read(buffer.get(), expected.size(), std::move(read_handler));
+    service.run();
+    CHECK(write_completed);
+    CHECK(read_completed);
+}
+
+
 TEST(Util_Network_SSL_PrematureEndOfInputOnHandshakeRead)
 {
     network::Service service_1, service_2;
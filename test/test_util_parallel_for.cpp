@@ -0,0 +1,96 @@
+/*************************************************************************
+ *
+ * Copyright 2022 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include "testsettings.hpp"
+
+#include <realm/util/parallel_for.hpp>
+
+#include "test.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace realm;
+
+// Test independence and thread-safety
+// -----------------------------------
+//
+// All tests must be thread safe and independent of each other. This
+// is required because it allows for both shuffling of the execution
+// order and for parallelized testing.
+//
+// In particular, avoid using std::rand() since it is not guaranteed
+// to be thread safe. Instead use the API offered in
+// `test/util/random.hpp`.
+//
+// All files created in tests must use the TEST_PATH macro (or one of
+// its friends) to obtain a suitable file system path. See
+// `test/util/test_path.hpp`.
+//
+//
+// Debugging and the ONLY() macro
+// ------------------------------
+//
+// A simple way of disabling all tests except one called `Foo`, is to
+// replace TEST(Foo) with ONLY(Foo) and then recompile and rerun the
+// test suite. Note that you can also use filtering by setting the
+// environment varible `UNITTEST_FILTER`. See `README.md` for more on
+// this.
+//
+// Another way to debug a particular test, is to copy that test into
+// `experiments/testcase.cpp` and then run `sh build.sh
+// check-testcase` (or one of its friends) from the command line.
+
+
+namespace {
+
+TEST(Util_ParallelFor_VisitsEachIndexOnce)
+{
+    for (std::size_t num_threads : {0, 1, 2, 4, 16}) {
+        const std::size_t count = 1000;
+        std::vector<std::atomic<int>> visits(count);
+        util::parallel_for(count, num_threads, [&](std::size_t i) {
+            visits[i].fetch_add(1, std::memory_order_relaxed);
+        });
+        for (std::size_t i = 0; i < count; ++i)
+            CHECK_EQUAL(visits[i].load(), 1);
+    }
+
+    bool called = false;
+    util::parallel_for(0, 4, [&](std::size_t) {
+        called = true;
+    });
+    CHECK_NOT(called);
+}
+
+TEST(Util_ParallelFor_PropagatesException)
+{
+    std::atomic<std::size_t> calls{0};
+    CHECK_THROW(util::parallel_for(1000, 4,
+                                   [&](std::size_t i) {
+                                       ++calls;
+                                       if (i == 10)
+                                           throw std::runtime_error("failure");
+                                   }),
+                std::runtime_error);
+    CHECK_LESS_EQUAL(calls.load(), 1000);
+    CHECK_GREATER_EQUAL(calls.load(), 11);
+}
+
+} // unnamed namespace
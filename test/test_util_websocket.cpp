@@ -170,6 +170,14 @@ public:
     int n_protocol_errors = 0;
     int n_read_errors = 0;
     int n_write_errors = 0;
+    int n_writes = 0;
+    size_t n_bytes_written = 0;
+    bool permessage_deflate = false;
+    size_t max_inflated_message_size = 128 * 1024 * 1024;
+    std::error_code protocol_error;
+
+    // Applied to everything written by this end
+    std::function<void(std::string&)> rewrite_output;
 
     std::vector<std::string> text_messages;
     std::vector<std::string> binary_messages;
@@ -194,8 +202,29 @@ public:
         return m_random;
     }
 
+    bool websocket_permessage_deflate_enabled() noexcept override
+    {
+        return permessage_deflate;
+    }
+
+    size_t websocket_max_inflated_message_size() noexcept override
+    {
+        return max_inflated_message_size;
+    }
+
     void async_write(const char* data, size_t size, WriteCompletionHandler handler) override
     {
+        n_writes++;
+        n_bytes_written += size;
+        if (rewrite_output) {
+            std::string output{data, size};
+            rewrite_output(output);
+            auto rewritten_handler = [size, handler = std::move(handler)](std::error_code ec, size_t) mutable {
+                handler(ec, size);
+            };
+            m_pipe_out.async_write(output.data(), output.size(), std::move(rewritten_handler));
+            return;
+        }
         m_pipe_out.async_write(data, size, std::move(handler));
     }
 
@@ -229,8 +258,9 @@ public:
         n_protocol_errors++;
     }
 
-    void websocket_protocol_error_handler(std::error_code) override
+    void websocket_protocol_error_handler(std::error_code ec) override
     {
+        protocol_error = ec;
         n_protocol_errors++;
     }
 
@@ -405,6 +435,174 @@ TEST(WebSocket_Messages)
     }
 }
 
+TEST(WebSocket_MessagePieces)
+{
+    Fixture fixt{test_context.logger};
+    WSConfig& config_1 = fixt.config_1;
+    WSConfig& config_2 = fixt.config_2;
+
+    websocket::Socket& socket_1 = fixt.socket_1;
+    websocket::Socket& socket_2 = fixt.socket_2;
+
+    socket_1.initiate_client_handshake("/uri", "host", "protocol");
+    socket_2.initiate_server_handshake();
+
+    auto handler_no_op = [=]() {};
+    std::vector<size_t> body_sizes{0, 1, 100, 2000, 65000, 100000};
+    for (size_t i = 0; i < body_sizes.size(); ++i) {
+        std::string header = "header " + std::to_string(i) + "\n";
+        std::string body(body_sizes[i], char('a' + i));
+        network::ConstBuffer pieces[] = {{header.data(), header.size()}, {body.data(), body.size()}};
+        std::string expected = header + body;
+
+        // Masked by the client
+        socket_1.async_write_binary(pieces, 2, handler_no_op);
+        CHECK_EQUAL(config_2.binary_messages.size(), i + 1);
+        CHECK(config_2.binary_messages[i] == expected);
+
+        // Unmasked, and for large messages written from the pieces directly
+        socket_2.async_write_binary(pieces, 2, handler_no_op);
+        CHECK_EQUAL(config_1.binary_messages.size(), i + 1);
+        CHECK(config_1.binary_messages[i] == expected);
+    }
+    CHECK_EQUAL(config_1.n_write_errors, 0);
+    CHECK_EQUAL(config_2.n_write_errors, 0);
+}
+
+TEST(WebSocket_PermessageDeflate)
+{
+    auto handler_no_op = [=]() {};
+    std::string compressible;
+    for (int i = 0; i < 1000; ++i)
+        compressible += "message " + std::to_string(i % 10) + "\n";
+    std::string incompressible(5000, '\0');
+    std::mt19937_64 random;
+    for (char& ch : incompressible)
+        ch = char(random());
+
+    for (int enabled = 0; enabled < 4; ++enabled) {
+        Fixture fixt{test_context.logger};
+        fixt.config_1.permessage_deflate = ((enabled & 1) != 0);
+        fixt.config_2.permessage_deflate = ((enabled & 2) != 0);
+        bool negotiated = (enabled == 3);
+
+        fixt.socket_1.initiate_client_handshake("/uri", "host", "protocol");
+        fixt.socket_2.initiate_server_handshake();
+        CHECK_EQUAL(fixt.config_1.n_handshake_completed, 1);
+        CHECK_EQUAL(fixt.config_2.n_handshake_completed, 1);
+
+        std::vector<std::string> messages{"short", compressible, incompressible, std::string(100000, 'x')};
+        for (size_t i = 0; i < messages.size(); ++i) {
+            const std::string& message = messages[i];
+            size_t written_1 = fixt.config_1.n_bytes_written;
+            size_t written_2 = fixt.config_2.n_bytes_written;
+            fixt.socket_1.async_write_binary(message.data(), message.size(), handler_no_op);
+            fixt.socket_2.async_write_text(message.data(), message.size(), handler_no_op);
+            CHECK_EQUAL(fixt.config_2.binary_messages.size(), i + 1);
+            CHECK_EQUAL(fixt.config_1.text_messages.size(), i + 1);
+            CHECK(fixt.config_2.binary_messages[i] == message);
+            CHECK(fixt.config_1.text_messages[i] == message);
+            bool compressed = (negotiated && message.size() > 1000 && message != incompressible);
+            CHECK_EQUAL(fixt.config_1.n_bytes_written - written_1 < message.size(), compressed);
+            CHECK_EQUAL(fixt.config_2.n_bytes_written - written_2 < message.size(), compressed);
+        }
+
+        // Control frames are never compressed
+        fixt.socket_1.async_write_ping(compressible.data(), 125, handler_no_op);
+        CHECK_EQUAL(fixt.config_2.ping_messages.size(), 1);
+        CHECK(fixt.config_2.ping_messages[0] == compressible.substr(0, 125));
+
+        CHECK_EQUAL(fixt.config_1.n_protocol_errors, 0);
+        CHECK_EQUAL(fixt.config_2.n_protocol_errors, 0);
+    }
+}
+
+TEST(WebSocket_PermessageDeflate_MaxInflatedSize)
+{
+    auto handler_no_op = [=]() {};
+    std::string message(10000, 'x');
+    for (size_t max_size : {message.size(), message.size() - 1}) {
+        Fixture fixt{test_context.logger};
+        fixt.config_1.permessage_deflate = true;
+        fixt.config_2.permessage_deflate = true;
+        fixt.config_2.max_inflated_message_size = max_size;
+        fixt.socket_1.initiate_client_handshake("/uri", "host", "protocol");
+        fixt.socket_2.initiate_server_handshake();
+
+        fixt.socket_1.async_write_binary(message.data(), message.size(), handler_no_op);
+        if (max_size >= message.size()) {
+            CHECK_EQUAL(fixt.config_2.n_protocol_errors, 0);
+            CHECK_EQUAL(fixt.config_2.binary_messages.size(), 1);
+        }
+        else {
+            CHECK_EQUAL(fixt.config_2.n_protocol_errors, 1);
+            CHECK(fixt.config_2.protocol_error == websocket::Error::message_too_big);
+            CHECK_EQUAL(fixt.config_2.binary_messages.size(), 0);
+        }
+    }
+}
+
+TEST(WebSocket_PermessageDeflate_Negotiation)
+{
+    HTTPRequest request;
+    HTTPResponse response;
+    CHECK_NOT(websocket::accept_permessage_deflate(request, response));
+
+    request.headers["Sec-WebSocket-Extensions"] =
+        "x-webkit-deflate-frame, permessage-deflate; server_max_window_bits=10";
+    CHECK_NOT(websocket::accept_permessage_deflate(request, response));
+    CHECK(response.headers.find("Sec-WebSocket-Extensions") == response.headers.end());
+
+    request.headers["Sec-WebSocket-Extensions"] =
+        "permessage-deflate; server_max_window_bits=10, permessage-deflate; client_max_window_bits";
+    CHECK(websocket::accept_permessage_deflate(request, response));
+    CHECK(response.headers.find("Sec-WebSocket-Extensions") != response.headers.end());
+}
+
+TEST(WebSocket_PermessageDeflate_ServerContextTakeover)
+{
+    // The client inflates every message on its own, so it must reject a
+    // server that does not agree to compress without context takeover.
+    Fixture fixt{test_context.logger};
+    fixt.config_1.permessage_deflate = true;
+    fixt.config_2.permessage_deflate = true;
+    fixt.config_2.rewrite_output = [](std::string& output) {
+        std::string param = "; server_no_context_takeover";
+        size_t pos = output.find(param);
+        if (pos != std::string::npos)
+            output.erase(pos, param.size());
+    };
+    fixt.socket_1.initiate_client_handshake("/uri", "host", "protocol");
+    fixt.socket_2.initiate_server_handshake();
+    CHECK_EQUAL(fixt.config_1.n_handshake_completed, 0);
+    CHECK_EQUAL(fixt.config_1.n_protocol_errors, 1);
+}
+
+TEST(WebSocket_BinaryMessageBatch)
+{
+    Fixture fixt{test_context.logger};
+    fixt.config_1.permessage_deflate = true;
+    fixt.config_2.permessage_deflate = true;
+    fixt.socket_1.initiate_client_handshake("/uri", "host", "protocol");
+    fixt.socket_2.initiate_server_handshake();
+
+    auto handler_no_op = [=]() {};
+    std::vector<std::string> messages{"", "a", std::string(300, 'b'), std::string(70000, 'c'), "d"};
+    std::vector<network::ConstBuffer> buffers;
+    for (const std::string& message : messages)
+        buffers.push_back({message.data(), message.size()});
+
+    int writes_1 = fixt.config_1.n_writes;
+    fixt.socket_1.async_write_binary_messages(buffers.data(), buffers.size(), handler_no_op);
+    CHECK_EQUAL(fixt.config_1.n_writes, writes_1 + 1);
+    CHECK(fixt.config_2.binary_messages == messages);
+
+    int writes_2 = fixt.config_2.n_writes;
+    fixt.socket_2.async_write_binary_messages(buffers.data(), buffers.size(), handler_no_op);
+    CHECK_EQUAL(fixt.config_2.n_writes, writes_2 + 1);
+    CHECK(fixt.config_1.binary_messages == messages);
+}
+
 TEST(WebSocket_Fragmented_Messages)
 {
     Fixture fixt{test_context.logger};